@@ -0,0 +1,129 @@
+// HTTPXX - case-insensitive comparison benchmark: strcasecmp() vs ASCII case-folding routines.
+//
+// Usage: bench_ignore_case [<rounds>]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <strings.h>
+#include <httpxx/common.h>
+#include <httpxx/char_utils.h>
+#include <httpxx/headers.h>
+
+using namespace httpxx;
+
+namespace {
+
+// Comparator, which CaseInsensitiveComparator used to be
+struct StrcasecmpComparator
+{
+	bool operator()(const std::string &lhs, const std::string &rhs) const
+	{
+		return strcasecmp(lhs.c_str(), rhs.c_str()) < 0;
+	}
+};
+
+const char * Names[] = {
+	"Host", "host", "User-Agent", "user-agent", "Accept", "ACCEPT", "Accept-Language", "accept-language",
+	"Accept-Encoding", "accept-encoding", "Accept-Charset", "accept-charset", "Keep-Alive", "keep-alive",
+	"Connection", "connection", "Cookie", "cookie", "X-Forwarded-For", "x-forwarded-for",
+	"Access-Control-Allow-Origin", "access-control-allow-origin", "X-Custom-Application-Header",
+	"x-custom-application-header"
+};
+const size_t NamesAmount = sizeof(Names) / sizeof(Names[0]);
+
+void report(const char * routine, size_t operations, std::clock_t ticks)
+{
+	double seconds = static_cast<double>(ticks) / CLOCKS_PER_SEC;
+	std::cout << std::setw(28) << std::left << routine << std::right << std::setw(10) << std::fixed <<
+		std::setprecision(2) << (operations > 0U ? seconds * 1e9 / operations : 0.0) << " ns/op" << std::endl;
+}
+
+template <class Comparator>
+void benchComparator(const char * routine, const std::vector<std::string>& names, size_t rounds)
+{
+	Comparator comparator;
+	size_t less = 0U;
+	std::clock_t started = std::clock();
+	for (size_t r = 0U; r < rounds; ++r) {
+		for (size_t i = 0U; i < names.size(); ++i) {
+			for (size_t j = 0U; j < names.size(); ++j) {
+				less += comparator(names[i], names[j]) ? 1U : 0U;
+			}
+		}
+	}
+	report(routine, rounds * names.size() * names.size(), std::clock() - started);
+	// Result is used to keep the loop
+	if (less == 0U) {
+		std::cout << "" << std::flush;
+	}
+}
+
+void benchEquality(const std::vector<std::string>& names, size_t rounds)
+{
+	size_t equal = 0U;
+	std::clock_t started = std::clock();
+	for (size_t r = 0U; r < rounds; ++r) {
+		for (size_t i = 0U; i < names.size(); ++i) {
+			for (size_t j = 0U; j < names.size(); ++j) {
+				equal += (names[i].size() == names[j].size() &&
+						equalsIgnoreCase(names[i].data(), names[j].data(), names[i].size())) ? 1U : 0U;
+			}
+		}
+	}
+	report("equalsIgnoreCase", rounds * names.size() * names.size(), std::clock() - started);
+	if (equal == 0U) {
+		std::cout << "" << std::flush;
+	}
+}
+
+void benchHash(const std::vector<std::string>& names, size_t rounds)
+{
+	size_t h = 0U;
+	std::clock_t started = std::clock();
+	for (size_t r = 0U; r < rounds; ++r) {
+		for (size_t i = 0U; i < names.size(); ++i) {
+			h ^= hashIgnoreCase(names[i].data(), names[i].size());
+		}
+	}
+	report("hashIgnoreCase", rounds * names.size(), std::clock() - started);
+	if (h == 0U) {
+		std::cout << "" << std::flush;
+	}
+}
+
+void benchHeadersLookup(const std::vector<std::string>& names, size_t rounds)
+{
+	Headers headers;
+	headers.add("X-Custom-Application-Header", "1");
+	headers.add("X-Another-Application-Header", "2");
+	headers.add("Host", "localhost");
+	size_t found = 0U;
+	std::clock_t started = std::clock();
+	for (size_t r = 0U; r < rounds; ++r) {
+		for (size_t i = 0U; i < names.size(); ++i) {
+			found += headers.have(names[i]) ? 1U : 0U;
+		}
+	}
+	report("Headers::have(name)", rounds * names.size(), std::clock() - started);
+	if (found == 0U) {
+		std::cout << "" << std::flush;
+	}
+}
+
+} // anonymous namespace
+
+int main(int argc, char * argv[])
+{
+	size_t rounds = (argc > 1) ? std::strtoul(argv[1], 0, 10) : 100000U;
+	std::vector<std::string> names(Names, Names + NamesAmount);
+	benchComparator<StrcasecmpComparator>("strcasecmp comparator", names, rounds);
+	benchComparator<CaseInsensitiveComparator>("CaseInsensitiveComparator", names, rounds);
+	benchEquality(names, rounds);
+	benchHash(names, rounds * 10U);
+	benchHeadersLookup(names, rounds * 10U);
+	return 0;
+}
@@ -0,0 +1,125 @@
+// HTTPXX - HTTP-message parser throughput benchmark.
+//
+// Usage: bench_message_parser [<megabytes to parse per workload>]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+#include <httpxx/basic_message_parser.h>
+
+using namespace httpxx;
+
+namespace {
+
+const size_t BufferSize = 1024U * 1024U;
+
+// Counts messages only, so the state machine itself is measured
+class MessageCounter : public BasicMessageParser<MessageCounter>
+{
+public:
+	MessageCounter() :
+		BasicMessageParser<MessageCounter>(16U, 1024U, 64U),
+		messages(0U)
+	{}
+
+	void onMessageComplete()
+	{
+		++messages;
+	}
+
+	size_t messages;
+};
+
+const char * Request =
+	"GET /wp-content/uploads/2010/03/hello-kitty-darth-vader-pink.jpg HTTP/1.1\r\n"
+	"Host: www.kittyhell.com\r\n"
+	"User-Agent: Mozilla/5.0 (Macintosh; U; Intel Mac OS X 10.6; ja-JP-mac; rv:1.9.2.3) "
+		"Gecko/20100401 Firefox/3.6.3 Pathtraq/0.9\r\n"
+	"Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+	"Accept-Language: ja,en-us;q=0.7,en;q=0.3\r\n"
+	"Accept-Encoding: gzip,deflate\r\n"
+	"Accept-Charset: Shift_JIS,utf-8;q=0.7,*;q=0.7\r\n"
+	"Keep-Alive: 115\r\n"
+	"Connection: keep-alive\r\n"
+	"Cookie: wp_ozh_wsa_visits=2; wp_ozh_wsa_visit_lasttime=xxxxxxxxxx; "
+		"__utma=xxxxxxxxx.xxxxxxxxxx.xxxxxxxxxx.xxxxxxxxxx.xxxxxxxxxx.x; "
+		"__utmz=xxxxxxxxx.xxxxxxxxxx.x.x.utmccn=(referral)|utmcsr=reader.livedoor.com|utmcct=/reader/|utmcmd=referral\r\n"
+	"\r\n";
+
+const char * ChunkedResponse =
+	"HTTP/1.1 200 OK\r\n"
+	"Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+	"Content-Type: text/plain\r\n"
+	"Transfer-Encoding: chunked\r\n"
+	"\r\n"
+	"1a;name=value\r\n"
+	"abcdefghijklmnopqrstuvwxyz\r\n"
+	"10\r\n"
+	"0123456789abcdef\r\n"
+	"0\r\n"
+	"X-Checksum: 1234567890\r\n"
+	"\r\n";
+
+// Fills the buffer with the complete messages
+std::string makeBuffer(const char * message)
+{
+	std::string buffer;
+	while (buffer.size() < BufferSize) {
+		buffer += message;
+	}
+	return buffer;
+}
+
+void report(const char * workload, const char * mode, size_t bytesParsed, std::clock_t ticks)
+{
+	double seconds = static_cast<double>(ticks) / CLOCKS_PER_SEC;
+	std::cout << std::setw(18) << std::left << workload << std::setw(8) << mode << std::right <<
+		std::setw(10) << std::fixed << std::setprecision(1) <<
+		(seconds > 0.0 ? bytesParsed / seconds / (1024.0 * 1024.0) : 0.0) << " MB/s" << std::endl;
+}
+
+void benchBuffer(const char * workload, const std::string& buffer, size_t rounds)
+{
+	MessageCounter parser;
+	std::clock_t started = std::clock();
+	for (size_t i = 0U; i < rounds; ++i) {
+		size_t bytesParsed = 0U;
+		while (bytesParsed < buffer.size()) {
+			bytesParsed += parser.parse(buffer.data() + bytesParsed, buffer.size() - bytesParsed).second;
+		}
+	}
+	report(workload, "buffer", buffer.size() * rounds, std::clock() - started);
+}
+
+void benchChars(const char * workload, const std::string& buffer, size_t rounds)
+{
+	MessageCounter parser;
+	std::clock_t started = std::clock();
+	for (size_t i = 0U; i < rounds; ++i) {
+		for (size_t j = 0U; j < buffer.size(); ++j) {
+			parser.parse(buffer[j]);
+		}
+	}
+	report(workload, "chars", buffer.size() * rounds, std::clock() - started);
+}
+
+} // anonymous namespace
+
+int main(int argc, char * argv[])
+{
+	size_t rounds = (argc > 1) ? std::strtoul(argv[1], 0, 10) : 256U;
+#if defined(HTTPXX_NO_COMPUTED_GOTO)
+	std::cout << "State dispatch: switch" << std::endl;
+#else
+	std::cout << "State dispatch: computed goto (if supported by compiler)" << std::endl;
+#endif
+	std::string requests = makeBuffer(Request);
+	std::string responses = makeBuffer(ChunkedResponse);
+	benchBuffer("request", requests, rounds);
+	benchChars("request", requests, rounds);
+	benchBuffer("chunked response", responses, rounds);
+	benchChars("chunked response", responses, rounds);
+	return 0;
+}
@@ -15,7 +15,6 @@ using namespace asio;
 using namespace httpxx;
 
 const std::size_t BufferSize = 4096U;
-const std::size_t EnvelopePartSize = 1024U;
 
 io_service service;
 ip::tcp::acceptor acceptor(service, ip::tcp::endpoint(ip::tcp::v4(), 9999));
@@ -71,18 +70,20 @@ private:
 		// Composing and sending response
 		std::ostringstream body;
 		list_directory(Uri(_request_parser.secondToken()).path(), body);
-		if (body.str().size() > sizeof(_buffer) - EnvelopePartSize) {
-			std::cerr << "No enough space for HTTP-response body in I/O-buffer" << std::endl;
-			return;
-		}
-		body.str().copy(_buffer + EnvelopePartSize, body.str().size());
 		Headers headers;
 		headers.add("Content-Type", "text/html");
 		headers.add("Connection", "close");
 		MessageComposer responseComposer(_request_parser.thirdToken(), "200", "OK");
+		// Envelope part of the buffer is sized exactly, so the envelope starts at the buffer
+		std::size_t envelopePartSize = responseComposer.envelopeSize(headers, body.str().size());
+		if (envelopePartSize > sizeof(_buffer) || body.str().size() > sizeof(_buffer) - envelopePartSize) {
+			std::cerr << "No enough space for HTTP-response in I/O-buffer" << std::endl;
+			return;
+		}
+		body.str().copy(_buffer + envelopePartSize, body.str().size());
 		try {
 			_packet = responseComposer.prependEnvelope(_buffer,
-					EnvelopePartSize, headers, body.str().size());
+					envelopePartSize, headers, body.str().size());
 		} catch (std::exception& e) {
 			std::cerr << "HTTP-response composition error: " << e.what() << std::endl;
 			return;
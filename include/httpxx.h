@@ -4,8 +4,20 @@
 #include <httpxx/params.h>
 #include <httpxx/uri.h>
 #include <httpxx/headers.h>
+#include <httpxx/basic_message_parser.h>
 #include <httpxx/message_parser.h>
+#include <httpxx/message_batch_parser.h>
+#include <httpxx/request_parser.h>
+#include <httpxx/response_parser.h>
+#include <httpxx/arena.h>
+#include <httpxx/scatter_packet.h>
+#include <httpxx/file_packet.h>
+#include <httpxx/http_date.h>
 #include <httpxx/message_composer.h>
+#include <httpxx/response_template.h>
+#include <httpxx/message_batch_composer.h>
+#include <httpxx/chunked_streambuf.h>
+#include <httpxx/memory_streambuf.h>
 
 //! httpxx namespace all API belongs to
 namespace httpxx
@@ -43,6 +55,16 @@ namespace httpxx
   - Custom HTTP-method/HTTP-version/URI-type/HTTP-status support;
   - Following HTML entities parsing/composition support:
     - HTTP-message - see MessageParser and MessageComposer;
+    - Event-driven HTTP-message parsing with no allocations - see BasicMessageParser;
+    - Pipelined HTTP-messages batch parsing - see MessageBatchParser;
+    - HTTP-request/HTTP-response with typed method, version and status - see RequestParser and ResponseParser;
+    - Scatter-gather HTTP-message composition for writev() - see ScatterPacket;
+    - Zero-copy file payload transmission by sendfile() - see FilePacket;
+    - Precompiled HTTP-response envelopes - see ResponseTemplate;
+    - Pipelined HTTP-messages batch composition - see MessageBatchComposer;
+    - Chunked-encoded HTTP-message output stream - see ChunkedOStream;
+    - Memory-buffer output stream with no heap allocations - see MemoryOStream;
+    - HTTP-date formatting/parsing with cached current date - see currentHttpDate();
     - URI - see Uri;
     - GET/POST parameters - see Params;
     - Cookies (TODO);
@@ -62,9 +84,8 @@ namespace httpxx
 
   \section todo_section TODO
 
-  - Memory-buffer stream implementation;
   - Cookies parser/composer;
-  - HTTP-request/HTTP-response parsers/composers;
+  - HTTP-request/HTTP-response composers;
   - Headers-only library.
   
  */
@@ -0,0 +1,218 @@
+#ifndef HTTPXX_ARENA_H
+#define HTTPXX_ARENA_H
+
+#include <cstddef>
+#include <new>
+
+namespace httpxx
+{
+
+//! Bump allocator, which releases all the allocated memory at once
+/*!
+ * Memory is taken from the blocks of the arena sequentially, deallocation
+ * of the separate allocations does nothing. reset() releases all the allocations,
+ * but keeps the blocks to be reused, so an arena, which is reset between the
+ * HTTP-messages, does not touch the heap after the first few ones.
+ *
+ * \note Arena is not thread-safe.
+ */
+class Arena
+{
+public:
+	//! Class constants
+	enum Constants {
+		DefaultBlockSize = 4096,		//!< Default size of the arena block
+		MaxAlignment = 16			//!< Maximum alignment of the allocation
+	};
+
+	//! Constructs an empty arena
+	/*!
+	 * \param blockSize Size of the block to allocate, larger blocks are allocated for larger requests
+	 */
+	explicit Arena(size_t blockSize = DefaultBlockSize);
+	~Arena();
+
+	//! Allocates memory
+	/*!
+	 * \param len Amount of bytes to allocate
+	 * \param alignment Alignment of the allocation (power of 2, not greater than MaxAlignment)
+	 * \return Pointer to the allocated memory, which is valid until the arena is reset
+	 */
+	void * allocate(size_t len, size_t alignment = MaxAlignment);
+	//! Reserves contiguous memory at the top of the arena without allocating it
+	/*!
+	 * Use commit() to allocate the reserved memory or it's part, which lets to grow
+	 * the last allocation in place.
+	 * \param len Amount of bytes to reserve
+	 * \return New top of the arena
+	 */
+	char * reserve(size_t len);
+	//! Makes room for the allocation, which is assembled at the top of the arena, to grow
+	/*!
+	 * Allocation is grown in place while it ends at the top of the arena and the
+	 * current block has room for it, otherwise it is copied to the top (into the
+	 * new block if needed). Room of the new block is doubled on each move, so an
+	 * allocation, which grows by small parts, is copied a logarithmic amount of
+	 * times and no room is reserved up front for it's maximum size.
+	 * \param data Pointer to the allocation (it is not required to be in the arena)
+	 * \param size Current size of the allocation
+	 * \param len Amount of bytes to grow the allocation by (commit() them after writing)
+	 * \return Pointer to the allocation, which ends at the top of the arena
+	 */
+	char * grow(const char * data, size_t size, size_t len);
+	//! Allocates memory at the top of the arena (len should not exceed available())
+	inline void commit(size_t len)
+	{
+		_top += len;
+	}
+	//! Returns the top of the arena, where the next allocation starts
+	inline char * top() const
+	{
+		return _top;
+	}
+	//! Returns amount of bytes, which could be committed at the top of the arena
+	inline size_t available() const
+	{
+		return static_cast<size_t>(_end - _top);
+	}
+	//! Returns total size of the blocks, which are held by the arena (including the free ones)
+	size_t capacity() const;
+	//! Releases all the allocations keeping the blocks to be reused
+	void reset();
+	//! Releases all the allocations and frees the blocks
+	void clear();
+private:
+	struct Block
+	{
+		Block * next;
+		size_t size;
+	};
+
+	Arena(const Arena&);
+	Arena& operator=(const Arena&);
+
+	static inline char * blockData(Block * block)
+	{
+		return reinterpret_cast<char *>(block) + HeaderSize;
+	}
+	static void freeBlocks(Block * block);
+
+	enum PrivateConstants {
+		HeaderSize = (sizeof(Block) + MaxAlignment - 1) & ~(MaxAlignment - 1)
+	};
+
+	size_t _blockSize;
+	Block * _blocks;
+	Block * _freeBlocks;
+	char * _top;
+	char * _end;
+};
+
+//! STL allocator, which takes memory from an arena
+/*!
+ * Allocator without an arena uses the heap, so the containers of the same type
+ * could be used with or without an arena.
+ */
+template <class T>
+class ArenaAllocator
+{
+public:
+	typedef T value_type;
+	typedef T * pointer;
+	typedef const T * const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef size_t size_type;
+	typedef ptrdiff_t difference_type;
+	//! Allocator of the other type
+	template <class U>
+	struct rebind
+	{
+		typedef ArenaAllocator<U> other;
+	};
+
+	//! Constructs allocator, which uses the heap
+	ArenaAllocator() :
+		_arena(0)
+	{}
+	//! Constructs allocator, which uses the arena
+	ArenaAllocator(Arena& arena) :
+		_arena(&arena)
+	{}
+	//! Constructs a copy of the allocator of the other type
+	template <class U>
+	ArenaAllocator(const ArenaAllocator<U>& other) :
+		_arena(other.arena())
+	{}
+
+	//! Returns the arena or 0 if the heap is used
+	inline Arena * arena() const
+	{
+		return _arena;
+	}
+	inline pointer address(reference x) const
+	{
+		return &x;
+	}
+	inline const_pointer address(const_reference x) const
+	{
+		return &x;
+	}
+	pointer allocate(size_type n, const void * /* hint */ = 0)
+	{
+		if (n > max_size()) {
+			throw std::bad_alloc();
+		}
+		if (_arena == 0) {
+			return static_cast<pointer>(::operator new(n * sizeof(T)));
+		}
+		return static_cast<pointer>(_arena->allocate(n * sizeof(T), alignment()));
+	}
+	inline void deallocate(pointer p, size_type /* n */)
+	{
+		// Arena memory is released by the arena itself
+		if (_arena == 0) {
+			::operator delete(p);
+		}
+	}
+	inline size_type max_size() const
+	{
+		return static_cast<size_type>(-1) / sizeof(T);
+	}
+	inline void construct(pointer p, const T& value)
+	{
+		new (static_cast<void *>(p)) T(value);
+	}
+	inline void destroy(pointer p)
+	{
+		p->~T();
+	}
+private:
+	static inline size_t alignment()
+	{
+		// Size of the type is a multiple of it's alignment
+		size_t result = 1U;
+		while (result < Arena::MaxAlignment && (sizeof(T) & result) == 0U) {
+			result <<= 1;
+		}
+		return result;
+	}
+
+	Arena * _arena;
+};
+
+template <class T, class U>
+inline bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+	return lhs.arena() == rhs.arena();
+}
+
+template <class T, class U>
+inline bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+	return lhs.arena() != rhs.arena();
+}
+
+} // namespace httpxx
+
+#endif
@@ -0,0 +1,1432 @@
+#ifndef HTTPXX_BASIC_MESSAGE_PARSER_H
+#define HTTPXX_BASIC_MESSAGE_PARSER_H
+
+#include <httpxx/char_utils.h>
+#include <httpxx/header_ids.h>
+#include <string>
+#include <vector>
+#include <exception>
+#include <algorithm>
+#include <cstring>
+
+#ifndef HTTPXX_DEFAULT_MAX_HEADER_NAME_LENGTH
+#define HTTPXX_DEFAULT_MAX_HEADER_NAME_LENGTH 256
+#endif
+#ifndef HTTPXX_DEFAULT_MAX_HEADER_VALUE_LENGTH
+#define HTTPXX_DEFAULT_MAX_HEADER_VALUE_LENGTH 4096	// 4 Kb
+#endif
+#ifndef HTTPXX_DEFAULT_MAX_HEADERS_AMOUNT
+#define HTTPXX_DEFAULT_MAX_HEADERS_AMOUNT 256
+#endif
+
+// Parser states are dispatched by computed goto on GCC/Clang, define HTTPXX_NO_COMPUTED_GOTO to use switch
+#if defined(__GNUC__) && !defined(HTTPXX_NO_COMPUTED_GOTO)
+#define HTTPXX_COMPUTED_GOTO
+#define HTTPXX_STATE_CASE(state) case state: state##Label:
+#else
+#define HTTPXX_STATE_CASE(state) case state:
+#endif
+
+namespace httpxx
+{
+
+//! Base class of the HTTP-message parsers
+/*!
+ * Contains definitions, which do not depend on the way parsed data is handled.
+ */
+class MessageParserBase
+{
+public:
+	//! Class constants
+	enum Constants {
+		DefaultMaxHeaderNameLength = HTTPXX_DEFAULT_MAX_HEADER_NAME_LENGTH,
+		DefaultMaxHeaderValueLength = HTTPXX_DEFAULT_MAX_HEADER_VALUE_LENGTH,
+		DefaultMaxHeadersAmount = HTTPXX_DEFAULT_MAX_HEADERS_AMOUNT
+	};
+	//! Parser states
+	enum State {
+		ParsingMessage,					//!< Initial state
+		ParsingLeadingSP,				//!< Parsing leading space
+		ParsingFirstToken,				//!< Parsing first token
+		ParsingFirstTokenSP,				//!< Parsing the delimeter b/w first and second token
+		ParsingSecondToken,				//!< Parsing second token
+		ParsingSecondTokenSP,				//!< Parsing the delimeter b/w second and third token
+		ParsingThirdToken,				//!< Parsing third token
+		ParsingFirstLineLF,				//!< First line LF has been found
+		ParsingHeader,					//!< Parsing the beginning of the message header
+		ParsingHeaderName,				//!< Parsing message header name
+		ParsingHeaderValue,				//!< Parsing message header value
+		ParsingHeaderValueLF,				//!< Message header line LF has been found
+		ParsingHeaderValueLWS,				//!< Parsing message header multiline value LWS
+		ParsingEndOfHeader,				//!< Parsing the end of the message header section
+		ParsingIdentityBody,				//!< Parsing indentity-encoded message body
+		ParsingChunkSize,				//!< Parsing the chunk size of the chunked-encoded message body
+		ParsingChunkSizeLF,				//!< Chunk size line LF of of the chunked-encoded message body has been found
+		ParsingChunkExtension,				//!< Parsing the chunk extension of the of the chunked-encoded message body
+		ParsingChunk,					//!< Parsing the chunk of the chunked-encoded message body
+		ParsingChunkCR,					//!< Chunk's CR has been found
+		ParsingChunkLF,					//!< Chunk's LF has been found
+		ParsingTrailerHeader,				//!< Parsing the beginning of the message trailer header
+		ParsingTrailerHeaderName,			//!< Parsing message trailer header name
+		ParsingTrailerHeaderValue,			//!< Parsing message trailer header value
+		ParsingTrailerHeaderValueLF,			//!< Message trailer header line LF has been found
+		ParsingTrailerHeaderValueLWS,			//!< Parsing message trailer header multiline value LWS
+		ParsingFinalLF,					//!< Parsing final LF of the message
+	};
+	//! "Connection" header option flags (see MessageProperties)
+	enum ConnectionOptionFlags {
+		CloseConnectionOption = 0x01,			//!< "close"
+		KeepAliveConnectionOption = 0x02,		//!< "keep-alive"
+		UpgradeConnectionOption = 0x04			//!< "upgrade"
+	};
+	//! "Transfer-Encoding" header transfer-coding flags (see MessageProperties)
+	enum TransferCodingFlags {
+		ChunkedTransferCoding = 0x01,			//!< "chunked"
+		GzipTransferCoding = 0x02,			//!< "gzip" or "x-gzip"
+		DeflateTransferCoding = 0x04,			//!< "deflate"
+		CompressTransferCoding = 0x08,			//!< "compress" or "x-compress"
+		IdentityTransferCoding = 0x10,			//!< "identity"
+		UnknownTransferCoding = 0x20			//!< Any other transfer-coding
+	};
+	//! Framing and connection properties of the HTTP-message
+	/*!
+	 * Properties are collected from the header section while headers are parsed, so
+	 * handler does not need to look the headers up and parse their values again.
+	 * Lists are case-insensitive, parameters of the list elements are ignored.
+	 */
+	struct MessageProperties
+	{
+		//! Constructs empty properties
+		MessageProperties() :
+			hasContentLength(false),
+			contentLength(0U),
+			connectionOptions(0U),
+			transferCodings(0U),
+			transferCodingsAmount(0U),
+			isChunked(false)
+		{}
+
+		bool hasContentLength;				//!< TRUE if "Content-Length" header is present
+		uint64_t contentLength;				//!< Value of the first "Content-Length" header or 0 if it is invalid
+		unsigned int connectionOptions;			//!< ConnectionOptionFlags of all "Connection" headers
+		unsigned int transferCodings;			//!< TransferCodingFlags of all "Transfer-Encoding" headers
+		size_t transferCodingsAmount;			//!< Amount of transfer-codings in all "Transfer-Encoding" headers
+		bool isChunked;					//!< TRUE if "chunked" is the final transfer-coding
+	};
+	//! Payload chunk { ptr => size }
+	typedef std::pair<const void *, size_t> PayloadChunk;
+	//! Payload chunks container
+	typedef std::vector<PayloadChunk> Payload;
+	//! HTTP-message parser exception class
+	class Exception : public std::exception
+	{
+	public:
+		//! HTTP-message parser error codes
+		enum Code {
+			InvalidFirstToken,
+			FirstTokenIsTooLong,
+			InvalidSecondToken,
+			SecondTokenIsTooLong,
+			InvalidThirdToken,
+			ThirdTokenIsTooLong,
+			InvalidFirstLineLF,
+			TooManyHeaders,
+			EmptyHeaderName,
+			InvalidHeaderName,
+			HeaderNameIsTooLong,
+			HeaderIsMissingColon,
+			InvalidHeaderValue,
+			HeaderValueIsTooLong,
+			InvalidHeaderLF,
+			InvalidContentLength,
+			EmptyChunkSize,
+			InvalidChunkSize,
+			InvalidChunkSizeLF,
+			InvalidChunkDataCR,
+			InvalidChunkDataLF,
+			InvalidFinalLF,
+			InvalidState,
+		};
+		//! Constructs an HTTP-message parser exception
+		/*!
+		  \param ch Character, which caused an error
+		  \param pos Position of the error in the HTTP-message (starts from 0)
+		  \param line Line of the error in the HTTP-message (starts from 1)
+		  \param col Column of the error in the HTTP-message (starts from 1)
+		  \param code Error code
+		*/
+		Exception(char ch, int pos, int line, int col, Code code);
+		virtual ~Exception() throw ()
+		{}
+		//! Returns a character, which caused an error
+		inline char ch() const
+		{
+			return _ch;
+		}
+		//! Returns a position of the error in the HTTP-message
+		inline int pos() const
+		{
+			return _pos;
+		}
+		//! Returns a line of the error in the HTTP-message
+		inline int line() const
+		{
+			return _line;
+		}
+		//! Returns a column of the error in the HTTP-message
+		inline int col() const
+		{
+			return _col;
+		}
+		//! Returns error code
+		inline const Code code() const
+		{
+			return _code;
+		}
+		//! Returns error message
+		const char * msg() const throw ();
+
+		//! Returns full error message
+		virtual const char * what() const throw ();
+	private:
+		const char _ch;
+		const int _pos;
+		const int _line;
+		const int _col;
+		const Code _code;
+		mutable std::string _what;
+	};
+	//! HTTP-message parsing error
+	struct ParseError
+	{
+		//! Constructs an empty parsing error
+		ParseError() :
+			code(Exception::InvalidState),
+			ch('\0'),
+			pos(0),
+			line(0),
+			col(0)
+		{}
+		//! Constructs parsing error
+		/*!
+		  \param errorCode Error code
+		  \param errorCh Character, which caused an error
+		  \param errorPos Position of the error in the HTTP-message (starts from 0)
+		  \param errorLine Line of the error in the HTTP-message (starts from 1)
+		  \param errorCol Column of the error in the HTTP-message (starts from 1)
+		*/
+		ParseError(Exception::Code errorCode, char errorCh, size_t errorPos, size_t errorLine, size_t errorCol) :
+			code(errorCode),
+			ch(errorCh),
+			pos(errorPos),
+			line(errorLine),
+			col(errorCol)
+		{}
+		//! Returns error message
+		inline const char * msg() const
+		{
+			return errorMessage(code);
+		}
+
+		Exception::Code code;				//!< Error code
+		char ch;					//!< Character, which caused an error
+		size_t pos;					//!< Position of the error in the HTTP-message
+		size_t line;					//!< Line of the error in the HTTP-message
+		size_t col;					//!< Column of the error in the HTTP-message
+	};
+	//! Result of the non-throwing parsing
+	struct ParseResult
+	{
+		//! Constructs parsing result
+		/*!
+		  \param isCompleted TRUE if complete message has been successfully parsed
+		  \param parsedBytes Parsed bytes amount
+		*/
+		ParseResult(bool isCompleted = false, size_t parsedBytes = 0U) :
+			completed(isCompleted),
+			bytesParsed(parsedBytes),
+			failed(false),
+			error()
+		{}
+
+		bool completed;					//!< TRUE if complete message has been successfully parsed
+		size_t bytesParsed;				//!< Parsed bytes amount (the erroneous character is not included)
+		bool failed;					//!< TRUE if HTTP-message is malformed
+		ParseError error;				//!< Parsing error (valid if failed is TRUE)
+	};
+
+	//! Returns error message by error code
+	static const char * errorMessage(Exception::Code code);
+protected:
+	//! Returns TransferCodingFlags of the transfer-coding name
+	static unsigned int transferCoding(const char * name, size_t len);
+	//! Returns ConnectionOptionFlags of the connection option or 0 if option is not a well-known one
+	static unsigned int connectionOption(const char * name, size_t len);
+};
+
+//! Event-driven HTTP-message parser
+/*!
+ * Stateful, streaming-capable HTTP-message parser, which does not store
+ * parsed data, but reports it to the handler by calling it's hooks.
+ * Handler is a class, which is derived from the parser and which hides
+ * the hooks it is interested in. Hooks are dispatched statically, so they
+ * are inlined into the parser's state machine and parser does not allocate
+ * any memory itself.
+ *
+ * Available hooks (all of them do nothing by default):
+ *
+ * - <i>void onMessageBegin()</i> - new HTTP-message parsing has been started;
+ * - <i>void onFirstToken(const char * p, size_t len)</i> - first token fragment;
+ * - <i>void onSecondToken(const char * p, size_t len)</i> - second token fragment;
+ * - <i>void onThirdToken(const char * p, size_t len)</i> - third token fragment;
+ * - <i>void onHeaderName(const char * p, size_t len)</i> - header name fragment;
+ * - <i>void onHeaderValue(const char * p, size_t len)</i> - header value fragment;
+ * - <i>void onHeaderFieldComplete()</i> - header name and value have been completely parsed;
+ * - <i>void onHeadersComplete()</i> - header section has been completely parsed;
+ * - <i>void onBodyData(const char * p, size_t len)</i> - message body fragment;
+ * - <i>void onMessageComplete()</i> - HTTP-message has been completely parsed.
+ *
+ * Tokens, header names and values could be reported by several fragments, e.g.
+ * if they are split between buffers. Header value fragments do not include
+ * leading whitespace, LWS of the multiline value is reported as a single space,
+ * trailing whitespace is reported as is. Message trailer headers are reported
+ * by the same header hooks after the message body.
+ *
+ * "Content-Length", "Transfer-Encoding" and "Connection" headers are parsed
+ * on the fly, their typed values are returned by properties().
+ *
+ * Fragments point to the parsed buffer, so they are valid in the hook only,
+ * unless the buffer outlives the handling of the message.
+ *
+ * Line and column are updated on each parsed character by default. Handler, which
+ * declares <i>enum { LazyPositionTracking = 1 };</i>, turns lazy position tracking
+ * on at compile time: only the absolute position is updated on each character,
+ * line breaks are counted by the parser states which accept them and column
+ * is calculated from the last line break when it is requested (e.g. on error).
+ *
+ * Malformed HTTP-message causes parse() methods to throw an Exception. Use
+ * tryParse() methods to get the error in the ParseResult instead, which is
+ * cheaper if malformed messages are expected. After the error has been
+ * reported by tryParse() parser stays failed until it is reset.
+ *
+ * Example of use:
+ * \code{.cpp}
+ * class RequestCounter : public httpxx::BasicMessageParser<RequestCounter>
+ * {
+ * public:
+ *     RequestCounter() :
+ *         httpxx::BasicMessageParser<RequestCounter>(16U, 1024U, 16U),
+ *         requests(0U)
+ *     {}
+ *
+ *     void onMessageComplete()
+ *     {
+ *         ++requests;
+ *     }
+ *
+ *     size_t requests;
+ * };
+ * \endcode
+ *
+ * \note If the hooks of the handler are not public, declare parser as a friend of the handler.
+ */
+template <class Handler>
+class BasicMessageParser : public MessageParserBase
+{
+public:
+	//! Constructs parser
+	/*!
+	  \param maxFirstTokenLength Maximum first token length
+	  \param maxSecondTokenLength Maximum second token length
+	  \param maxThirdTokenLength Maximum third token length
+	  \param maxHeaderNameLength Maximum header name length
+	  \param maxHeaderValueLength Maximum header value length
+	  \param maxHeadersAmount Maximum headers amount
+	*/
+	BasicMessageParser(size_t maxFirstTokenLength, size_t maxSecondTokenLength, size_t maxThirdTokenLength,
+			size_t maxHeaderNameLength = DefaultMaxHeaderNameLength,
+			size_t maxHeaderValueLength = DefaultMaxHeaderValueLength,
+			size_t maxHeadersAmount = DefaultMaxHeadersAmount) :
+		_state(ParsingMessage),
+		_pos(0),
+		_line(1),
+		_col(1),
+		_lineBegin(0),
+		_fieldLength(0),
+		_headersAmount(0),
+		_headerName(),
+		_headerFieldId(UnknownHeaderId),
+		_headerValueStarted(false),
+		_framingHeader(UnknownHeaderId),
+		_framingValue(),
+		_framingValueLength(0),
+		_framingValueOverflow(false),
+		_listParameters(false),
+		_listTokenEnded(false),
+		_contentLengthInvalid(false),
+		_properties(),
+		_contentLength(0),
+		_identityBodyBytesParsed(0),
+		_chunkSizeDigits(0),
+		_chunkSizeOverflow(false),
+		_chunkSize(0),
+		_chunkBytesParsed(0),
+		_maxFirstTokenLength(maxFirstTokenLength),
+		_maxSecondTokenLength(maxSecondTokenLength),
+		_maxThirdTokenLength(maxThirdTokenLength),
+		_maxHeaderNameLength(maxHeaderNameLength),
+		_maxHeaderValueLength(maxHeaderValueLength),
+		_maxHeadersAmount(maxHeadersAmount),
+		_throwErrors(true),
+		_failed(false),
+		_error()
+	{}
+
+	//! Returns a current position of the HTTP-message parser (starts from 0)
+	inline size_t pos() const
+	{
+		return _pos;
+	}
+	//! Returns a current line of the HTTP-message parser (starts from 1)
+	/*!
+	 * \note With lazy position tracking (see LazyPositionTracking) line breaks of
+	 *       the body data are not counted, so the line stops at the end of the header
+	 *       section (the lines of the chunked-encoding framing and the trailer headers
+	 *       are still counted).
+	 */
+	inline size_t line() const
+	{
+		return _line;
+	}
+	//! Returns a current column of the HTTP-message parser (starts from 1)
+	inline size_t col() const
+	{
+		return Handler::LazyPositionTracking ? _pos - _lineBegin + 1U : _col;
+	}
+	//! Returns maximum first token length
+	inline size_t maxFirstTokenLength() const
+	{
+		return _maxFirstTokenLength;
+	}
+	//! Returns maximum second token length
+	inline size_t maxSecondTokenLength() const
+	{
+		return _maxSecondTokenLength;
+	}
+	//! Returns maximum third token length
+	inline size_t maxThirdTokenLength() const
+	{
+		return _maxThirdTokenLength;
+	}
+	//! Returns maximum header field name length
+	inline size_t maxHeaderNameLength() const
+	{
+		return _maxHeaderNameLength;
+	}
+	//! Sets maximum header field name length
+	/*!
+	  \param newValue New maximum header field name length
+	*/
+	inline void setMaxHeaderNameLength(size_t newValue)
+	{
+		_maxHeaderNameLength = newValue;
+	}
+	//! Returns maximum header field value length
+	inline size_t maxHeaderValueLength() const
+	{
+		return _maxHeaderValueLength;
+	}
+	//! Sets maximum header field value length
+	/*!
+	  \param newValue New maximum header field value length
+	*/
+	inline void setMaxHeaderValueLength(size_t newValue)
+	{
+		_maxHeaderValueLength = newValue;
+	}
+	//! Returns maximum headers amount
+	inline size_t maxHeadersAmount() const
+	{
+		return _maxHeadersAmount;
+	}
+	//! Sets maximum headers amount
+	/*!
+	  \param newValue New maximum headers amount
+	*/
+	inline void setMaxHeadersAmount(size_t newValue)
+	{
+		_maxHeadersAmount = newValue;
+	}
+	//! Return the state of the parser
+	inline State state() const
+	{
+		return _state;
+	}
+	//! Returns TRUE if the whole HTTP-message has been completely parsed
+	inline bool isCompleted() const
+	{
+		return _state == ParsingMessage;
+	}
+	//! Inspects if next character is expected to be of HTTP-message body
+	inline bool bodyExpected() const
+	{
+		return _state == ParsingIdentityBody || _state == ParsingChunk;
+	}
+	//! Returns an identifier of the header being parsed (valid in header value hooks and onHeaderFieldComplete())
+	inline HeaderId headerFieldId() const
+	{
+		return _headerFieldId;
+	}
+	//! Returns TRUE if the message body is chunked-encoded (valid after the header section has been parsed)
+	inline bool isChunked() const
+	{
+		return _properties.isChunked;
+	}
+	//! Returns framing and connection properties of the message collected from the headers parsed so far
+	inline const MessageProperties& properties() const
+	{
+		return _properties;
+	}
+	//! Returns the length of identity-encoded message body (valid after the header section has been parsed)
+	inline uint64_t contentLength() const
+	{
+		return _contentLength;
+	}
+	//! Returns TRUE if the parser has failed to parse malformed HTTP-message in non-throwing mode
+	inline bool failed() const
+	{
+		return _failed;
+	}
+	//! Returns parsing error (valid if failed() returns TRUE)
+	inline const ParseError& error() const
+	{
+		return _error;
+	}
+	//! Parses next character
+	/*!
+	  \param ch Next character to parse
+	  \return TRUE if complete message has been successfully parsed
+	*/
+	bool parse(char ch)
+	{
+		_throwErrors = true;
+		if (_failed) {
+			throwError();
+		}
+		return parseCharacter(ch);
+	}
+	//! Parses buffer for an HTTP-message
+	/*!
+	 * Parsing stops after the HTTP-message has been completely parsed.
+	 * \param buf Pointer to the buffer to parse
+	 * \param bufLen Size of the buffer to parse
+	 * \return A pair with complete message flag and parsed bytes amount
+	*/
+	std::pair<bool, size_t> parse(const void * buf, size_t bufLen)
+	{
+		_throwErrors = true;
+		if (_failed) {
+			throwError();
+		}
+		return parseBuffer(static_cast<const char *>(buf), bufLen);
+	}
+	//! Parses next character without throwing an exception on error
+	/*!
+	  \param ch Next character to parse
+	  \return Parsing result
+	*/
+	ParseResult tryParse(char ch)
+	{
+		_throwErrors = false;
+		ParseResult result;
+		if (!_failed) {
+			result.completed = parseCharacter(ch);
+		}
+		return completeResult(result, 1U);
+	}
+	//! Parses buffer for an HTTP-message without throwing an exception on error
+	/*!
+	 * Parsing stops after the HTTP-message has been completely parsed or an error has occured.
+	 * \param buf Pointer to the buffer to parse
+	 * \param bufLen Size of the buffer to parse
+	 * \return Parsing result
+	*/
+	ParseResult tryParse(const void * buf, size_t bufLen)
+	{
+		_throwErrors = false;
+		ParseResult result;
+		if (!_failed) {
+			std::pair<bool, size_t> res = parseBuffer(static_cast<const char *>(buf), bufLen);
+			result.completed = res.first;
+			result.bytesParsed = res.second;
+		}
+		return completeResult(result, 0U);
+	}
+	//! Resets parser
+	void reset()
+	{
+		_state = ParsingMessage;
+		_pos = 0;
+		_line = 1;
+		_col = 1;
+		_lineBegin = 0;
+		_fieldLength = 0;
+		_headersAmount = 0;
+		_headerValueStarted = false;
+		_headerFieldId = UnknownHeaderId;
+		_framingHeader = UnknownHeaderId;
+		_framingValueLength = 0;
+		_framingValueOverflow = false;
+		_listParameters = false;
+		_listTokenEnded = false;
+		_contentLengthInvalid = false;
+		_properties = MessageProperties();
+		_contentLength = 0;
+		_identityBodyBytesParsed = 0;
+		_chunkSizeDigits = 0;
+		_chunkSizeOverflow = false;
+		_chunkSize = 0;
+		_chunkBytesParsed = 0;
+		_failed = false;
+		_error = ParseError();
+	}
+protected:
+	~BasicMessageParser()
+	{}
+
+	//! Default new message hook
+	inline void onMessageBegin()
+	{}
+	//! Default first token fragment hook
+	inline void onFirstToken(const char * /* p */, size_t /* len */)
+	{}
+	//! Default second token fragment hook
+	inline void onSecondToken(const char * /* p */, size_t /* len */)
+	{}
+	//! Default third token fragment hook
+	inline void onThirdToken(const char * /* p */, size_t /* len */)
+	{}
+	//! Default header name fragment hook
+	inline void onHeaderName(const char * /* p */, size_t /* len */)
+	{}
+	//! Default header value fragment hook
+	inline void onHeaderValue(const char * /* p */, size_t /* len */)
+	{}
+	//! Default header field completion hook
+	inline void onHeaderFieldComplete()
+	{}
+	//! Default header section completion hook
+	inline void onHeadersComplete()
+	{}
+	//! Default message body fragment hook
+	inline void onBodyData(const char * /* p */, size_t /* len */)
+	{}
+	//! Default message completion hook
+	inline void onMessageComplete()
+	{}
+	//! Default position tracking policy
+	enum PositionTrackingPolicy {
+		LazyPositionTracking = 0			//!< Line and column are updated on each character
+	};
+private:
+	enum PrivateConstants {
+		MaxFramingValueLength = 32,
+		MaxChunkSizeDigits = 16
+	};
+
+	BasicMessageParser();
+
+	inline Handler& handler()
+	{
+		return static_cast<Handler&>(*this);
+	}
+
+	bool parseCharacter(char ch);
+	std::pair<bool, size_t> parseBuffer(const char * buf, size_t bufLen);
+	void parseChar(const char * p);
+	size_t parseRun(const char * buf, size_t bufLen);
+	size_t parseBody(const char * buf, size_t bufLen);
+	void updatePosition(const char * buf, size_t bufLen);
+	template <bool IsTrailer>
+	void parseHeader(const char * p);
+	template <bool IsTrailer>
+	void parseHeaderName(const char * p);
+	template <bool IsTrailer>
+	void parseHeaderValue(const char * p);
+	template <bool IsTrailer>
+	void parseHeaderValueLF(const char * p);
+	template <bool IsTrailer>
+	void parseHeaderValueLWS(const char * p);
+	void parseEndOfHeader(const char * p);
+	void completeHeaderName(bool isTrailer);
+	void appendListValue(const char * p, size_t len);
+	void completeListElement();
+	bool completeHeaderField(char ch);
+	void completeMessage();
+
+	inline void fail(char ch, Exception::Code code)
+	{
+		if (_throwErrors) {
+			throw Exception(ch, _pos, _line, col(), code);
+		}
+		_failed = true;
+		_error = ParseError(code, ch, _pos, _line, col());
+	}
+	// Line feed, which is accepted by the state machine, is counted here for the lazy
+	// position tracking (parser position is not incremented yet)
+	inline void feedLine()
+	{
+		if (Handler::LazyPositionTracking) {
+			++_line;
+			_lineBegin = _pos + 1U;
+		}
+	}
+	inline void throwError() const
+	{
+		throw Exception(_error.ch, _error.pos, _error.line, _error.col, _error.code);
+	}
+	inline ParseResult& completeResult(ParseResult& result, size_t charsParsed) const
+	{
+		if (_failed) {
+			result.completed = false;
+			result.failed = true;
+			result.error = _error;
+		} else if (charsParsed > 0U) {
+			result.bytesParsed = charsParsed;
+		}
+		return result;
+	}
+
+	inline void appendFirstToken(const char * p, size_t len)
+	{
+		_fieldLength += len;
+		handler().onFirstToken(p, len);
+	}
+	inline void appendSecondToken(const char * p, size_t len)
+	{
+		_fieldLength += len;
+		handler().onSecondToken(p, len);
+	}
+	inline void appendThirdToken(const char * p, size_t len)
+	{
+		_fieldLength += len;
+		handler().onThirdToken(p, len);
+	}
+	inline void appendHeaderName(const char * p, size_t len)
+	{
+		// Keeping the beginning of the header name to identify well-known headers
+		if (_fieldLength < MaxKnownHeaderNameLength) {
+			memcpy(_headerName + _fieldLength, p, std::min(len, MaxKnownHeaderNameLength - _fieldLength));
+		}
+		_fieldLength += len;
+		handler().onHeaderName(p, len);
+	}
+	void appendHeaderValue(const char * p, size_t len);
+	inline void appendChunkSizeDigits(const char * p, size_t len)
+	{
+		// Significant digits are collected to the framing value buffer, which is free while parsing body
+		if (_chunkSizeDigits <= 0) {
+			_framingValueLength = 0;
+			_chunkSizeOverflow = false;
+		}
+		_chunkSizeDigits += len;
+		for (size_t i = 0U; i < len; ++i) {
+			if (_framingValueLength <= 0 && p[i] == '0') {
+				// Skipping leading zeros
+			} else if (_framingValueLength < MaxChunkSizeDigits) {
+				_framingValue[_framingValueLength++] = p[i];
+			} else {
+				_chunkSizeOverflow = true;
+			}
+		}
+	}
+
+	State _state;
+	size_t _pos;
+	size_t _line;
+	size_t _col;
+	size_t _lineBegin;
+	size_t _fieldLength;
+	size_t _headersAmount;
+	char _headerName[MaxKnownHeaderNameLength];
+	HeaderId _headerFieldId;
+	bool _headerValueStarted;
+	HeaderId _framingHeader;
+	char _framingValue[MaxFramingValueLength];
+	size_t _framingValueLength;
+	bool _framingValueOverflow;
+	bool _listParameters;
+	bool _listTokenEnded;
+	bool _contentLengthInvalid;
+	MessageProperties _properties;
+	uint64_t _contentLength;
+	uint64_t _identityBodyBytesParsed;
+	size_t _chunkSizeDigits;
+	bool _chunkSizeOverflow;
+	uint64_t _chunkSize;
+	uint64_t _chunkBytesParsed;
+	size_t _maxFirstTokenLength;
+	size_t _maxSecondTokenLength;
+	size_t _maxThirdTokenLength;
+	size_t _maxHeaderNameLength;
+	size_t _maxHeaderValueLength;
+	size_t _maxHeadersAmount;
+	bool _throwErrors;
+	bool _failed;
+	ParseError _error;
+};
+
+//------------------------------------------------------------------------------
+// BasicMessageParser implementation
+//------------------------------------------------------------------------------
+
+template <class Handler>
+bool BasicMessageParser<Handler>::parseCharacter(char ch)
+{
+	if (bodyExpected()) {
+		parseBody(&ch, 1U);
+	} else {
+		parseChar(&ch);
+	}
+	return _state == ParsingMessage;
+}
+
+template <class Handler>
+std::pair<bool, size_t> BasicMessageParser<Handler>::parseBuffer(const char * buf, size_t bufLen)
+{
+	size_t bytesParsed = 0;
+	bool completeMessageDetected = false;
+	while (bytesParsed < bufLen && !completeMessageDetected) {
+		if (bodyExpected()) {
+			// Skipping over the whole body part which is available in the buffer
+			bytesParsed += parseBody(buf + bytesParsed, bufLen - bytesParsed);
+		} else {
+			bytesParsed += parseRun(buf + bytesParsed, bufLen - bytesParsed);
+			if (bytesParsed < bufLen) {
+				parseChar(buf + bytesParsed);
+				if (_failed) {
+					break;
+				}
+				++bytesParsed;
+			}
+		}
+		completeMessageDetected = isCompleted();
+	}
+	return std::pair<bool, size_t>(completeMessageDetected, bytesParsed);
+}
+
+template <class Handler>
+void BasicMessageParser<Handler>::parseChar(const char * p)
+{
+	char ch = *p;
+#if defined(HTTPXX_COMPUTED_GOTO)
+	// Jumping right to the state's code w/o range check of the switch, labels follow the State order
+	static const void * const StateLabels[] = {
+		&&ParsingMessageLabel,
+		&&ParsingLeadingSPLabel,
+		&&ParsingFirstTokenLabel,
+		&&ParsingFirstTokenSPLabel,
+		&&ParsingSecondTokenLabel,
+		&&ParsingSecondTokenSPLabel,
+		&&ParsingThirdTokenLabel,
+		&&ParsingFirstLineLFLabel,
+		&&ParsingHeaderLabel,
+		&&ParsingHeaderNameLabel,
+		&&ParsingHeaderValueLabel,
+		&&ParsingHeaderValueLFLabel,
+		&&ParsingHeaderValueLWSLabel,
+		&&ParsingEndOfHeaderLabel,
+		&&ParsingIdentityBodyLabel,
+		&&ParsingChunkSizeLabel,
+		&&ParsingChunkSizeLFLabel,
+		&&ParsingChunkExtensionLabel,
+		&&ParsingChunkLabel,
+		&&ParsingChunkCRLabel,
+		&&ParsingChunkLFLabel,
+		&&ParsingTrailerHeaderLabel,
+		&&ParsingTrailerHeaderNameLabel,
+		&&ParsingTrailerHeaderValueLabel,
+		&&ParsingTrailerHeaderValueLFLabel,
+		&&ParsingTrailerHeaderValueLWSLabel,
+		&&ParsingFinalLFLabel
+	};
+	goto *StateLabels[_state];
+#endif
+	switch (_state) {
+	HTTPXX_STATE_CASE(ParsingMessage)
+		if (isSpaceOrTab(ch)) {
+			reset();
+			handler().onMessageBegin();
+			_state = ParsingLeadingSP;
+		} else if (isPrintableChar(ch)) {
+			reset();
+			handler().onMessageBegin();
+			appendFirstToken(p, 1);
+			_state = ParsingFirstToken;
+		} else {
+			fail(ch, Exception::InvalidFirstToken);
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingLeadingSP)
+		if (isSpaceOrTab(ch)) {
+			// Just ignore leading space
+		} else if (isPrintableChar(ch)) {
+			appendFirstToken(p, 1);
+			_state = ParsingFirstToken;
+		} else {
+			fail(ch, Exception::InvalidFirstToken);
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingFirstToken)
+		if (isSpaceOrTab(ch)) {
+			_state = ParsingFirstTokenSP;
+		} else if (isPrintableChar(ch)) {
+			if (_fieldLength >= _maxFirstTokenLength) {
+				fail(ch, Exception::FirstTokenIsTooLong);
+			} else {
+				appendFirstToken(p, 1);
+			}
+		} else {
+			fail(ch, Exception::InvalidFirstToken);
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingFirstTokenSP)
+		if (isSpaceOrTab(ch)) {
+			// Just ignore it
+		} else if (isPrintableChar(ch)) {
+			// Second token is empty -> no length check
+			_fieldLength = 0;
+			appendSecondToken(p, 1);
+			_state = ParsingSecondToken;
+		} else {
+			fail(ch, Exception::InvalidSecondToken);
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingSecondToken)
+		if (isSpaceOrTab(ch)) {
+			_state = ParsingSecondTokenSP;
+		} else if (isPrintableChar(ch)) {
+			if (_fieldLength >= _maxSecondTokenLength) {
+				fail(ch, Exception::SecondTokenIsTooLong);
+			} else {
+				appendSecondToken(p, 1);
+			}
+		} else {
+			fail(ch, Exception::InvalidSecondToken);
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingSecondTokenSP)
+		if (isSpaceOrTab(ch)) {
+			// Just ignore it
+		} else if (isPrintableChar(ch)) {
+			// Third token is empty -> no length check
+			_fieldLength = 0;
+			appendThirdToken(p, 1);
+			_state = ParsingThirdToken;
+		} else {
+			fail(ch, Exception::InvalidThirdToken);
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingThirdToken)
+		if (isCarriageReturn(ch)) {
+			_state = ParsingFirstLineLF;
+		} else if (isPrintableChar(ch)) {
+			if (_fieldLength >= _maxThirdTokenLength) {
+				fail(ch, Exception::ThirdTokenIsTooLong);
+			} else {
+				appendThirdToken(p, 1);
+			}
+		} else {
+			fail(ch, Exception::InvalidThirdToken);
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingFirstLineLF)
+		if (isLineFeed(ch)) {
+			feedLine();
+			_state = ParsingHeader;
+		} else {
+			fail(ch, Exception::InvalidFirstLineLF);
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingHeader)
+		parseHeader<false>(p);
+		break;
+	HTTPXX_STATE_CASE(ParsingHeaderName)
+		parseHeaderName<false>(p);
+		break;
+	HTTPXX_STATE_CASE(ParsingHeaderValue)
+		parseHeaderValue<false>(p);
+		break;
+	HTTPXX_STATE_CASE(ParsingHeaderValueLF)
+		parseHeaderValueLF<false>(p);
+		break;
+	HTTPXX_STATE_CASE(ParsingHeaderValueLWS)
+		parseHeaderValueLWS<false>(p);
+		break;
+	HTTPXX_STATE_CASE(ParsingEndOfHeader)
+		parseEndOfHeader(p);
+		break;
+	HTTPXX_STATE_CASE(ParsingIdentityBody)
+	HTTPXX_STATE_CASE(ParsingChunk)
+		parseBody(p, 1U);
+		// Position has been already updated
+		return;
+	HTTPXX_STATE_CASE(ParsingChunkSize)
+		if (isHexDigit(ch)) {
+			appendChunkSizeDigits(p, 1U);
+		} else {
+			if (_chunkSizeDigits <= 0) {
+				fail(ch, Exception::EmptyChunkSize);
+			} else if (_chunkSizeOverflow ||
+					(_framingValueLength > 0 && !parseHex(_framingValue, _framingValueLength, _chunkSize))) {
+				fail(ch, Exception::InvalidChunkSize);
+			} else {
+				_chunkBytesParsed = 0;
+				_chunkSizeDigits = 0;
+				if (isCarriageReturn(ch)) {
+					_state = ParsingChunkSizeLF;
+				} else {
+					_state = ParsingChunkExtension;
+				}
+			}
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingChunkExtension)
+		// Just ignore a chunk extension.
+		if (isCarriageReturn(ch)) {
+			_state = ParsingChunkSizeLF;
+		} else if (isLineFeed(ch)) {
+			feedLine();
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingChunkSizeLF)
+		if (isLineFeed(ch)) {
+			feedLine();
+			_state = (_chunkSize > 0) ? ParsingChunk : ParsingTrailerHeader;
+		} else {
+			fail(ch, Exception::InvalidChunkSizeLF);
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingChunkCR)
+		if (isCarriageReturn(ch)) {
+			_state = ParsingChunkLF;
+		} else {
+			fail(ch, Exception::InvalidChunkDataCR);
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingChunkLF)
+		if (isLineFeed(ch)) {
+			feedLine();
+			_chunkSize = 0;
+			_state = ParsingChunkSize;
+		} else {
+			fail(ch, Exception::InvalidChunkDataLF);
+		}
+		break;
+	HTTPXX_STATE_CASE(ParsingTrailerHeader)
+		parseHeader<true>(p);
+		break;
+	HTTPXX_STATE_CASE(ParsingTrailerHeaderName)
+		parseHeaderName<true>(p);
+		break;
+	HTTPXX_STATE_CASE(ParsingTrailerHeaderValue)
+		parseHeaderValue<true>(p);
+		break;
+	HTTPXX_STATE_CASE(ParsingTrailerHeaderValueLF)
+		parseHeaderValueLF<true>(p);
+		break;
+	HTTPXX_STATE_CASE(ParsingTrailerHeaderValueLWS)
+		parseHeaderValueLWS<true>(p);
+		break;
+	HTTPXX_STATE_CASE(ParsingFinalLF)
+		if (isLineFeed(ch)) {
+			feedLine();
+			completeMessage();
+		} else {
+			fail(ch, Exception::InvalidFinalLF);
+		}
+		break;
+	default:
+		fail(ch, Exception::InvalidState);
+	}
+	if (_failed) {
+		// Parser stays on the erroneous character
+		return;
+	}
+	// Updating current position data
+	++_pos;
+	if (Handler::LazyPositionTracking) {
+		// Line feeds are counted by the states, which accept them
+		return;
+	}
+	if (isLineFeed(ch)) {
+		++_line;
+		_col = 1;
+	} else {
+		++_col;
+	}
+}
+
+template <class Handler>
+size_t BasicMessageParser<Handler>::parseRun(const char * buf, size_t bufLen)
+{
+	size_t runLen = 0U;
+	switch (_state) {
+	case ParsingFirstToken:
+		if (_fieldLength < _maxFirstTokenLength) {
+			runLen = spanVisibleChars(buf, std::min(bufLen, _maxFirstTokenLength - _fieldLength));
+			if (runLen > 0) {
+				appendFirstToken(buf, runLen);
+			}
+		}
+		break;
+	case ParsingSecondToken:
+		if (_fieldLength < _maxSecondTokenLength) {
+			runLen = spanVisibleChars(buf, std::min(bufLen, _maxSecondTokenLength - _fieldLength));
+			if (runLen > 0) {
+				appendSecondToken(buf, runLen);
+			}
+		}
+		break;
+	case ParsingThirdToken:
+		if (_fieldLength < _maxThirdTokenLength) {
+			runLen = spanPrintableChars(buf, std::min(bufLen, _maxThirdTokenLength - _fieldLength));
+			if (runLen > 0) {
+				appendThirdToken(buf, runLen);
+			}
+		}
+		break;
+	case ParsingHeaderName:
+	case ParsingTrailerHeaderName:
+		if (_fieldLength < _maxHeaderNameLength) {
+			runLen = spanTokenChars(buf, std::min(bufLen, _maxHeaderNameLength - _fieldLength));
+			if (runLen > 0) {
+				appendHeaderName(buf, runLen);
+			}
+		}
+		break;
+	case ParsingChunkSize:
+		while (runLen < bufLen && isHexDigit(buf[runLen])) {
+			++runLen;
+		}
+		if (runLen > 0) {
+			appendChunkSizeDigits(buf, runLen);
+		}
+		break;
+	case ParsingHeaderValue:
+	case ParsingTrailerHeaderValue:
+		if (_fieldLength < _maxHeaderValueLength) {
+			runLen = spanNonControlChars(buf, std::min(bufLen, _maxHeaderValueLength - _fieldLength));
+			if (runLen > 0) {
+				appendHeaderValue(buf, runLen);
+			}
+		}
+		break;
+	default:
+		break;
+	}
+	// Runs never contain LF
+	_pos += runLen;
+	if (!Handler::LazyPositionTracking) {
+		_col += runLen;
+	}
+	return runLen;
+}
+
+template <class Handler>
+size_t BasicMessageParser<Handler>::parseBody(const char * buf, size_t bufLen)
+{
+	size_t bodyBytes;
+	if (_state == ParsingIdentityBody) {
+		bodyBytes = static_cast<size_t>(std::min<uint64_t>(bufLen, _contentLength - _identityBodyBytesParsed));
+		_identityBodyBytesParsed += bodyBytes;
+	} else {
+		bodyBytes = static_cast<size_t>(std::min<uint64_t>(bufLen, _chunkSize - _chunkBytesParsed));
+		_chunkBytesParsed += bodyBytes;
+	}
+	updatePosition(buf, bodyBytes);
+	handler().onBodyData(buf, bodyBytes);
+	if (_state == ParsingIdentityBody) {
+		if (_identityBodyBytesParsed >= _contentLength) {
+			completeMessage();
+		}
+	} else if (_chunkBytesParsed >= _chunkSize) {
+		_state = ParsingChunkCR;
+	}
+	return bodyBytes;
+}
+
+template <class Handler>
+void BasicMessageParser<Handler>::updatePosition(const char * buf, size_t bufLen)
+{
+	if (Handler::LazyPositionTracking) {
+		// Body data is not inspected for line breaks
+		_pos += bufLen;
+		return;
+	}
+	const char * end = buf + bufLen;
+	const char * lineStart = buf;
+	const char * lf;
+	while ((lf = static_cast<const char *>(memchr(lineStart, '\n', end - lineStart))) != 0) {
+		++_line;
+		lineStart = lf + 1;
+	}
+	_pos += bufLen;
+	_col = (lineStart == buf) ? _col + bufLen : end - lineStart + 1;
+}
+
+template <class Handler>
+template <bool IsTrailer>
+void BasicMessageParser<Handler>::parseHeader(const char * p)
+{
+	char ch = *p;
+	if (isCarriageReturn(ch)) {
+		_state = IsTrailer ? ParsingFinalLF : ParsingEndOfHeader;
+	} else if (ch == ':') {
+		fail(ch, Exception::EmptyHeaderName);
+	} else if (isToken(ch)) {
+		// Header field name is empty -> no length check
+		_fieldLength = 0;
+		appendHeaderName(p, 1);
+		_state = IsTrailer ? ParsingTrailerHeaderName : ParsingHeaderName;
+	} else {
+		fail(ch, Exception::InvalidHeaderName);
+	}
+}
+
+template <class Handler>
+template <bool IsTrailer>
+void BasicMessageParser<Handler>::parseHeaderName(const char * p)
+{
+	char ch = *p;
+	if (isCarriageReturn(ch)) {
+		fail(ch, Exception::HeaderIsMissingColon);
+	} else if (ch == ':') {
+		completeHeaderName(IsTrailer);
+		_state = IsTrailer ? ParsingTrailerHeaderValue : ParsingHeaderValue;
+	} else if (isToken(ch)) {
+		if (_fieldLength < _maxHeaderNameLength) {
+			appendHeaderName(p, 1);
+		} else {
+			fail(ch, Exception::HeaderNameIsTooLong);
+		}
+	} else {
+		fail(ch, Exception::InvalidHeaderName);
+	}
+}
+
+template <class Handler>
+template <bool IsTrailer>
+void BasicMessageParser<Handler>::parseHeaderValue(const char * p)
+{
+	char ch = *p;
+	if (isCarriageReturn(ch)) {
+		_state = IsTrailer ? ParsingTrailerHeaderValueLF : ParsingHeaderValueLF;
+	} else if (!isControl(ch)) {
+		if (_fieldLength < _maxHeaderValueLength) {
+			appendHeaderValue(p, 1);
+		} else {
+			fail(ch, Exception::HeaderValueIsTooLong);
+		}
+	} else {
+		fail(ch, Exception::InvalidHeaderValue);
+	}
+}
+
+template <class Handler>
+template <bool IsTrailer>
+void BasicMessageParser<Handler>::parseHeaderValueLF(const char * p)
+{
+	char ch = *p;
+	if (isLineFeed(ch)) {
+		feedLine();
+		_state = IsTrailer ? ParsingTrailerHeaderValueLWS : ParsingHeaderValueLWS;
+	} else {
+		fail(ch, Exception::InvalidHeaderLF);
+	}
+}
+
+template <class Handler>
+template <bool IsTrailer>
+void BasicMessageParser<Handler>::parseHeaderValueLWS(const char * p)
+{
+	char ch = *p;
+	if (isCarriageReturn(ch)) {
+		if (completeHeaderField(ch)) {
+			_state = IsTrailer ? ParsingFinalLF : ParsingEndOfHeader;
+		}
+	} else if (ch == ':') {
+		fail(ch, Exception::EmptyHeaderName);
+	} else if (isSpaceOrTab(ch)) {
+		if (_fieldLength < _maxHeaderValueLength) {
+			appendHeaderValue(" ", 1);
+			_state = IsTrailer ? ParsingTrailerHeaderValue : ParsingHeaderValue;
+		} else {
+			fail(ch, Exception::HeaderValueIsTooLong);
+		}
+	} else if (isToken(ch)) {
+		if (completeHeaderField(ch)) {
+			// Header field name is empty -> no length check
+			_fieldLength = 0;
+			appendHeaderName(p, 1);
+			_state = IsTrailer ? ParsingTrailerHeaderName : ParsingHeaderName;
+		}
+	} else {
+		fail(ch, Exception::InvalidHeaderName);
+	}
+}
+
+template <class Handler>
+void BasicMessageParser<Handler>::parseEndOfHeader(const char * p)
+{
+	char ch = *p;
+	if (!isLineFeed(ch)) {
+		fail(ch, Exception::InvalidHeaderLF);
+	} else if (_properties.isChunked) {
+		feedLine();
+		_contentLength = 0;
+		_state = ParsingChunkSize;
+		handler().onHeadersComplete();
+	} else if (_contentLengthInvalid) {
+		fail(ch, Exception::InvalidContentLength);
+	} else if (_contentLength > 0) {
+		feedLine();
+		_state = ParsingIdentityBody;
+		handler().onHeadersComplete();
+	} else {
+		feedLine();
+		handler().onHeadersComplete();
+		completeMessage();
+	}
+}
+
+template <class Handler>
+void BasicMessageParser<Handler>::appendHeaderValue(const char * p, size_t len)
+{
+	_fieldLength += len;
+	if (!_headerValueStarted) {
+		// Skipping leading whitespace
+		while (len > 0 && isSpaceOrTab(*p)) {
+			++p;
+			--len;
+		}
+		if (len <= 0) {
+			return;
+		}
+		_headerValueStarted = true;
+	}
+	if (_framingHeader == ContentLengthHeaderId) {
+		// Keeping framing header value, trailing whitespace is dropped if there is no room for it
+		for (size_t i = 0U; i < len; ++i) {
+			if (_framingValueLength < MaxFramingValueLength) {
+				_framingValue[_framingValueLength++] = p[i];
+			} else if (!isSpaceOrTab(p[i])) {
+				_framingValueOverflow = true;
+			}
+		}
+	} else if (_framingHeader != UnknownHeaderId) {
+		appendListValue(p, len);
+	}
+	handler().onHeaderValue(p, len);
+}
+
+template <class Handler>
+void BasicMessageParser<Handler>::appendListValue(const char * p, size_t len)
+{
+	// Current list element name is kept in the framing value buffer
+	for (size_t i = 0U; i < len; ++i) {
+		char ch = p[i];
+		if (ch == ',') {
+			completeListElement();
+		} else if (_listParameters) {
+			// Skipping parameters up to the next list element
+		} else if (ch == ';') {
+			_listParameters = true;
+		} else if (isSpaceOrTab(ch)) {
+			_listTokenEnded = _framingValueLength > 0;
+		} else if (_listTokenEnded || _framingValueLength >= MaxFramingValueLength) {
+			// Name with whitespace inside or too long one is not a well-known one
+			_framingValueOverflow = true;
+		} else {
+			_framingValue[_framingValueLength++] = ch;
+		}
+	}
+}
+
+template <class Handler>
+void BasicMessageParser<Handler>::completeListElement()
+{
+	if (_framingValueLength > 0 || _framingValueOverflow) {
+		if (_framingHeader == TransferEncodingHeaderId) {
+			unsigned int coding = _framingValueOverflow ? static_cast<unsigned int>(UnknownTransferCoding) :
+				transferCoding(_framingValue, _framingValueLength);
+			_properties.transferCodings |= coding;
+			++_properties.transferCodingsAmount;
+			// Message body is chunked-encoded only if "chunked" is applied last
+			_properties.isChunked = coding == ChunkedTransferCoding;
+		} else if (!_framingValueOverflow) {
+			_properties.connectionOptions |= connectionOption(_framingValue, _framingValueLength);
+		}
+	}
+	_framingValueLength = 0;
+	_framingValueOverflow = false;
+	_listParameters = false;
+	_listTokenEnded = false;
+}
+
+template <class Handler>
+void BasicMessageParser<Handler>::completeHeaderName(bool isTrailer)
+{
+	_headerFieldId = _fieldLength <= MaxKnownHeaderNameLength ?
+		httpxx::headerId(_headerName, _fieldLength) : UnknownHeaderId;
+	// Trailer headers do not affect message properties
+	_framingHeader = (!isTrailer && (_headerFieldId == ContentLengthHeaderId ||
+				_headerFieldId == TransferEncodingHeaderId || _headerFieldId == ConnectionHeaderId)) ?
+		_headerFieldId : UnknownHeaderId;
+	_fieldLength = 0;
+	_headerValueStarted = false;
+	_framingValueLength = 0;
+	_framingValueOverflow = false;
+	_listParameters = false;
+	_listTokenEnded = false;
+}
+
+template <class Handler>
+bool BasicMessageParser<Handler>::completeHeaderField(char ch)
+{
+	if (_headersAmount >= _maxHeadersAmount) {
+		fail(ch, Exception::TooManyHeaders);
+		return false;
+	}
+	++_headersAmount;
+	if (_framingHeader == ContentLengthHeaderId && !_properties.hasContentLength) {
+		// First "Content-Length" header is taken into account only
+		while (_framingValueLength > 0 && isSpaceOrTab(_framingValue[_framingValueLength - 1])) {
+			--_framingValueLength;
+		}
+		_properties.hasContentLength = true;
+		size_t curPos = (_framingValueLength > 0 && _framingValue[0] == '+') ? 1U : 0U;
+		_contentLengthInvalid = _framingValueOverflow || (curPos < _framingValueLength &&
+				!parseDecimal(_framingValue + curPos, _framingValueLength - curPos, _contentLength));
+		_properties.contentLength = _contentLengthInvalid ? 0U : _contentLength;
+	} else if (_framingHeader == TransferEncodingHeaderId || _framingHeader == ConnectionHeaderId) {
+		completeListElement();
+	}
+	_framingHeader = UnknownHeaderId;
+	handler().onHeaderFieldComplete();
+	return true;
+}
+
+template <class Handler>
+void BasicMessageParser<Handler>::completeMessage()
+{
+	_state = ParsingMessage;
+	handler().onMessageComplete();
+}
+
+} // namespace httpxx
+
+#undef HTTPXX_STATE_CASE
+#undef HTTPXX_COMPUTED_GOTO
+
+#endif
@@ -0,0 +1,287 @@
+#ifndef HTTPXX_CHAR_UTILS_H
+#define HTTPXX_CHAR_UTILS_H
+
+#include <ctype.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace httpxx
+{
+
+//! Character class flags (see CharClasses)
+enum CharClassFlags {
+	ControlCharClass = 0x01,			//!< CTL
+	SpaceCharClass = 0x02,				//!< SP or HT
+	SeparatorCharClass = 0x04,			//!< Separator (see RFC-2616, section 2.2)
+	TokenCharClass = 0x08,				//!< Token character
+	DigitCharClass = 0x10,				//!< Decimal digit
+	HexDigitCharClass = 0x20,			//!< Hex digit
+	PrintableCharClass = 0x40			//!< CHAR, which is not CTL
+};
+
+//! Character class flags of each character
+extern const unsigned char CharClasses[256];
+
+//! Inspects if the character belongs to any of the classes
+/*!
+  \param ch Character to inspect
+  \param classes Character class flags
+*/
+inline bool isOfClass(unsigned char ch, unsigned char classes)
+{
+	return (CharClasses[ch] & classes) != 0;
+}
+
+//! TODO
+inline bool isLowAlpha(unsigned char ch)
+{
+	return ch >= 'a' && ch <= 'z';
+}
+
+//! TODO
+inline bool isUpAlpha(unsigned char ch)
+{
+	return ch >= 'A' && ch <= 'Z';
+}
+
+//! TODO
+inline bool isChar(unsigned char ch)
+{
+	return (ch <= 0x7F);
+}
+
+//! TODO
+inline bool isControl(unsigned char ch)
+{
+	return (ch <= 0x1F) || (ch == 0x7F);
+}
+
+//! Inspects if the character is space
+/*!
+  \param ch Character to inspect
+*/
+inline bool isSpace(unsigned char ch)
+{
+	return (ch == 0x20);
+}
+
+//! Inspects if the character is tab
+/*!
+  \param ch Character to inspect
+*/
+inline bool isTab(unsigned char ch)
+{
+	return (ch == 0x09);
+}
+
+//! Inspects if the character is space or tab
+/*!
+  \param ch Character to inspect
+*/
+inline bool isSpaceOrTab(unsigned char ch)
+{
+	return (isSpace(ch) || isTab(ch));
+}
+
+//! Inspects if the character is carriage return
+/*!
+  \param ch Character to inspect
+*/
+inline bool isCarriageReturn(unsigned char ch)
+{
+	return (ch == 0x0D);
+}
+
+//! Inspects if the character is line feed
+/*!
+  \param ch Character to inspect
+*/
+inline bool isLineFeed(unsigned char ch)
+{
+	return (ch == 0x0A);
+}
+
+//! Inspects if the character is digit
+/*!
+  \param ch Character to inspect
+*/
+inline bool isDigit(unsigned char ch)
+{
+	return isOfClass(ch, DigitCharClass);
+}
+
+//! Inspects if the character is hex digit
+/*!
+  \param ch Character to inspect
+*/
+inline bool isHexDigit(unsigned char ch)
+{
+	return isOfClass(ch, HexDigitCharClass);
+}
+
+//! Inspects if the character is URL-safe
+/*!
+  \param ch Character to inspect
+*/
+inline bool isUrlSafe(unsigned char ch)
+{
+	return ('a' <= ch && ch <= 'z') || ('A' <= ch && ch <= 'Z') || isDigit(ch) || (ch == '_');
+}
+
+//! TODO
+inline bool isSeparator(unsigned char ch)
+{
+	return isOfClass(ch, SeparatorCharClass);
+}
+
+//! TODO
+inline bool isAllowedInVersion(unsigned char ch)
+{
+	return isDigit(ch) || ch == 'H' || ch == 'T' || ch == 'P' || ch == '/' || ch == '.';
+}
+
+//! TODO
+inline bool isToken(unsigned char ch)
+{
+	return isOfClass(ch, TokenCharClass);
+}
+
+//! Inspects if the character is CHAR, which is not CTL
+/*!
+  \param ch Character to inspect
+*/
+inline bool isPrintableChar(unsigned char ch)
+{
+	return isOfClass(ch, PrintableCharClass);
+}
+
+//! TODO
+inline bool isAlpha(unsigned char ch)
+{
+	return isLowAlpha(ch) || isUpAlpha(ch);
+}
+
+//! TODO
+inline bool isAllowedInUri(unsigned char ch)
+{
+	// See chaper A. of the RFC2936 (http:www.ietf.org/rfc/rfc2396.txt)
+	return isAlpha(ch) || isDigit(ch) || ch == '#' || ch == ':' || ch == '?' || ch == ';' || ch == '@' ||
+		ch == '&' || ch == '=' || ch == '+' || ch == '$' || ch == ',' || ch == '-' || ch == '.' ||
+		ch == '/' || ch == '_' || ch == '!' || ch == '~' || ch == '*' || ch == '\'' || ch == '(' ||
+		ch == ')' || ch == '%';
+}
+
+//! Returns the value of the hex digit
+/*!
+  \param ch Hex digit
+*/
+unsigned char hexValue(unsigned char ch);
+
+//! Returns the length of the leading run of visible characters (non-CTL/SP/HT CHAR's)
+/*!
+  \param buf Buffer to inspect
+  \param len Buffer length
+*/
+size_t spanVisibleChars(const char * buf, size_t len);
+
+//! Returns the length of the leading run of printable characters (non-CTL CHAR's)
+/*!
+  \param buf Buffer to inspect
+  \param len Buffer length
+*/
+size_t spanPrintableChars(const char * buf, size_t len);
+
+//! Returns the length of the leading run of token characters
+/*!
+  \param buf Buffer to inspect
+  \param len Buffer length
+*/
+size_t spanTokenChars(const char * buf, size_t len);
+
+//! Returns the length of the leading run of non-CTL characters
+/*!
+  \param buf Buffer to inspect
+  \param len Buffer length
+*/
+size_t spanNonControlChars(const char * buf, size_t len);
+
+//! Inspects two character strings of the same length for equality ignoring ASCII case
+/*!
+ * Locale-independent: only 'A'..'Z' are folded. Characters are compared
+ * 16 (SSE2) or 8 at a time.
+ * \param lhs Left-hand side
+ * \param rhs Right-hand side
+ * \param len Length of the both strings
+*/
+bool equalsIgnoreCase(const char * lhs, const char * rhs, size_t len);
+
+//! Compares two character strings ignoring ASCII case
+/*!
+ * Locale-independent counterpart of strcasecmp(), which does not stop at NUL.
+ * \param lhs Left-hand side
+ * \param lhsLen Left-hand side length
+ * \param rhs Right-hand side
+ * \param rhsLen Right-hand side length
+ * \return Negative, zero or positive value if lhs is less, equal or greater than rhs
+*/
+int compareIgnoreCase(const char * lhs, size_t lhsLen, const char * rhs, size_t rhsLen);
+
+//! Returns a hash of the character string, which is the same for strings equal ignoring ASCII case
+/*!
+ * \param buf Buffer to hash
+ * \param len Buffer length
+*/
+size_t hashIgnoreCase(const char * buf, size_t len);
+
+//! Parses unsigned decimal integer
+/*!
+ * Digits are converted eight at a time, nothing is allocated.
+ * \param buf Buffer with digits only (no sign, no whitespace)
+ * \param len Buffer length
+ * \param result Parsed value [out]
+ * \return TRUE if the buffer is not empty, consists of decimal digits and it's value fits into 64 bits
+*/
+bool parseDecimal(const char * buf, size_t len, uint64_t& result);
+
+//! Parses unsigned hexadecimal integer
+/*!
+ * Digits are converted eight at a time, nothing is allocated.
+ * \param buf Buffer with hex digits only (no prefix, no whitespace)
+ * \param len Buffer length
+ * \param result Parsed value [out]
+ * \return TRUE if the buffer is not empty, consists of hex digits and it's value fits into 64 bits
+*/
+bool parseHex(const char * buf, size_t len, uint64_t& result);
+
+//! Limits of the formatted integers
+enum FormattedIntegerConstants {
+	MaxDecimalLength = 20,				//!< Maximum length of the decimal 64-bit integer
+	MaxHexLength = 16				//!< Maximum length of the hexadecimal 64-bit integer
+};
+
+//! Returns the amount of decimal digits of the unsigned integer
+size_t decimalLength(uint64_t value);
+
+//! Formats unsigned decimal integer
+/*!
+ * Digits are produced two at a time from the end, nothing is allocated.
+ * \param value Value to format
+ * \param buf Buffer to format into, which is at least decimalLength(value) bytes long
+ * \return Formatted length (no terminating NUL is written)
+*/
+size_t formatDecimal(uint64_t value, char * buf);
+
+//! Returns the amount of hex digits of the unsigned integer
+size_t hexLength(uint64_t value);
+
+//! Formats unsigned hexadecimal integer using lowercase digits
+/*!
+ * \param value Value to format
+ * \param buf Buffer to format into, which is at least hexLength(value) bytes long
+ * \return Formatted length (no terminating NUL is written)
+*/
+size_t formatHex(uint64_t value, char * buf);
+
+} // namespace httpxx
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef HTTPXX_CHUNKED_STREAMBUF_H
+#define HTTPXX_CHUNKED_STREAMBUF_H
+
+#include <httpxx/char_utils.h>
+#include <httpxx/headers.h>
+#include <httpxx/message_composer.h>
+#include <ostream>
+#include <streambuf>
+
+namespace httpxx
+{
+
+//! Stream buffer, which composes written data into chunked-encoded HTTP-message
+/*!
+ * Written data is coalesced into chunks of the configured size, so a lot of
+ * small writes do not produce a lot of small chunks. The buffer of the stream
+ * has a slot for the chunk envelope right before the data, so the envelope is
+ * composed in place and the chunk is written to the target stream by a single
+ * call. Writes, which are larger than the chunk size, are sent as separate chunks
+ * without copying.
+ *
+ * sync() (e.g. std::flush) sends the buffered data as a chunk, close() sends
+ * the rest of the data and the last chunk with the optional trailer headers.
+ * Data, which has not been sent before the destruction, is discarded.
+ *
+ * \code{.cpp}
+ * ...
+ *
+ * httpxx::MessageComposer composer("HTTP/1.1", "200", "OK");
+ * httpxx::ChunkedOStream out(composer, headers, socketStream);
+ * for (size_t i = 0U; i < rows.size(); ++i) {
+ *     out << rows[i].name << ": " << rows[i].value << "\n";
+ * }
+ * out.close();
+ *
+ * ...
+ * \endcode
+ *
+ * \note Composer and headers are used when the first chunk is sent, so they
+ *       should outlive the first chunk at least.
+ */
+class ChunkedStreambuf : public std::streambuf
+{
+public:
+	//! Class constants
+	enum Constants {
+		DefaultChunkSize = 4096				//!< Default size of the coalesced chunk
+	};
+
+	//! Constructs stream buffer
+	/*!
+	 * \param composer Composer of the HTTP-message
+	 * \param headers Headers of the HTTP-message
+	 * \param target Output stream to compose HTTP-message into
+	 * \param chunkSize Maximum size of the coalesced chunk
+	 */
+	ChunkedStreambuf(MessageComposer& composer, const Headers& headers, std::ostream& target,
+			size_t chunkSize = DefaultChunkSize);
+	//! Destructs stream buffer
+	/*!
+	 * Buffered data is discarded and the last chunk is not sent unless close()
+	 * has been called, so the HTTP-message, which composition has been interrupted
+	 * (e.g. by an exception), is not completed as a well-formed one.
+	 */
+	virtual ~ChunkedStreambuf();
+
+	//! Sends the buffered data and the last chunk
+	/*!
+	 * \param trailers Trailer headers to send in the last chunk
+	 * \return FALSE if the target stream has failed
+	 */
+	bool close(const Headers& trailers = Headers());
+	//! Returns TRUE if the last chunk has been sent
+	inline bool isClosed() const
+	{
+		return _closed;
+	}
+	//! Returns amount of the chunks, which have been sent
+	inline size_t chunksAmount() const
+	{
+		return _chunksAmount;
+	}
+protected:
+	virtual int_type overflow(int_type ch);
+	virtual std::streamsize xsputn(const char_type * s, std::streamsize n);
+	virtual int sync();
+private:
+	enum PrivateConstants {
+		// "\r\n<hex size>\r\n" of the next chunk
+		EnvelopeSlotSize = MaxHexLength + 4
+	};
+
+	ChunkedStreambuf();
+	ChunkedStreambuf(const ChunkedStreambuf&);
+	ChunkedStreambuf& operator=(const ChunkedStreambuf&);
+
+	bool sendBuffered();
+	bool sendChunk(const char * data, size_t len);
+	inline void resetPutArea()
+	{
+		setp(_buffer + EnvelopeSlotSize, _buffer + EnvelopeSlotSize + _chunkSize);
+	}
+
+	MessageComposer& _composer;
+	const Headers& _headers;
+	std::ostream& _target;
+	size_t _chunkSize;
+	char * _buffer;
+	size_t _chunksAmount;
+	bool _closed;
+};
+
+//! Output stream, which composes written data into chunked-encoded HTTP-message
+/*!
+ * \sa ChunkedStreambuf
+ */
+class ChunkedOStream : public std::ostream
+{
+public:
+	//! Constructs output stream
+	/*!
+	 * \param composer Composer of the HTTP-message
+	 * \param headers Headers of the HTTP-message
+	 * \param target Output stream to compose HTTP-message into
+	 * \param chunkSize Maximum size of the coalesced chunk
+	 */
+	ChunkedOStream(MessageComposer& composer, const Headers& headers, std::ostream& target,
+			size_t chunkSize = ChunkedStreambuf::DefaultChunkSize);
+
+	//! Sends the buffered data and the last chunk (sets badbit on failure)
+	/*!
+	 * \param trailers Trailer headers to send in the last chunk
+	 */
+	void close(const Headers& trailers = Headers());
+	//! Returns the stream buffer
+	inline ChunkedStreambuf * rdbuf()
+	{
+		return &_streambuf;
+	}
+private:
+	ChunkedStreambuf _streambuf;
+};
+
+} // namespace httpxx
+
+#endif
@@ -2,7 +2,9 @@
 #define HTTPXX_COMMON_H
 
 #include <string>
+#include <cstring>
 #include <functional>
+#include <iosfwd>
 
 namespace httpxx
 {
@@ -19,6 +21,73 @@ struct CaseInsensitiveComparator : public std::binary_function<std::string, std:
 	bool operator()(const std::string &lhs, const std::string &rhs) const;
 };
 
+//! Non-owning reference to the character string
+/*!
+ * \note String view does not manage the memory it points to, so the referenced
+ *       characters should outlive it.
+ */
+class StringView
+{
+public:
+	//! Constructs an empty string view
+	StringView() :
+		_data(0),
+		_size(0U)
+	{}
+	//! Constructs a string view
+	/*!
+	 * \param data Pointer to the first character
+	 * \param size Amount of characters
+	 */
+	StringView(const char * data, size_t size) :
+		_data(data),
+		_size(size)
+	{}
+	//! Constructs a string view of the null-terminated string
+	/*!
+	 * \param str Null-terminated string to refer to
+	 */
+	StringView(const char * str) :
+		_data(str),
+		_size(strlen(str))
+	{}
+	//! Constructs a string view of the string
+	/*!
+	 * \param str String to refer to
+	 */
+	StringView(const std::string& str) :
+		_data(str.data()),
+		_size(str.size())
+	{}
+
+	//! Returns a pointer to the first character
+	inline const char * data() const
+	{
+		return _data;
+	}
+	//! Returns an amount of characters
+	inline size_t size() const
+	{
+		return _size;
+	}
+	//! Returns TRUE if the string view is empty
+	inline bool empty() const
+	{
+		return _size <= 0U;
+	}
+	//! Returns a copy of the referenced characters
+	inline std::string str() const
+	{
+		return empty() ? std::string() : std::string(_data, _size);
+	}
+private:
+	const char * _data;
+	size_t _size;
+};
+
+//! Writes referenced characters to the output stream
+std::ostream& operator<<(std::ostream& os, const StringView& sv);
+
 } // namespace httpxx
 
 #endif
@@ -0,0 +1,108 @@
+#ifndef HTTPXX_FILE_PACKET_H
+#define HTTPXX_FILE_PACKET_H
+
+#include <sys/types.h>
+#include <cstddef>
+#include <vector>
+
+namespace httpxx
+{
+
+//! HTTP-packet, which payload is taken from the files
+/*!
+ * Packet is a sequence of memory parts, which are copied into the packet
+ * (envelopes, chunk framing), and file ranges, which are referenced by the
+ * file descriptor, offset and length. send() transmits file ranges by
+ * sendfile() on Linux, so the file data does not enter the user space.
+ *
+ * \code{.cpp}
+ * ...
+ *
+ * httpxx::FilePacket packet;
+ * composer.composeFileMessage(packet, headers, fileFd, 0, fileSize);
+ * while (!packet.empty()) {
+ *     if (packet.send(sock) < 0 && errno != EAGAIN) {
+ *         ...
+ *     }
+ *     ...
+ * }
+ *
+ * ...
+ * \endcode
+ *
+ * \note File descriptors are not owned by the packet, they should stay open
+ *       until the packet has been sent.
+ */
+class FilePacket
+{
+public:
+	//! Constructs an empty packet
+	FilePacket();
+	~FilePacket();
+
+	//! Returns amount of bytes to send
+	inline size_t size() const
+	{
+		return _size;
+	}
+	//! Returns TRUE if there is nothing to send
+	inline bool empty() const
+	{
+		return _size <= 0U;
+	}
+	//! Appends a copy of the data
+	/*!
+	 * \param buf Data to copy
+	 * \param len Data length
+	 */
+	void append(const void * buf, size_t len);
+	//! Reserves memory part to compose the data into
+	/*!
+	 * \param len Length of the memory part
+	 * \return Pointer to the memory part, which is valid until the packet is modified
+	 */
+	char * reserve(size_t len);
+	//! Appends file range
+	/*!
+	 * \param fd File descriptor
+	 * \param offset Offset of the range in the file
+	 * \param len Length of the range
+	 */
+	void appendFile(int fd, off_t offset, size_t len);
+	//! Sends the packet to the file descriptor (socket, pipe, file)
+	/*!
+	 * Sends as much as possible and removes sent bytes from the packet, so
+	 * non-blocking descriptor is supported: call send() again when it is writable.
+	 * \param fd File descriptor to send the packet to
+	 * \return Amount of bytes sent or -1 on error if nothing has been sent (errno is
+	 *         set, EAGAIN/EWOULDBLOCK if the descriptor is not writable)
+	 */
+	ssize_t send(int fd);
+	//! Removes all the parts keeping the storage to be reused
+	void clear();
+private:
+	// Memory part (fd < 0) refers to the offset of the buffer, file part to the file offset
+	struct Part
+	{
+		int fd;
+		off_t offset;
+		size_t length;
+	};
+	typedef std::vector<Part> Parts;
+
+	FilePacket(const FilePacket&);
+	FilePacket& operator=(const FilePacket&);
+
+	void consume(size_t len);
+
+	char * _buffer;
+	size_t _bufferUsed;
+	size_t _bufferCapacity;
+	Parts _parts;
+	size_t _first;
+	size_t _size;
+};
+
+} // namespace httpxx
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef HTTPXX_HEADER_IDS_H
+#define HTTPXX_HEADER_IDS_H
+
+#include <string>
+#include <cstddef>
+
+namespace httpxx
+{
+
+//! Well-known HTTP-header identifiers
+enum HeaderId {
+	UnknownHeaderId,				//!< Header is not a well-known one
+	AcceptHeaderId,					//!< "Accept" header
+	AcceptCharsetHeaderId,				//!< "Accept-Charset" header
+	AcceptEncodingHeaderId,				//!< "Accept-Encoding" header
+	AcceptLanguageHeaderId,				//!< "Accept-Language" header
+	AcceptRangesHeaderId,				//!< "Accept-Ranges" header
+	AccessControlAllowOriginHeaderId,		//!< "Access-Control-Allow-Origin" header
+	AgeHeaderId,					//!< "Age" header
+	AllowHeaderId,					//!< "Allow" header
+	AuthorizationHeaderId,				//!< "Authorization" header
+	CacheControlHeaderId,				//!< "Cache-Control" header
+	ConnectionHeaderId,				//!< "Connection" header
+	ContentDispositionHeaderId,			//!< "Content-Disposition" header
+	ContentEncodingHeaderId,			//!< "Content-Encoding" header
+	ContentLanguageHeaderId,			//!< "Content-Language" header
+	ContentLengthHeaderId,				//!< "Content-Length" header
+	ContentLocationHeaderId,			//!< "Content-Location" header
+	ContentRangeHeaderId,				//!< "Content-Range" header
+	ContentTypeHeaderId,				//!< "Content-Type" header
+	CookieHeaderId,					//!< "Cookie" header
+	DateHeaderId,					//!< "Date" header
+	EtagHeaderId,					//!< "ETag" header
+	ExpectHeaderId,					//!< "Expect" header
+	ExpiresHeaderId,				//!< "Expires" header
+	FromHeaderId,					//!< "From" header
+	HostHeaderId,					//!< "Host" header
+	IfMatchHeaderId,				//!< "If-Match" header
+	IfModifiedSinceHeaderId,			//!< "If-Modified-Since" header
+	IfNoneMatchHeaderId,				//!< "If-None-Match" header
+	IfRangeHeaderId,				//!< "If-Range" header
+	IfUnmodifiedSinceHeaderId,			//!< "If-Unmodified-Since" header
+	KeepAliveHeaderId,				//!< "Keep-Alive" header
+	LastModifiedHeaderId,				//!< "Last-Modified" header
+	LocationHeaderId,				//!< "Location" header
+	MaxForwardsHeaderId,				//!< "Max-Forwards" header
+	OriginHeaderId,					//!< "Origin" header
+	PragmaHeaderId,					//!< "Pragma" header
+	ProxyAuthenticateHeaderId,			//!< "Proxy-Authenticate" header
+	ProxyAuthorizationHeaderId,			//!< "Proxy-Authorization" header
+	ProxyConnectionHeaderId,			//!< "Proxy-Connection" header
+	RangeHeaderId,					//!< "Range" header
+	RefererHeaderId,				//!< "Referer" header
+	RetryAfterHeaderId,				//!< "Retry-After" header
+	ServerHeaderId,					//!< "Server" header
+	SetCookieHeaderId,				//!< "Set-Cookie" header
+	TeHeaderId,					//!< "TE" header
+	TrailerHeaderId,				//!< "Trailer" header
+	TransferEncodingHeaderId,			//!< "Transfer-Encoding" header
+	UpgradeHeaderId,				//!< "Upgrade" header
+	UserAgentHeaderId,				//!< "User-Agent" header
+	VaryHeaderId,					//!< "Vary" header
+	ViaHeaderId,					//!< "Via" header
+	WarningHeaderId,				//!< "Warning" header
+	WwwAuthenticateHeaderId,			//!< "WWW-Authenticate" header
+	XForwardedForHeaderId,				//!< "X-Forwarded-For" header
+	XForwardedProtoHeaderId,			//!< "X-Forwarded-Proto" header
+	XRealIpHeaderId,				//!< "X-Real-IP" header
+	HeaderIdsAmount					//!< Amount of header identifiers
+};
+
+//! Maximum length of the well-known HTTP-header name
+const size_t MaxKnownHeaderNameLength = 27U;
+
+//! Returns an identifier of the HTTP-header
+/*!
+ * Lookup is case-insensitive and takes constant time, since it is done
+ * using a perfect hash table of the well-known header names.
+ * \param name Pointer to the header name
+ * \param len Length of the header name
+ * \return Header identifier or UnknownHeaderId if header is not a well-known one
+ */
+HeaderId headerId(const char * name, size_t len);
+
+//! Returns an identifier of the HTTP-header
+/*!
+ * \param name Header name
+ * \return Header identifier or UnknownHeaderId if header is not a well-known one
+ */
+inline HeaderId headerId(const std::string& name)
+{
+	return headerId(name.data(), name.size());
+}
+
+//! Returns a canonical name of the well-known HTTP-header
+/*!
+ * \param id Header identifier
+ * \return Header name or empty string for UnknownHeaderId
+ */
+const char * headerName(HeaderId id);
+
+} // namespace httpxx
+
+#endif
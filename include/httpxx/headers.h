@@ -2,56 +2,173 @@
 #define HTTPXX_HEADERS_H
 
 #include <httpxx/common.h>
-#include <map>
+#include <httpxx/header_ids.h>
+#include <string>
+#include <utility>
 #include <ostream>
 
 namespace httpxx
 {
 
 //! Container for HTTP-headers
-class Headers : public std::multimap<std::string, std::string, CaseInsensitiveComparator>
+/*!
+ * Flat container, which keeps headers in the order of insertion. Header
+ * names and values are copied to the contiguous byte arena of the container,
+ * first InlineHeadersAmount headers and InlineArenaSize bytes of them are
+ * stored inside of the container itself, so typical HTTP-message headers
+ * take no heap allocations.
+ *
+ * Header names are case-insensitive. Well-known headers (see HeaderId) are
+ * indexed, so they could be looked up by identifier in constant time.
+ *
+ * \note Iterators and string views of the headers are invalidated by any
+ *       modification of the container.
+ */
+class Headers
 {
 public:
+	//! Header: { name view => value view }
+	typedef std::pair<StringView, StringView> value_type;
+	//! Constant iterator
+	typedef const value_type * const_iterator;
+	//! Iterator (headers are modified through the container only)
+	typedef const_iterator iterator;
+	//! Size type
+	typedef size_t size_type;
+	//! Class constants
+	enum Constants {
+		InlineHeadersAmount = 16,		//!< Amount of headers, which are stored inline
+		InlineArenaSize = 1024			//!< Size of header names and values, which are stored inline
+	};
+
+	//! Constructs empty headers
+	Headers();
+	//! Constructs a copy of headers
+	Headers(const Headers& other);
+	~Headers();
+	//! Assigns headers
+	Headers& operator=(const Headers& other);
+
+	//! Returns an iterator to the first header
+	inline const_iterator begin() const
+	{
+		return _headers;
+	}
+	//! Returns an iterator next to the last header
+	inline const_iterator end() const
+	{
+		return _headers + _size;
+	}
+	//! Returns headers amount
+	inline size_type size() const
+	{
+		return _size;
+	}
+	//! Returns TRUE if there are no headers
+	inline bool empty() const
+	{
+		return _size <= 0U;
+	}
+	//! Appends header
+	/*!
+	 * \param header Header to copy into the container
+	 * \return Iterator to the inserted header
+	 */
+	inline iterator insert(const value_type& header)
+	{
+		return insert(end(), header);
+	}
+	//! Inserts header before the position
+	/*!
+	 * \param position Iterator to the header to insert before
+	 * \param header Header to copy into the container
+	 * \return Iterator to the inserted header
+	 */
+	iterator insert(iterator position, const value_type& header);
+	//! Appends headers range
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first) {
+			insert(end(), value_type(first->first, first->second));
+		}
+	}
+	//! Erases header
+	void erase(iterator position);
+	//! Erases all headers with the name
+	size_type erase(const StringView& name);
+	//! Erases all well-known headers with the identifier
+	size_type erase(HeaderId id);
+	//! Erases headers range
+	void erase(iterator first, iterator last);
+	//! Removes all headers
+	void clear();
+	//! Swaps headers
+	void swap(Headers& other);
+	//! Takes the headers of the other container, which is left empty
+	/*!
+	 * Heap storage of the other container is taken over instead of being copied,
+	 * the other container gets the former storage of this one to be reused.
+	 * \param other Headers to take
+	 */
+	void take(Headers& other);
+
+	//! Returns an iterator to the first well-known header with the identifier or end() if none
+	inline const_iterator find(HeaderId id) const
+	{
+		return _index[id] < _size ? _headers + _index[id] : end();
+	}
+	//! Returns an iterator to the first header with the name or end() if none
+	const_iterator find(const StringView& name) const;
+	//! Inspects headers for well-known header
+	/*!
+	 * \param id Header identifier
+	 * \return TRUE if header exists in headers
+	 */
+	inline bool have(HeaderId id) const
+	{
+		return _index[id] < _size;
+	}
+	//! Inspects headers for well-known 'header' => 'value' pair
+	/*!
+	 * \param id Header identifier
+	 * \param value Value to inspect against
+	 * \return TRUE if header contains 'header' => 'value' pair
+	 */
+	bool have(HeaderId id, const StringView& value) const;
+	//! Returns first well-known header value
+	inline std::string value(HeaderId id) const
+	{
+		return _index[id] < _size ? _headers[_index[id]].second.str() : std::string();
+	}
 	//! Inspects headers for header
 	/*!
-	 * \param header Header to inspect for existence
+	 * \param name Header to inspect for existence
 	 * \return TRUE if header exists in headers
 	 */
-	inline bool have(const std::string& header) const
+	inline bool have(const StringView& name) const
 	{
-		std::pair<const_iterator, const_iterator> range = equal_range(header);
-		return range.first != range.second;
+		return find(name) != end();
 	}
-
 	//! Inspects headers for 'header' => 'value' pair
 	/*!
 	 * \param name Header to inspect for value
 	 * \param value Value to inspect against
 	 * \return TRUE if header contains 'header' => 'value' pair
 	 */
-	bool have(const std::string& name, const std::string& value) const
-	{
-		std::pair<const_iterator, const_iterator> range = equal_range(name);
-		for (const_iterator i = range.first; i != range.second; ++i) {
-			if (i->second == value) {
-				return true;
-			}
-		}
-		return false;
-	}
-
+	bool have(const StringView& name, const StringView& value) const;
 	//! Returns first header value
-	inline std::string value(const std::string& header) const
+	inline std::string value(const StringView& name) const
 	{
-		std::pair<const_iterator, const_iterator> range = equal_range(header);
-		return range.first == range.second ? std::string() : range.first->second;
+		const_iterator i = find(name);
+		return i != end() ? i->second.str() : std::string();
 	}
 	//! Composes headers into output stream
 	/*!
 	 * \param target Output stream to compose headers into
 	 * \note Method does not do any preprocessing to header
 	 *       names and values - they should conform RFC.
-	 *       If you want header value to be multiline, insert 
+	 *       If you want header value to be multiline, insert
 	 *       correct LWS(s) manually.
 	 */
 	inline void compose(std::ostream& target) const
@@ -65,9 +182,9 @@ public:
 	 * \param name Header name
 	 * \param value Header value
 	 */
-	inline void add(const std::string& name, const std::string& value)
+	inline void add(const StringView& name, const StringView& value)
 	{
-		insert(value_type(name, value));
+		insert(end(), value_type(name, value));
 	}
 	//! Returns size of composed headers
 	/*!
@@ -77,10 +194,25 @@ public:
 	{
 		size_t result = 0U;
 		for (const_iterator i = begin(); i != end(); ++i) {
-			result += (i->first.length() + i->second.length() + 4U);
+			result += (i->first.size() + i->second.size() + 4U);
 		}
 		return result;
 	}
+private:
+	void copyFrom(const Headers& other);
+	void reserveHeaders(size_type amount);
+	char * allocate(size_t len, value_type& header);
+	void rebuildIndex();
+
+	value_type * _headers;
+	size_type _size;
+	size_type _capacity;
+	char * _arena;
+	size_t _arenaUsed;
+	size_t _arenaCapacity;
+	size_type _index[HeaderIdsAmount];
+	value_type _inlineHeaders[InlineHeadersAmount];
+	char _inlineArena[InlineArenaSize];
 };
 
 } // namespace httpxx
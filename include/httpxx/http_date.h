@@ -0,0 +1,45 @@
+#ifndef HTTPXX_HTTP_DATE_H
+#define HTTPXX_HTTP_DATE_H
+
+#include <cstddef>
+#include <ctime>
+
+namespace httpxx
+{
+
+//! Length of the HTTP-date in IMF-fixdate format ("Sun, 06 Nov 1994 08:49:37 GMT")
+const size_t HttpDateLength = 29U;
+
+//! Formats HTTP-date in IMF-fixdate format (see RFC 7231, section 7.1.1.1)
+/*!
+ * Date is computed arithmetically, neither gmtime() nor strftime() is called.
+ * \param time Time to format
+ * \param buf Buffer to format into, which is at least HttpDateLength bytes long (no terminating NUL is written)
+ * \return Formatted length (HttpDateLength)
+ */
+size_t formatHttpDate(time_t time, char * buf);
+
+//! Parses HTTP-date
+/*!
+ * IMF-fixdate ("Sun, 06 Nov 1994 08:49:37 GMT") and both obsolete formats:
+ * RFC 850 ("Sunday, 06-Nov-94 08:49:37 GMT") and asctime() ("Sun Nov  6 08:49:37 1994")
+ * are accepted. Two-digit year of RFC 850 is treated as 1970..2069.
+ * \param buf Buffer to parse
+ * \param len Buffer length
+ * \param result Parsed time [out]
+ * \return TRUE if the buffer contains a valid HTTP-date
+ */
+bool parseHttpDate(const char * buf, size_t len, time_t& result);
+
+//! Returns current HTTP-date in IMF-fixdate format
+/*!
+ * Date is cached per thread and formatted at most once a second, so the call
+ * is nearly free on the hot path.
+ * \return Pointer to HttpDateLength characters (NUL-terminated), which is valid
+ *         until the next call in the same thread
+ */
+const char * currentHttpDate();
+
+} // namespace httpxx
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef HTTPXX_MEMORY_STREAMBUF_H
+#define HTTPXX_MEMORY_STREAMBUF_H
+
+#include <httpxx/arena.h>
+#include <httpxx/scatter_packet.h>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace httpxx
+{
+
+//! Stream buffer, which writes into the memory buffer
+/*!
+ * Data is written into the fixed buffer, which is provided by the caller (e.g.
+ * an I/O-buffer or a stack array). When the buffer is full, the data is continued
+ * in the chained segments, which are taken from the arena of the stream buffer,
+ * so the stream-based composition APIs (MessageComposer::composeEnvelope(),
+ * Headers::compose(), Uri::compose(), etc.) take no heap allocations while
+ * the data fits the buffer, and the arena blocks are reused after clear().
+ *
+ * Composed data is sent by writev() from packet() with no final copy:
+ *
+ * \code{.cpp}
+ * ...
+ *
+ * char buffer[1024];
+ * httpxx::MemoryOStream envelope(buffer, sizeof(buffer));
+ * composer.composeEnvelope(envelope, headers, payloadLen);
+ * httpxx::ScatterPacket& packet = envelope.rdbuf()->packet();
+ * packet.append(payload, payloadLen);
+ * writev(sock, packet.segments(), packet.segmentsAmount());
+ *
+ * ...
+ * \endcode
+ */
+class MemoryStreambuf : public std::streambuf
+{
+public:
+	//! Class constants
+	enum Constants {
+		DefaultSegmentSize = 4096			//!< Default size of the overflow segment
+	};
+
+	//! Constructs stream buffer, which writes into the overflow segments only
+	/*!
+	 * \param segmentSize Size of the overflow segment, larger segments are taken for larger writes
+	 */
+	explicit MemoryStreambuf(size_t segmentSize = DefaultSegmentSize);
+	//! Constructs stream buffer, which writes into the fixed buffer first
+	/*!
+	 * \param buffer Buffer to write into (should outlive the stream buffer)
+	 * \param len Length of the buffer
+	 * \param segmentSize Size of the overflow segment, larger segments are taken for larger writes
+	 */
+	MemoryStreambuf(void * buffer, size_t len, size_t segmentSize = DefaultSegmentSize);
+
+	//! Returns amount of bytes written
+	inline size_t size() const
+	{
+		return _packet.size() + static_cast<size_t>(pptr() - pbase());
+	}
+	//! Returns TRUE if the fixed buffer is full and the data is continued in the overflow segments
+	inline bool isOverflowed() const
+	{
+		return _inArena;
+	}
+	//! Returns the fixed buffer
+	inline const char * data() const
+	{
+		return _buffer;
+	}
+	//! Returns the packet, which references written data
+	/*!
+	 * Writing could be continued after the call, the packet is updated by the next call.
+	 */
+	ScatterPacket& packet();
+	//! Copies written data into the buffer
+	/*!
+	 * \param buf Buffer to copy into
+	 * \param len Length of the buffer
+	 * \return Amount of bytes copied
+	 */
+	size_t copy(void * buf, size_t len) const;
+	//! Returns a copy of written data
+	std::string str() const;
+	//! Removes written data keeping the overflow segments to be reused
+	void clear();
+protected:
+	virtual int_type overflow(int_type ch);
+	virtual std::streamsize xsputn(const char_type * s, std::streamsize n);
+	virtual pos_type seekoff(off_type off, std::ios_base::seekdir way, std::ios_base::openmode which);
+private:
+	MemoryStreambuf(const MemoryStreambuf&);
+	MemoryStreambuf& operator=(const MemoryStreambuf&);
+
+	void flushPutArea();
+	void nextSegment(size_t len);
+
+	char * _buffer;
+	size_t _bufferLen;
+	Arena _arena;
+	ScatterPacket _packet;
+	bool _inArena;
+};
+
+//! Output stream, which writes into the memory buffer
+/*!
+ * \sa MemoryStreambuf
+ */
+class MemoryOStream : public std::ostream
+{
+public:
+	//! Constructs output stream, which writes into the overflow segments only
+	/*!
+	 * \param segmentSize Size of the overflow segment
+	 */
+	explicit MemoryOStream(size_t segmentSize = MemoryStreambuf::DefaultSegmentSize);
+	//! Constructs output stream, which writes into the fixed buffer first
+	/*!
+	 * \param buffer Buffer to write into (should outlive the stream)
+	 * \param len Length of the buffer
+	 * \param segmentSize Size of the overflow segment
+	 */
+	MemoryOStream(void * buffer, size_t len, size_t segmentSize = MemoryStreambuf::DefaultSegmentSize);
+
+	//! Returns the stream buffer
+	inline MemoryStreambuf * rdbuf()
+	{
+		return &_streambuf;
+	}
+	//! Returns a copy of written data
+	inline std::string str() const
+	{
+		return _streambuf.str();
+	}
+private:
+	MemoryStreambuf _streambuf;
+};
+
+} // namespace httpxx
+
+#endif
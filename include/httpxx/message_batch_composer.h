@@ -0,0 +1,144 @@
+#ifndef HTTPXX_MESSAGE_BATCH_COMPOSER_H
+#define HTTPXX_MESSAGE_BATCH_COMPOSER_H
+
+#include <vector>
+#include <httpxx/headers.h>
+#include <httpxx/message_composer.h>
+#include <httpxx/response_template.h>
+#include <httpxx/scatter_packet.h>
+
+namespace httpxx
+{
+
+//! Pipelined HTTP-messages batch composer
+/*!
+ * Collects several HTTP-messages (e.g. responses to the pipelined requests)
+ * to send them by a single I/O call. Envelopes and small payloads are copied
+ * into the contiguous output buffer of the batch, which is kept between the
+ * batches, large payloads are referenced. If nothing is referenced, the batch
+ * could be sent as a single buffer (see isContiguous() and data()), otherwise
+ * as a scatter-gather packet (see packet()).
+ *
+ * Example of use:
+ * \code{.cpp}
+ * ...
+ *
+ * httpxx::MessageBatchComposer batch;
+ * for (size_t i = 0U; i < parser.messages().size(); ++i) {
+ *     ...
+ *     batch.add(okTemplate, body.data(), body.size());
+ * }
+ * // Once per event loop iteration
+ * httpxx::ScatterPacket& packet = batch.packet();
+ * ssize_t sent = writev(sock, packet.segments(), packet.segmentsAmount());
+ * ...
+ * batch.clear();
+ *
+ * ...
+ * \endcode
+ *
+ * \note Referenced payloads should outlive the sending of the batch.
+ */
+class MessageBatchComposer
+{
+public:
+	//! Class constants
+	enum Constants {
+		DefaultCopyThreshold = 1024,		//!< Default maximum size of the payload, which is copied into the batch
+		InitialBufferSize = 4096		//!< Initial size of the output buffer
+	};
+
+	//! Constructs an empty batch
+	/*!
+	 * \param copyThreshold Maximum size of the payload, which is copied into the output buffer
+	 */
+	explicit MessageBatchComposer(size_t copyThreshold = DefaultCopyThreshold);
+	~MessageBatchComposer();
+
+	//! Appends HTTP-message for identity-encoded transmission
+	/*!
+	 * \param composer Composer of the message envelope
+	 * \param headers Headers of the message
+	 * \param payload Payload of the message
+	 * \param payloadLen Payload length
+	 */
+	void add(MessageComposer& composer, const Headers& headers, const void * payload = 0, size_t payloadLen = 0U);
+	//! Appends HTTP-response, which envelope is composed by the template
+	/*!
+	 * \param responseTemplate Template of the response envelope
+	 * \param payload Payload of the response
+	 * \param payloadLen Payload length
+	 * \param date "Date" header value (see ResponseTemplate::composeEnvelope())
+	 */
+	void add(const ResponseTemplate& responseTemplate, const void * payload = 0, size_t payloadLen = 0U,
+			const char * date = 0);
+	//! Appends raw data to the batch
+	/*!
+	 * \param buf Data to append
+	 * \param len Data length (data longer than copy threshold is referenced, not copied)
+	 */
+	void append(const void * buf, size_t len);
+
+	//! Returns amount of messages in the batch
+	inline size_t messagesAmount() const
+	{
+		return _messagesAmount;
+	}
+	//! Returns amount of bytes in the batch
+	inline size_t size() const
+	{
+		return _size;
+	}
+	//! Returns TRUE if there is nothing in the batch
+	inline bool empty() const
+	{
+		return _size <= 0U;
+	}
+	//! Returns TRUE if the batch contains copied data only, so it could be sent as a single buffer
+	inline bool isContiguous() const
+	{
+		return _referencesAmount <= 0U;
+	}
+	//! Returns contiguous data of the batch (valid if isContiguous() returns TRUE)
+	inline const char * data() const
+	{
+		return _buffer;
+	}
+	//! Returns scatter-gather packet of the batch
+	/*!
+	 * Packet is valid until the batch is modified, use ScatterPacket::consume() to handle
+	 * partial sending.
+	 */
+	ScatterPacket& packet();
+	//! Removes all the messages keeping the storage to be reused
+	void clear();
+private:
+	// Part of the batch: referenced data or copied one at the offset of the output buffer
+	struct Part
+	{
+		const char * data;
+		size_t offset;
+		size_t length;
+	};
+	typedef std::vector<Part> Parts;
+
+	MessageBatchComposer(const MessageBatchComposer&);
+	MessageBatchComposer& operator=(const MessageBatchComposer&);
+
+	char * reserve(size_t len);
+	void addPayload(const void * payload, size_t payloadLen);
+
+	size_t _copyThreshold;
+	char * _buffer;
+	size_t _bufferUsed;
+	size_t _bufferCapacity;
+	Parts _parts;
+	size_t _referencesAmount;
+	size_t _messagesAmount;
+	size_t _size;
+	ScatterPacket _packet;
+};
+
+} // namespace httpxx
+
+#endif
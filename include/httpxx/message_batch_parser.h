@@ -0,0 +1,141 @@
+#ifndef HTTPXX_MESSAGE_BATCH_PARSER_H
+#define HTTPXX_MESSAGE_BATCH_PARSER_H
+
+#include <vector>
+#include <httpxx/common.h>
+#include <httpxx/basic_message_parser.h>
+
+namespace httpxx
+{
+
+//! Pipelined HTTP-messages batch parser
+/*!
+ * Parses all complete HTTP-messages in the buffer in one call and describes
+ * each of them by the MessageDescriptor, which refers to the parts of the
+ * message in the buffer, so nothing is copied.
+ *
+ * Batch parser does not keep the state between the calls: if the buffer ends
+ * with an incomplete HTTP-message, it's state and length are reported in the
+ * BatchResult, so the caller could keep the unconsumed tail of the buffer and
+ * pass it again along with the data received next. Use MessageParser to parse
+ * HTTP-messages with large bodies, which are not to be kept in memory.
+ *
+ * Example of use:
+ * \code{.cpp}
+ * ...
+ *
+ * httpxx::MessageBatchParser parser(16U, 1024U, 16U);
+ * httpxx::MessageBatchParser::BatchResult res = parser.parse(buf, bytesReceived);
+ * for (size_t i = 0U; i < parser.messages().size(); ++i) {
+ *     const httpxx::MessageBatchParser::MessageDescriptor& message = parser.messages()[i];
+ *     std::cout << message.firstToken << ' ' << message.secondToken << std::endl;
+ * }
+ * if (res.failed) {
+ *     std::cerr << res.error.msg() << std::endl;
+ * } else {
+ *     memmove(buf, buf + res.bytesConsumed, bytesReceived - res.bytesConsumed);
+ * }
+ *
+ * ...
+ * \endcode
+ */
+class MessageBatchParser : public BasicMessageParser<MessageBatchParser>
+{
+public:
+	//! Parsed HTTP-message descriptor
+	struct MessageDescriptor
+	{
+		//! Constructs an empty descriptor
+		MessageDescriptor() :
+			offset(0U),
+			length(0U),
+			firstToken(),
+			secondToken(),
+			thirdToken(),
+			header(),
+			payloadBegin(0U),
+			payloadEnd(0U)
+		{}
+
+		size_t offset;					//!< Offset of the message in the buffer
+		size_t length;					//!< Length of the message
+		StringView firstToken;				//!< First token of the message
+		StringView secondToken;				//!< Second token of the message
+		StringView thirdToken;				//!< Third token of the message
+		StringView header;				//!< Header section including it's final empty line
+		size_t payloadBegin;				//!< Index of the first body chunk in payload()
+		size_t payloadEnd;				//!< Index next to the last body chunk in payload()
+	};
+	//! Parsed HTTP-message descriptors container
+	typedef std::vector<MessageDescriptor> MessageDescriptors;
+	//! Batch parsing result
+	struct BatchResult
+	{
+		//! Constructs an empty result
+		BatchResult() :
+			bytesConsumed(0U),
+			partialState(ParsingMessage),
+			partialLength(0U),
+			failed(false),
+			error()
+		{}
+
+		size_t bytesConsumed;				//!< Length of the complete messages in the buffer
+		State partialState;				//!< State of the trailing incomplete message (ParsingMessage if none)
+		size_t partialLength;				//!< Length of the trailing incomplete message
+		bool failed;					//!< TRUE if the message, which follows the complete ones, is malformed
+		ParseError error;				//!< Parsing error (position is relative to the malformed message)
+	};
+	//! Constructs parser
+	/*!
+	  \param maxFirstTokenLength Maximum first token length
+	  \param maxSecondTokenLength Maximum second token length
+	  \param maxThirdTokenLength Maximum third token length
+	  \param maxHeaderNameLength Maximum header name length
+	  \param maxHeaderValueLength Maximum header value length
+	  \param maxHeadersAmount Maximum headers amount
+	*/
+	MessageBatchParser(size_t maxFirstTokenLength, size_t maxSecondTokenLength, size_t maxThirdTokenLength,
+			size_t maxHeaderNameLength = DefaultMaxHeaderNameLength,
+			size_t maxHeaderValueLength = DefaultMaxHeaderValueLength,
+			size_t maxHeadersAmount = DefaultMaxHeadersAmount);
+
+	//! Parses all complete HTTP-messages in the buffer
+	/*!
+	 * Descriptors and payload of the previous call are discarded. Parsing does not throw
+	 * on malformed message, it stops and reports the error in the result.
+	 * \param buf Pointer to the buffer to parse
+	 * \param bufLen Size of the buffer to parse
+	 * \return Batch parsing result
+	*/
+	BatchResult parse(const void * buf, size_t bufLen);
+	//! Returns descriptors of the complete HTTP-messages parsed by the last call of parse()
+	inline const MessageDescriptors& messages() const
+	{
+		return _messages;
+	}
+	//! Returns body chunks of the complete HTTP-messages parsed by the last call of parse()
+	inline const Payload& payload() const
+	{
+		return _payload;
+	}
+private:
+	friend class BasicMessageParser<MessageBatchParser>;
+
+	MessageBatchParser();
+
+	void onFirstToken(const char * p, size_t len);
+	void onSecondToken(const char * p, size_t len);
+	void onThirdToken(const char * p, size_t len);
+	void onHeadersComplete();
+	void onBodyData(const char * p, size_t len);
+
+	MessageDescriptors _messages;
+	Payload _payload;
+	const char * _buf;
+	MessageDescriptor _message;
+};
+
+} // namespace httpxx
+
+#endif
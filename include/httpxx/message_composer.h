@@ -3,10 +3,14 @@
 
 #include <httpxx/headers.h>
 #include <ostream>
+#include <stdint.h>
 
 namespace httpxx
 {
 
+class ScatterPacket;
+class FilePacket;
+
 //! HTTP-message composer
 /*!
  * Generally speaking, HTTP adds an envelope before payload. This is true either
@@ -57,6 +61,14 @@ namespace httpxx
  *       automatically generated on envelope composition. Such headers, which
  *       are already exist are removed first and regenerated afterwards according
  *       to requested transfer encoding type.
+ *
+ * \note Methods, which compose into the buffer, write the envelope directly
+ *       into it and take no heap allocations (unless the buffer is too small
+ *       and an exception is thrown). Methods, which compose into ScatterPacket,
+ *       reference the headers and the tokens of the composer instead of copying them.
+ *
+ * \note Methods, which compose into FilePacket, describe the payload as a file
+ *       range, which is sent by FilePacket::send() without entering the user space.
  */
 class MessageComposer
 {
@@ -77,6 +89,18 @@ public:
 	//! Resets HTTP-message composer
 	void reset(const std::string& firstToken, const std::string& secondToken,
 			const std::string& thirdToken);
+	//! Enables or disables composition of the "Date" header
+	/*!
+	 * If enabled, envelope is started with the "Date" header, which contains the
+	 * cached current date (see currentHttpDate()), and "Date" headers of the
+	 * message are skipped. Disabled by default.
+	 */
+	void setDateComposed(bool dateComposed);
+	//! Returns TRUE if "Date" header is composed
+	inline bool isDateComposed() const
+	{
+		return _dateComposed;
+	}
 	//! Composes envelope into output stream for identity-encoded transmission
 	/*!
 	 * \param target Output stream to compose envelope into
@@ -93,9 +117,19 @@ public:
 	 * \return Length of the envelope
 	 */
 	size_t composeEnvelope(void * buffer, size_t bufLen, const Headers& headers, size_t payloadLen = 0U);
-	//! Returns size of identity-encoded transmission envelope (TODO)
+	//! Appends envelope segments to scatter-gather packet for identity-encoded transmission
 	/*!
-	 * TODO
+	 * \param target Packet to append envelope segments to (append payload segments afterwards)
+	 * \param headers Reference to headers to use (should outlive the packet)
+	 * \param payloadLen Length of the payload data in HTTP-message
+	 */
+	void composeEnvelope(ScatterPacket& target, const Headers& headers, size_t payloadLen = 0U);
+	//! Returns size of identity-encoded transmission envelope
+	/*!
+	 * Size is computed without composing, it is equal to the length, which
+	 * composeEnvelope() returns for the same arguments.
+	 * \param headers Reference to headers to use
+	 * \param payloadLen Length of the payload data in HTTP-message
 	 */
 	size_t envelopeSize(const Headers& headers, size_t payloadLen = 0U);
 	//! Prepends data with envelope to compose an HTTP-message for identity-encoded transmission
@@ -108,6 +142,16 @@ public:
 	 */
 	Packet prependEnvelope(void * buffer, size_t envelopePartLen, const Headers& headers,
 			size_t payloadLen = 0U);
+	//! Composes chunked-encoded transmission envelope with no first chunk into output stream
+	/*!
+	 * Envelope should be followed by composeNextChunkEnvelope() or composeLastChunk(),
+	 * e.g. to send HTTP-message, which body is empty or not known yet, with the chunked
+	 * encoding. composeFirstChunkEnvelope() is a shortcut for this method followed by
+	 * composeNextChunkEnvelope().
+	 * \param target Output stream to compose envelope into
+	 * \param headers Reference to headers to use
+	 */
+	void composeChunkedEnvelope(std::ostream& target, const Headers& headers);
 	//! Composes first chunk envelope into output stream for chunked-encoded transmission
 	/*!
 	 * \param target Output stream to compose envelope into
@@ -124,9 +168,18 @@ public:
 	 * \return Length of the first HTTP-chunk envelope
 	 */
 	size_t composeFirstChunkEnvelope(void * buffer, size_t bufLen, const Headers& headers, size_t payloadLen);
-	//! Returns size of first HTTP-chunk envelope (TODO)
+	//! Appends first chunk envelope segments to scatter-gather packet for chunked-encoded transmission
 	/*!
-	 * TODO
+	 * \param target Packet to append envelope segments to
+	 * \param headers Reference to headers to use (should outlive the packet)
+	 * \param payloadLen Length of the payload data in HTTP-chunk (should be positive)
+	 */
+	void composeFirstChunkEnvelope(ScatterPacket& target, const Headers& headers, size_t payloadLen);
+	//! Returns size of first HTTP-chunk envelope
+	/*!
+	 * \param headers Reference to headers to use
+	 * \param payloadLen Length of the payload data in HTTP-chunk or 0 to get the size, which
+	 *                   fits the envelope of any chunk
 	 */
 	size_t firstChunkEnvelopeSize(const Headers& headers, size_t payloadLen = 0U);
 	//! Prepends data with envelope to compose a first HTTP-chunk to start chunked-encoded transmission
@@ -153,9 +206,16 @@ public:
 	 * \return Length of the next HTTP-chunk envelope
 	 */
 	size_t composeNextChunkEnvelope(void * buffer, size_t bufLen, size_t payloadLen);
-	//! Returns size of next HTTP-chunk envelope (TODO)
+	//! Appends next chunk envelope segments to scatter-gather packet for chunked-encoded transmission
 	/*!
-	 * TODO
+	 * \param target Packet to append envelope segments to
+	 * \param payloadLen Length of the payload data in next HTTP-chunk (should be positive)
+	 */
+	void composeNextChunkEnvelope(ScatterPacket& target, size_t payloadLen);
+	//! Returns size of next HTTP-chunk envelope
+	/*!
+	 * \param payloadLen Length of the payload data in HTTP-chunk or 0 to get the size, which
+	 *                   fits the envelope of any chunk
 	 */
 	size_t nextChunkEnvelopeSize(size_t payloadLen);
 	//! Prepends data with envelope to compose next HTTP-chunk to continue chunked-encoded transmission
@@ -180,15 +240,56 @@ public:
 	 * \return Length of the last HTTP-chunk
 	 */
 	size_t composeLastChunk(char * buffer, size_t bufLen, const Headers& headers = Headers());
-	//! Returns size of last HTTP-chunk (TODO)
+	//! Appends last HTTP-chunk segments to scatter-gather packet to complete chunked-encoded transmission
 	/*!
-	 * TODO
+	 * \param target Packet to append last HTTP-chunk segments to
+	 * \param headers Reference to headers to use (should outlive the packet)
+	 */
+	void composeLastChunk(ScatterPacket& target, const Headers& headers);
+	//! Returns size of last HTTP-chunk
+	/*!
+	 * \param headers Reference to headers to use
 	 */
 	size_t lastChunkSize(const Headers& headers = Headers());
+	//! Appends identity-encoded HTTP-message with the file range payload to file packet
+	/*!
+	 * \param target Packet to append envelope and file range to
+	 * \param headers Reference to headers to use
+	 * \param fd File descriptor of the payload (should stay open until the packet is sent)
+	 * \param offset Offset of the payload in the file
+	 * \param len Length of the payload
+	 */
+	void composeFileMessage(FilePacket& target, const Headers& headers, int fd, uint64_t offset, size_t len);
+	//! Appends first HTTP-chunk with the file range payload to file packet
+	/*!
+	 * \param target Packet to append envelope and file range to
+	 * \param headers Reference to headers to use
+	 * \param fd File descriptor of the payload (should stay open until the packet is sent)
+	 * \param offset Offset of the payload in the file
+	 * \param len Length of the payload (should be positive)
+	 */
+	void composeFirstFileChunk(FilePacket& target, const Headers& headers, int fd, uint64_t offset, size_t len);
+	//! Appends next HTTP-chunk with the file range payload to file packet
+	/*!
+	 * \param target Packet to append envelope and file range to
+	 * \param fd File descriptor of the payload (should stay open until the packet is sent)
+	 * \param offset Offset of the payload in the file
+	 * \param len Length of the payload (should be positive)
+	 */
+	void composeNextFileChunk(FilePacket& target, int fd, uint64_t offset, size_t len);
+	//! Appends last HTTP-chunk to file packet to complete chunked-encoded transmission
+	/*!
+	 * \param target Packet to append last HTTP-chunk to
+	 * \param headers Reference to headers to use
+	 */
+	void composeLastChunk(FilePacket& target, const Headers& headers);
 private:
+	const char * composedDate() const;
+
 	std::string _firstToken;
 	std::string _secondToken;
 	std::string _thirdToken;
+	bool _dateComposed;
 };
 
 } // namespace httpxx
@@ -2,20 +2,11 @@
 #define HTTPXX_MESSAGE_PARSER_H
 
 #include <string>
-#include <map>
 #include <vector>
-#include <functional>
+#include <ostream>
+#include <httpxx/arena.h>
 #include <httpxx/headers.h>
-
-#ifndef HTTPXX_DEFAULT_MAX_HEADER_NAME_LENGTH
-#define HTTPXX_DEFAULT_MAX_HEADER_NAME_LENGTH 256
-#endif
-#ifndef HTTPXX_DEFAULT_MAX_HEADER_VALUE_LENGTH
-#define HTTPXX_DEFAULT_MAX_HEADER_VALUE_LENGTH 4096	// 4 Kb
-#endif
-#ifndef HTTPXX_DEFAULT_MAX_HEADERS_AMOUNT
-#define HTTPXX_DEFAULT_MAX_HEADERS_AMOUNT 256
-#endif
+#include <httpxx/basic_message_parser.h>
 
 namespace httpxx
 {
@@ -61,132 +52,46 @@ namespace httpxx
  * ...
  * \endcode
  *
+ * Parser could also run in <i>view mode</i> (see setViewMode()), where tokens and
+ * headers are not copied to strings but exposed as string views to the parsed
+ * buffers (see firstTokenView(), secondTokenView(), thirdTokenView(), headerViews()).
+ * In this mode buffers, which contain the HTTP-message header, should stay intact
+ * until the message has been handled. Token or header value, which is split between
+ * two buffers (or which is parsed character by character), is assembled in the
+ * arena of the parser (see arena()), so it's view does not depend on the buffers.
+ *
+ * If you do not need the parsed data to be stored, use the BasicMessageParser
+ * directly, which this class is based on.
+ *
+ * Template parameter selects position tracking of the parser: MessageParser
+ * updates line and column on each parsed character, LazyMessageParser tracks
+ * the absolute position only and calculates column on demand (see
+ * BasicMessageParser for details).
+ *
  * \note Parser does not apply strict rules on first three tokens:
  *       first and second ones could consist of CHAR's which are not CTL/SP/HT's,
  *       third one is to be of CHAR's, which are not CTL's (see
  *       <a href="https://www.ietf.org/rfc/rfc2616.txt">RFC-2616</a>).
 */
-class MessageParser
+template <bool LazyPosition>
+class GenericMessageParser : public BasicMessageParser<GenericMessageParser<LazyPosition> >
 {
 public:
-	//! Class constants
-	enum Constants {
-		DefaultMaxHeaderNameLength = HTTPXX_DEFAULT_MAX_HEADER_NAME_LENGTH,
-		DefaultMaxHeaderValueLength = HTTPXX_DEFAULT_MAX_HEADER_VALUE_LENGTH,
-		DefaultMaxHeadersAmount = HTTPXX_DEFAULT_MAX_HEADERS_AMOUNT
-	};
-	//! Parser states
-	enum State {
-		ParsingMessage,					//!< Initial state
-		ParsingLeadingSP,				//!< Parsing leading space
-		ParsingFirstToken,				//!< Parsing first token
-		ParsingFirstTokenSP,				//!< Parsing the delimeter b/w first and second token
-		ParsingSecondToken,				//!< Parsing second token
-		ParsingSecondTokenSP,				//!< Parsing the delimeter b/w second and third token
-		ParsingThirdToken,				//!< Parsing third token
-		ParsingFirstLineLF,				//!< First line LF has been found
-		ParsingHeader,					//!< Parsing the beginning of the message header
-		ParsingHeaderName,				//!< Parsing message header name
-		ParsingHeaderValue,				//!< Parsing message header value
-		ParsingHeaderValueLF,				//!< Message header line LF has been found
-		ParsingHeaderValueLWS,				//!< Parsing message header multiline value LWS
-		ParsingEndOfHeader,				//!< Parsing the end of the message header section
-		ParsingIdentityBody,				//!< Parsing indentity-encoded message body
-		ParsingChunkSize,				//!< Parsing the chunk size of the chunked-encoded message body
-		ParsingChunkSizeLF,				//!< Chunk size line LF of of the chunked-encoded message body has been found
-		ParsingChunkExtension,				//!< Parsing the chunk extension of the of the chunked-encoded message body
-		ParsingChunk,					//!< Parsing the chunk of the chunked-encoded message body
-		ParsingChunkCR,					//!< Chunk's CR has been found
-		ParsingChunkLF,					//!< Chunk's LF has been found
-		ParsingTrailerHeader,				//!< Parsing the beginning of the message trailer header
-		ParsingTrailerHeaderName,			//!< Parsing message trailer header name
-		ParsingTrailerHeaderValue,			//!< Parsing message trailer header value
-		ParsingTrailerHeaderValueLF,			//!< Message trailer header line LF has been found
-		ParsingTrailerHeaderValueLWS,			//!< Parsing message trailer header multiline value LWS
-		ParsingFinalLF,					//!< Parsing final LF of the message
-	};
-	//! Payload chunk { ptr => size }
-	typedef std::pair<const void *, size_t> PayloadChunk;
 	//! Payload chunks container
-	typedef std::vector<PayloadChunk> Payload;
-	//! HTTP-message parser exception class
-	class Exception : public std::exception
+	typedef MessageParserBase::Payload Payload;
+	//! Parsing result
+	typedef MessageParserBase::ParseResult ParseResult;
+	//! Header view: { name view => value view }
+	typedef std::pair<StringView, StringView> HeaderView;
+	//! Header views container
+	typedef std::vector<HeaderView> HeaderViews;
+	//! Parsed HTTP-message envelope: tokens and headers
+	struct Message
 	{
-	public:
-		//! HTTP-message parser error codes
-		enum Code {
-			InvalidFirstToken,
-			FirstTokenIsTooLong,
-			InvalidSecondToken,
-			SecondTokenIsTooLong,
-			InvalidThirdToken,
-			ThirdTokenIsTooLong,
-			InvalidFirstLineLF,
-			TooManyHeaders,
-			EmptyHeaderName,
-			InvalidHeaderName,
-			HeaderNameIsTooLong,
-			HeaderIsMissingColon,
-			InvalidHeaderValue,
-			HeaderValueIsTooLong,
-			InvalidHeaderLF,
-			InvalidContentLength,
-			EmptyChunkSize,
-			InvalidChunkSize,
-			InvalidChunkSizeLF,
-			InvalidChunkDataCR,
-			InvalidChunkDataLF,
-			InvalidFinalLF,
-			InvalidState,
-		};
-		//! Constructs an HTTP-message parser exception
-		/*!
-		  \param ch Character, which caused an error
-		  \param pos Position of the error in the HTTP-message (starts from 0)
-		  \param line Line of the error in the HTTP-message (starts from 1)
-		  \param col Column of the error in the HTTP-message (starts from 1)
-		  \param code Error code
-		*/
-		Exception(char ch, int pos, int line, int col, Code code);
-		virtual ~Exception() throw ()
-		{}
-		//! Returns a character, which caused an error
-		inline char ch() const
-		{
-			return _ch;
-		}
-		//! Returns a position of the error in the HTTP-message
-		inline int pos() const
-		{
-			return _pos;
-		}
-		//! Returns a line of the error in the HTTP-message
-		inline int line() const
-		{
-			return _line;
-		}
-		//! Returns a column of the error in the HTTP-message
-		inline int col() const
-		{
-			return _col;
-		}
-		//! Returns error code
-		inline const Code code() const
-		{
-			return _code;
-		}
-		//! Returns error message
-		const char * msg() const throw ();
-
-		//! Returns full error message
-		virtual const char * what() const throw ();
-	private:
-		const char _ch;
-		const int _pos;
-		const int _line;
-		const int _col;
-		const Code _code;
-		mutable std::string _what;
+		std::string firstToken;				//!< First token
+		std::string secondToken;			//!< Second token
+		std::string thirdToken;				//!< Third token
+		httpxx::Headers headers;			//!< HTTP-message headers
 	};
 	//! Constructs parser
 	/*!
@@ -197,27 +102,12 @@ public:
 	  \param maxHeaderValueLength Maximum header value length
 	  \param maxHeadersAmount Maximum headers amount
 	*/
-	MessageParser(size_t maxFirstTokenLength, size_t maxSecondTokenLength, size_t maxThirdTokenLength,
-			size_t maxHeaderNameLength = DefaultMaxHeaderNameLength,
-			size_t maxHeaderValueLength = DefaultMaxHeaderValueLength,
-			size_t maxHeadersAmount = DefaultMaxHeadersAmount);
-	virtual ~MessageParser();
+	GenericMessageParser(size_t maxFirstTokenLength, size_t maxSecondTokenLength, size_t maxThirdTokenLength,
+			size_t maxHeaderNameLength = MessageParserBase::DefaultMaxHeaderNameLength,
+			size_t maxHeaderValueLength = MessageParserBase::DefaultMaxHeaderValueLength,
+			size_t maxHeadersAmount = MessageParserBase::DefaultMaxHeadersAmount);
+	virtual ~GenericMessageParser();
 
-	//! Returns a current position of the HTTP-message parser (starts from 0)
-	inline size_t pos() const
-	{
-		return _pos;
-	}
-	//! Returns a current line of the HTTP-message parser (starts from 1)
-	inline size_t line() const
-	{
-		return _line;
-	}
-	//! Returns a current column of the HTTP-message parser (starts from 1)
-	inline size_t col() const
-	{
-		return _col;
-	}
 	//! Returns a constant reference to the first token
 	inline const std::string& firstToken() const
 	{
@@ -238,54 +128,68 @@ public:
 	{
 		return _headers;
 	}
-	//! Returns maximum header field name length
-	inline size_t maxHeaderNameLength() const
+	//! Takes the HTTP-message headers out of the parser
+	/*!
+	 * Heap storage of the headers is taken by the target instead of being copied
+	 * (see Headers::take()), so the parsed data could be handed over (e.g. to a worker
+	 * thread) without a deep copy. Former storage of the target is kept by the parser
+	 * for the next message.
+	 * \param target Headers to take the parsed ones into (former contents are discarded)
+	 */
+	void takeHeaders(httpxx::Headers& target);
+	//! Takes the tokens and the headers of the HTTP-message out of the parser
+	/*!
+	 * \param target Message to take the parsed tokens and headers into (former contents are discarded)
+	 * \sa takeHeaders()
+	 */
+	void takeMessage(Message& target);
+	//! Returns TRUE if the parser is in view mode
+	inline bool viewMode() const
 	{
-		return _maxHeaderNameLength;
+		return _viewMode;
 	}
-	//! Sets maximum header field name length
+	//! Sets view mode
 	/*!
-	  \param newValue New maximum header field name length
+	  \param newValue TRUE to expose tokens and headers as views instead of strings
+	  \note Mode should be changed between HTTP-messages.
 	*/
-	inline void setMaxHeaderNameLength(size_t newValue)
+	inline void setViewMode(bool newValue)
 	{
-		_maxHeaderNameLength = newValue;
+		_viewMode = newValue;
 	}
-	//! Returns maximum header field value length
-	inline size_t maxHeaderValueLength() const
+	//! Returns a view of the first token (view mode only)
+	inline const StringView& firstTokenView() const
 	{
-		return _maxHeaderValueLength;
+		return _firstTokenView;
 	}
-	//! Sets maximum header field value length
-	/*!
-	  \param newValue New maximum header field value length
-	*/
-	inline void setMaxHeaderValueLength(size_t newValue)
+	//! Returns a view of the second token (view mode only)
+	inline const StringView& secondTokenView() const
 	{
-		_maxHeaderValueLength = newValue;
+		return _secondTokenView;
 	}
-	//! Returns maximum headers amount
-	inline size_t maxHeadersAmount() const
-	{
-		return _maxHeadersAmount;
-	}
-	//! Sets maximum headers amount
-	/*!
-	  \param newValue New maximum headers amount
-	*/
-	inline void setMaxHeadersAmount(size_t newValue)
+	//! Returns a view of the third token (view mode only)
+	inline const StringView& thirdTokenView() const
 	{
-		_maxHeadersAmount = newValue;
+		return _thirdTokenView;
 	}
-	//! Return the state of the parser
-	inline State state() const
+	//! Returns a constant reference to the HTTP-message header views (view mode only)
+	inline const HeaderViews& headerViews() const
 	{
-		return _state;
+		return _headerViews;
 	}
-	//! Returns TRUE if the whole HTTP-message has been completely parsed
-	inline bool isCompleted() const
+	//! Returns per-message arena of the parser
+	/*!
+	 * Arena is released when the parser is reset, which happens at the beginning
+	 * of each HTTP-message, so the memory allocated for the message handling (e.g.
+	 * ArenaParams) is released at once without touching the heap. Parser assembles
+	 * split tokens and headers of the view mode in this arena too.
+	 * \note Token strings (see firstToken()) are not allocated in the arena: they
+	 *       keep their heap buffers across messages and could be handed over by
+	 *       takeMessage(), so they do not allocate after the first few messages.
+	 */
+	inline Arena& arena()
 	{
-		return _state == ParsingMessage;
+		return _arena;
 	}
 	//! Parses next character
 	/*!
@@ -294,14 +198,12 @@ public:
 	  \return TRUE if complete message has been successfully parsed
 	*/
 	bool parse(char ch, bool * isBodyChar = 0);
-	//! Inspects if next character is expected to be of HTTP-message body
-	inline bool bodyExpected() const
-	{
-		return _state == ParsingIdentityBody || _state == ParsingChunk;
-	}
 	//! Parses buffer for an HTTP-message and composes payload chunks container
 	/*!
-	 * TODO: Implementation
+	 * Body bytes are not copied: each payload chunk points into the supplied buffer,
+	 * so it is valid until the buffer is reused. Payload chunks are appended to the
+	 * container, so it could be used to collect a body of the message, which is
+	 * spread over several buffers.
 	 * \param buf Pointer to the buffer to parse
 	 * \param bufLen Size of the buffer to parse
 	 * \param payload Optional pointer to payload chunks container to fill in [out]
@@ -316,41 +218,76 @@ public:
 	 * \return A pair with complete message flag and parsed bytes amount
 	*/
 	std::pair<bool, size_t> parse(const void * buf, size_t bufLen, std::ostream& os);
+	//! Parses next character without throwing an exception on error
+	/*!
+	  \param ch Next character to parse
+	  \param isBodyChar Optional pointer to flag where TRUE is to be put if parsed character is a part of HTTP-message body
+	  \return Parsing result
+	*/
+	ParseResult tryParse(char ch, bool * isBodyChar = 0);
+	//! Parses buffer for an HTTP-message and composes payload chunks container without throwing an exception on error
+	/*!
+	 * \param buf Pointer to the buffer to parse
+	 * \param bufLen Size of the buffer to parse
+	 * \param payload Optional pointer to payload chunks container to fill in [out]
+	 * \return Parsing result
+	*/
+	ParseResult tryParse(const void * buf, size_t bufLen, Payload * payload = 0);
+	//! Parses buffer for an HTTP-message and stores it's body into the supplied stream without throwing an exception on error
+	/*!
+	 * \param buf Pointer to the buffer to parse
+	 * \param bufLen Size of the buffer to parse
+	 * \param os Output stream where to store HTTP-message body
+	 * \return Parsing result
+	*/
+	ParseResult tryParse(const void * buf, size_t bufLen, std::ostream& os);
 	//! Resets parser
 	virtual void reset();
 private:
-	MessageParser();
+	friend class BasicMessageParser<GenericMessageParser>;
 
-	void appendHeader(char ch);
-	void parseHeader(char ch, bool isTrailer);
-	void parseHeaderName(char ch, bool isTrailer);
-	void parseHeaderValue(char ch, bool isTrailer);
-	void parseHeaderValueLF(char ch, bool isTrailer);
-	void parseHeaderValueLWS(char ch, bool isTrailer);
+	enum PositionTrackingPolicy {
+		LazyPositionTracking = LazyPosition
+	};
+
+	GenericMessageParser();
+
+	void onMessageBegin();
+	void onFirstToken(const char * p, size_t len);
+	void onSecondToken(const char * p, size_t len);
+	void onThirdToken(const char * p, size_t len);
+	void onHeaderName(const char * p, size_t len);
+	void onHeaderValue(const char * p, size_t len);
+	void onHeaderFieldComplete();
+	void onBodyData(const char * p, size_t len);
+
+	void setInput(bool isTransient, Payload * payload, std::ostream * os);
+	void appendView(StringView& view, const char * p, size_t len);
 
-	State _state;
-	size_t _pos;
-	size_t _line;
-	size_t _col;
 	std::string _firstToken;
 	std::string _secondToken;
 	std::string _thirdToken;
 	std::string _headerFieldName;
 	std::string _headerFieldValue;
 	httpxx::Headers _headers;
-	size_t _contentLength;
-	size_t _identityBodyBytesParsed;
-	std::string _chunkSizeStr;
-	size_t _chunkSize;
-	size_t _chunkBytesParsed;
-	size_t _maxFirstTokenLength;
-	size_t _maxSecondTokenLength;
-	size_t _maxThirdTokenLength;
-	size_t _maxHeaderNameLength;
-	size_t _maxHeaderValueLength;
-	size_t _maxHeadersAmount;
+	bool _viewMode;
+	bool _transientInput;
+	Payload * _payload;
+	std::ostream * _payloadStream;
+	StringView _firstTokenView;
+	StringView _secondTokenView;
+	StringView _thirdTokenView;
+	StringView _headerNameView;
+	StringView _headerValueView;
+	HeaderViews _headerViews;
+	Arena _arena;
 };
 
+//! HTTP-message parser, which updates line and column on each parsed character
+typedef GenericMessageParser<false> MessageParser;
+//! HTTP-message parser with lazy position tracking
+typedef GenericMessageParser<true> LazyMessageParser;
+
 } // namespace httpxx
 
 #endif
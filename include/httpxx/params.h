@@ -2,48 +2,126 @@
 #define HTTPXX_PARAMS_H
 
 #include <httpxx/common.h>
+#include <httpxx/arena.h>
+#include <httpxx/uri.h>
 #include <map>
+#include <memory>
+#include <string>
+#include <ostream>
 
 namespace httpxx
 {
 
-class Uri;
+//! Base class of the params
+/*!
+ * Contains definitions, which do not depend on the allocator.
+ */
+class ParamsBase
+{
+protected:
+	//! Decodes percent-encoded characters
+	/*!
+	 * \param buf Buffer to decode
+	 * \param len Buffer length
+	 * \param target Buffer to decode into, which is at least len bytes long (could be equal to buf)
+	 * \return Decoded length
+	 */
+	static size_t decode(const char * buf, size_t len, char * target);
+	//! Composes percent-encoded characters into the stream
+	/*!
+	 * \param target Output stream to compose into
+	 * \param buf Buffer to encode
+	 * \param len Buffer length
+	 * \return Composed size
+	 */
+	static size_t encode(std::ostream& target, const char * buf, size_t len);
+	//! Returns size of percent-encoded characters
+	static size_t encodedSize(const char * buf, size_t len);
+};
+
+//! Types of the params, which use the allocator
+template <class Allocator>
+struct ParamsTraits
+{
+	//! String type
+	typedef std::basic_string<char, std::char_traits<char>, typename Allocator::template rebind<char>::other> String;
+	//! Container type
+	typedef std::multimap<String, String, std::less<String>,
+		typename Allocator::template rebind<std::pair<const String, String> >::other> Container;
+};
 
 //! GET/POST params
-class Params : public std::multimap<std::string, std::string>
+/*!
+ * Names and values are stored in the strings, which use the supplied allocator,
+ * e.g. ArenaParams could take all their memory from the per-message arena of
+ * the parser (see MessageParser::arena()).
+ */
+template <class Allocator = std::allocator<char> >
+class BasicParams : public ParamsBase, public ParamsTraits<Allocator>::Container
 {
 public:
-	Params() :
-		std::multimap<std::string, std::string>()
+	//! Base container type
+	typedef typename ParamsTraits<Allocator>::Container Base;
+	//! String type
+	typedef typename ParamsTraits<Allocator>::String String;
+	typedef typename Base::value_type value_type;
+	typedef typename Base::iterator iterator;
+	typedef typename Base::const_iterator const_iterator;
+
+	//! Constructs empty params
+	/*!
+	 * \param allocator Allocator to use
+	 */
+	explicit BasicParams(const Allocator& allocator = Allocator()) :
+		ParamsBase(),
+		Base(std::less<String>(), allocator)
 	{}
 	//! Constructs params by parsing a supplied string
 	/*!
 	 * \note To extract POST params pass HTTP-message body to this constructor
 	 * \param str String to parse
+	 * \param allocator Allocator to use
 	 */
-	Params(const std::string& str);
+	BasicParams(const std::string& str, const Allocator& allocator = Allocator()) :
+		ParamsBase(),
+		Base(std::less<String>(), allocator)
+	{
+		parse(str.data(), str.size());
+	}
 	//! Constructs params by parsing a supplied buffer
 	/*!
 	 * \note To extract POST params pass HTTP-message body to this constructor
 	 * \param buf Pointer to buffer to parse
 	 * \param len Buffer size
+	 * \param allocator Allocator to use
 	 */
-	Params(const void * buf, size_t len);
+	BasicParams(const void * buf, size_t len, const Allocator& allocator = Allocator()) :
+		ParamsBase(),
+		Base(std::less<String>(), allocator)
+	{
+		parse(static_cast<const char *>(buf), len);
+	}
 	//! Constructs params from URI
 	/*!
 	 * \note Use this constructor for GET params extraction
 	 * \param uri URI to construct params from
+	 * \param allocator Allocator to use
 	 */
-	Params(const Uri& uri);
+	BasicParams(const Uri& uri, const Allocator& allocator = Allocator()) :
+		ParamsBase(),
+		Base(std::less<String>(), allocator)
+	{
+		parse(uri.query().data(), uri.query().size());
+	}
 
 	//! Inspects params for item
 	/*!
 	 * \param name Item name to inspect for existence
 	 * \return TRUE if item exists in params
 	 */
-	inline bool have(const std::string& name) const
+	inline bool have(const StringView& name) const
 	{
-		std::pair<const_iterator, const_iterator> range = equal_range(name);
+		std::pair<const_iterator, const_iterator> range = this->equal_range(key(name));
 		return range.first != range.second;
 	}
 
@@ -53,11 +131,11 @@ public:
 	 * \param value Value to inspect against
 	 * \return TRUE if name contains 'name' => 'value' pair
 	 */
-	bool have(const std::string& name, const std::string& value) const
+	bool have(const StringView& name, const StringView& value) const
 	{
-		std::pair<const_iterator, const_iterator> range = equal_range(name);
+		std::pair<const_iterator, const_iterator> range = this->equal_range(key(name));
 		for (const_iterator i = range.first; i != range.second; ++i) {
-			if (i->second == value) {
+			if (i->second.compare(0, String::npos, value.data(), value.size()) == 0) {
 				return true;
 			}
 		}
@@ -69,10 +147,10 @@ public:
 	 * \param name Item name to return value of
 	 * \return Item value
 	 */
-	inline std::string value(const std::string& name) const
+	inline String value(const StringView& name) const
 	{
-		std::pair<const_iterator, const_iterator> range = equal_range(name);
-		return range.first == range.second ? std::string() : range.first->second;
+		std::pair<const_iterator, const_iterator> range = this->equal_range(key(name));
+		return range.first == range.second ? String(this->get_allocator()) : range.first->second;
 	}
 
 	//! Adds item to param
@@ -80,9 +158,10 @@ public:
 	 * \param name Param name
 	 * \param value Param value
 	 */
-	inline void add(const std::string& name, const std::string& value)
+	inline void add(const StringView& name, const StringView& value)
 	{
-		insert(value_type(name, value));
+		this->insert(value_type(String(name.data(), name.size(), this->get_allocator()),
+					String(value.data(), value.size(), this->get_allocator())));
 	}
 
 	//! Composes params into stream
@@ -90,14 +169,84 @@ public:
 	 * \param target A reference to output stream to compose params into
 	 * \return Composed URI size
 	 */
-	size_t compose(std::ostream& target) const;
+	size_t compose(std::ostream& target) const
+	{
+		size_t composedSize = 0U;
+		for (const_iterator i = this->begin(); i != this->end(); ++i) {
+			if (i->first.empty()) {
+				continue;
+			}
+			if (composedSize > 0U) {
+				target << '&';
+				++composedSize;
+			}
+			composedSize += encode(target, i->first.data(), i->first.size());
+			target << '=';
+			composedSize += 1U + encode(target, i->second.data(), i->second.size());
+		}
+		return composedSize;
+	}
 
 	//! Returns size of composed params
-	size_t composedSize() const;
+	size_t composedSize() const
+	{
+		size_t result = 0U;
+		for (const_iterator i = this->begin(); i != this->end(); ++i) {
+			if (!i->first.empty()) {
+				result += (result > 0U ? 1U : 0U) + encodedSize(i->first.data(), i->first.size()) + 1U +
+					encodedSize(i->second.data(), i->second.size());
+			}
+		}
+		return result;
+	}
 private:
-	void parse(const std::string& str);
+	// Lookup key uses the default allocator, so it does not take memory of the arena
+	static inline String key(const StringView& name)
+	{
+		return String(name.data(), name.size());
+	}
+
+	void parse(const char * str, size_t len)
+	{
+		size_t pos = 0U;
+		while (pos < len) {
+			// Parsing param name
+			size_t nameBegin = pos;
+			while (pos < len && str[pos] != '=' && str[pos] != '&') {
+				++pos;
+			}
+			size_t nameEnd = pos;
+			if (pos < len && str[pos] == '=') {
+				++pos;
+			}
+			// Parsing param value
+			size_t valueBegin = pos;
+			while (pos < len && str[pos] != '&') {
+				++pos;
+			}
+			size_t valueEnd = pos;
+			if (pos < len) {
+				++pos;
+			}
+			// Decoding name/value pair into the strings of the params allocator
+			String name(nameEnd - nameBegin, '\0', this->get_allocator());
+			if (!name.empty()) {
+				name.resize(decode(str + nameBegin, nameEnd - nameBegin, &name[0]));
+			}
+			iterator i = this->insert(value_type(name, String(this->get_allocator())));
+			if (valueEnd > valueBegin) {
+				i->second.resize(valueEnd - valueBegin);
+				i->second.resize(decode(str + valueBegin, valueEnd - valueBegin, &i->second[0]));
+			}
+		}
+	}
 };
 
+//! GET/POST params, which use the heap
+typedef BasicParams<> Params;
+//! GET/POST params, which use an arena
+typedef BasicParams<ArenaAllocator<char> > ArenaParams;
+
 } // namespace httpxx
 
 #endif
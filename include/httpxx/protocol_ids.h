@@ -0,0 +1,77 @@
+#ifndef HTTPXX_PROTOCOL_IDS_H
+#define HTTPXX_PROTOCOL_IDS_H
+
+#include <cstddef>
+
+namespace httpxx
+{
+
+//! Well-known HTTP-method identifiers
+enum Method {
+	UnknownMethod,					//!< Method is not a well-known one
+	GetMethod,					//!< "GET" method
+	HeadMethod,					//!< "HEAD" method
+	PostMethod,					//!< "POST" method
+	PutMethod,					//!< "PUT" method
+	DeleteMethod,					//!< "DELETE" method
+	ConnectMethod,					//!< "CONNECT" method
+	OptionsMethod,					//!< "OPTIONS" method
+	TraceMethod,					//!< "TRACE" method
+	PatchMethod,					//!< "PATCH" method
+	MethodsAmount					//!< Amount of method identifiers
+};
+
+//! Well-known HTTP-version identifiers
+enum ProtocolVersion {
+	UnknownProtocolVersion,				//!< Version is not a well-known one
+	Http10ProtocolVersion,				//!< "HTTP/1.0" version
+	Http11ProtocolVersion,				//!< "HTTP/1.1" version
+	ProtocolVersionsAmount				//!< Amount of version identifiers
+};
+
+//! Maximum length of the HTTP-version token ("HTTP/x.y")
+const size_t MaxProtocolVersionLength = 8U;
+
+//! Returns an identifier of the HTTP-method
+/*!
+ * Method is recognized by a single 4- or 8-byte word comparison per candidate.
+ * Lookup is case-sensitive as HTTP-methods are.
+ * \param name Pointer to the method name
+ * \param len Length of the method name
+ * \return Method identifier or UnknownMethod if method is not a well-known one
+ */
+Method methodId(const char * name, size_t len);
+
+//! Returns a name of the well-known HTTP-method
+/*!
+ * \param method Method identifier
+ * \return Method name or empty string for UnknownMethod
+ */
+const char * methodName(Method method);
+
+//! Returns an identifier of the HTTP-version
+/*!
+ * \param token Pointer to the version token
+ * \param len Length of the version token
+ * \return Version identifier or UnknownProtocolVersion if version is not a well-known one
+ */
+ProtocolVersion protocolVersion(const char * token, size_t len);
+
+//! Returns a token of the well-known HTTP-version
+/*!
+ * \param version Version identifier
+ * \return Version token or empty string for UnknownProtocolVersion
+ */
+const char * protocolVersionToken(ProtocolVersion version);
+
+//! Returns a reason phrase of the well-known HTTP-status code
+/*!
+ * Reason phrases are taken from the table, which is indexed by the status code.
+ * \param statusCode Status code
+ * \return Reason phrase or empty string if status code is not a well-known one
+ */
+const char * reasonPhrase(int statusCode);
+
+} // namespace httpxx
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef HTTPXX_REQUEST_PARSER_H
+#define HTTPXX_REQUEST_PARSER_H
+
+#include <cstring>
+#include <httpxx/common.h>
+#include <httpxx/protocol_ids.h>
+#include <httpxx/typed_message_parser.h>
+
+namespace httpxx
+{
+
+//! HTTP-request parser
+/*!
+ * Parser, which is specialized for HTTP-requests: method and version are exposed
+ * as identifiers and URI is stored in the fixed buffer of the parser, which size
+ * is a template parameter as well as the rest of the limits.
+ *
+ * Example of use:
+ * \code{.cpp}
+ * ...
+ *
+ * httpxx::RequestParser<> parser;
+ * std::pair<bool, size_t> res = parser.parse(buf, bytesReceived);
+ * if (res.first && parser.method() == httpxx::GetMethod) {
+ *     std::cout << "GET " << parser.uri() << std::endl;
+ * }
+ *
+ * ...
+ * \endcode
+ */
+template <size_t MaxMethodLength = 16U, size_t MaxUriLength = 2048U,
+	size_t MaxHeaderNameLength = MessageParserBase::DefaultMaxHeaderNameLength,
+	size_t MaxHeaderValueLength = MessageParserBase::DefaultMaxHeaderValueLength,
+	size_t MaxHeadersAmount = MessageParserBase::DefaultMaxHeadersAmount>
+class RequestParser : public TypedMessageParser<RequestParser<MaxMethodLength, MaxUriLength,
+	MaxHeaderNameLength, MaxHeaderValueLength, MaxHeadersAmount> >
+{
+public:
+	//! Constructs parser
+	RequestParser() :
+		TypedMessageParser<RequestParser>(MaxMethodLength, MaxUriLength, MaxProtocolVersionLength,
+				MaxHeaderNameLength, MaxHeaderValueLength, MaxHeadersAmount),
+		_method(UnknownMethod),
+		_methodName(),
+		_methodLength(0U),
+		_uri(),
+		_uriLength(0U),
+		_version(UnknownProtocolVersion),
+		_versionToken(),
+		_versionLength(0U)
+	{}
+
+	//! Returns HTTP-method identifier (valid after the header section has been parsed)
+	inline Method method() const
+	{
+		return _method;
+	}
+	//! Returns HTTP-method name as it has been received
+	inline StringView methodName() const
+	{
+		return StringView(_methodName, _methodLength);
+	}
+	//! Returns request URI
+	inline StringView uri() const
+	{
+		return StringView(_uri, _uriLength);
+	}
+	//! Returns HTTP-version identifier (valid after the header section has been parsed)
+	inline ProtocolVersion version() const
+	{
+		return _version;
+	}
+	//! Returns HTTP-version token as it has been received
+	inline StringView versionToken() const
+	{
+		return StringView(_versionToken, _versionLength);
+	}
+private:
+	typedef TypedMessageParser<RequestParser> Base;
+	friend class BasicMessageParser<RequestParser>;
+
+	inline void onMessageBegin()
+	{
+		Base::onMessageBegin();
+		_method = UnknownMethod;
+		_methodLength = 0U;
+		_uriLength = 0U;
+		_version = UnknownProtocolVersion;
+		_versionLength = 0U;
+	}
+	// Tokens do not exceed their limits, which are the buffer sizes
+	inline void onFirstToken(const char * p, size_t len)
+	{
+		memcpy(_methodName + _methodLength, p, len);
+		_methodLength += len;
+	}
+	inline void onSecondToken(const char * p, size_t len)
+	{
+		memcpy(_uri + _uriLength, p, len);
+		_uriLength += len;
+	}
+	inline void onThirdToken(const char * p, size_t len)
+	{
+		memcpy(_versionToken + _versionLength, p, len);
+		_versionLength += len;
+	}
+	inline void onHeadersComplete()
+	{
+		_method = methodId(_methodName, _methodLength);
+		_version = protocolVersion(_versionToken, _versionLength);
+	}
+
+	Method _method;
+	char _methodName[MaxMethodLength];
+	size_t _methodLength;
+	char _uri[MaxUriLength];
+	size_t _uriLength;
+	ProtocolVersion _version;
+	char _versionToken[MaxProtocolVersionLength];
+	size_t _versionLength;
+};
+
+} // namespace httpxx
+
+#endif
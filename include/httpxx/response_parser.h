@@ -0,0 +1,127 @@
+#ifndef HTTPXX_RESPONSE_PARSER_H
+#define HTTPXX_RESPONSE_PARSER_H
+
+#include <cstring>
+#include <httpxx/common.h>
+#include <httpxx/protocol_ids.h>
+#include <httpxx/typed_message_parser.h>
+
+namespace httpxx
+{
+
+//! HTTP-response parser
+/*!
+ * Parser, which is specialized for HTTP-responses: version is exposed as an
+ * identifier, status code as an integer and reason phrase is stored in the fixed
+ * buffer of the parser, which size is a template parameter as well as the rest
+ * of the limits.
+ *
+ * Example of use:
+ * \code{.cpp}
+ * ...
+ *
+ * httpxx::ResponseParser<> parser;
+ * std::pair<bool, size_t> res = parser.parse(buf, bytesReceived);
+ * if (res.first && parser.statusCode() != 200) {
+ *     std::cerr << parser.statusCode() << ' ' << parser.reasonPhrase() << std::endl;
+ * }
+ *
+ * ...
+ * \endcode
+ */
+template <size_t MaxReasonPhraseLength = 64U,
+	size_t MaxHeaderNameLength = MessageParserBase::DefaultMaxHeaderNameLength,
+	size_t MaxHeaderValueLength = MessageParserBase::DefaultMaxHeaderValueLength,
+	size_t MaxHeadersAmount = MessageParserBase::DefaultMaxHeadersAmount>
+class ResponseParser : public TypedMessageParser<ResponseParser<MaxReasonPhraseLength,
+	MaxHeaderNameLength, MaxHeaderValueLength, MaxHeadersAmount> >
+{
+public:
+	//! Constructs parser
+	ResponseParser() :
+		TypedMessageParser<ResponseParser>(MaxProtocolVersionLength, MaxStatusCodeLength, MaxReasonPhraseLength,
+				MaxHeaderNameLength, MaxHeaderValueLength, MaxHeadersAmount),
+		_version(UnknownProtocolVersion),
+		_versionToken(),
+		_versionLength(0U),
+		_statusCode(0),
+		_statusCodeLength(0U),
+		_reasonPhrase(),
+		_reasonPhraseLength(0U)
+	{}
+
+	//! Returns HTTP-version identifier (valid after the header section has been parsed)
+	inline ProtocolVersion version() const
+	{
+		return _version;
+	}
+	//! Returns HTTP-version token as it has been received
+	inline StringView versionToken() const
+	{
+		return StringView(_versionToken, _versionLength);
+	}
+	//! Returns status code or 0 if it is not a 3-digit number
+	inline int statusCode() const
+	{
+		return _statusCodeLength == MaxStatusCodeLength ? _statusCode : 0;
+	}
+	//! Returns reason phrase
+	inline StringView reasonPhrase() const
+	{
+		return StringView(_reasonPhrase, _reasonPhraseLength);
+	}
+private:
+	typedef TypedMessageParser<ResponseParser> Base;
+	friend class BasicMessageParser<ResponseParser>;
+
+	enum PrivateConstants {
+		MaxStatusCodeLength = 3
+	};
+
+	inline void onMessageBegin()
+	{
+		Base::onMessageBegin();
+		_version = UnknownProtocolVersion;
+		_versionLength = 0U;
+		_statusCode = 0;
+		_statusCodeLength = 0U;
+		_reasonPhraseLength = 0U;
+	}
+	// Tokens do not exceed their limits, which are the buffer sizes
+	inline void onFirstToken(const char * p, size_t len)
+	{
+		memcpy(_versionToken + _versionLength, p, len);
+		_versionLength += len;
+	}
+	inline void onSecondToken(const char * p, size_t len)
+	{
+		for (size_t i = 0U; i < len; ++i, ++_statusCodeLength) {
+			// Non-digit makes the length invalid for good
+			_statusCode = _statusCode * 10 + (p[i] - '0');
+			if (!isDigit(p[i])) {
+				_statusCodeLength = MaxStatusCodeLength + 1U;
+			}
+		}
+	}
+	inline void onThirdToken(const char * p, size_t len)
+	{
+		memcpy(_reasonPhrase + _reasonPhraseLength, p, len);
+		_reasonPhraseLength += len;
+	}
+	inline void onHeadersComplete()
+	{
+		_version = protocolVersion(_versionToken, _versionLength);
+	}
+
+	ProtocolVersion _version;
+	char _versionToken[MaxProtocolVersionLength];
+	size_t _versionLength;
+	int _statusCode;
+	size_t _statusCodeLength;
+	char _reasonPhrase[MaxReasonPhraseLength];
+	size_t _reasonPhraseLength;
+};
+
+} // namespace httpxx
+
+#endif
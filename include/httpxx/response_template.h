@@ -0,0 +1,133 @@
+#ifndef HTTPXX_RESPONSE_TEMPLATE_H
+#define HTTPXX_RESPONSE_TEMPLATE_H
+
+#include <httpxx/common.h>
+#include <httpxx/char_utils.h>
+#include <httpxx/headers.h>
+#include <httpxx/http_date.h>
+#include <httpxx/protocol_ids.h>
+#include <httpxx/message_composer.h>
+#include <httpxx/scatter_packet.h>
+#include <string>
+
+namespace httpxx
+{
+
+//! Precompiled HTTP-response envelope
+/*!
+ * Status line and headers of the response are rendered once on construction,
+ * so envelope composition takes a memcpy() of the rendered bytes plus patching
+ * of the optional slots: "Date" header value and "Content-Length" header value,
+ * which is the last header of the envelope.
+ *
+ * \code{.cpp}
+ * ...
+ *
+ * httpxx::Headers headers;
+ * headers.add("Server", "httpxx");
+ * headers.add("Content-Type", "text/plain");
+ * static const httpxx::ResponseTemplate ok(200, headers,
+ *         httpxx::ResponseTemplate::ContentLengthSlot | httpxx::ResponseTemplate::DateSlot);
+ * ...
+ * size_t envelopeLen = ok.composeEnvelope(buf, sizeof(buf), payloadLen);
+ *
+ * ...
+ * \endcode
+ *
+ * \note Template is immutable after construction, so it could be shared by the
+ *       threads without synchronization.
+ */
+class ResponseTemplate
+{
+public:
+	//! Slots, which are patched on each composition
+	enum SlotFlags {
+		ContentLengthSlot = 0x01,		//!< "Content-Length" header (existing "Content-Length" and "Transfer-Encoding" headers are removed)
+		DateSlot = 0x02				//!< "Date" header (existing "Date" headers are removed)
+	};
+	//! Class constants
+	enum Constants {
+		DateLength = HttpDateLength		//!< Length of the "Date" header value (IMF-fixdate)
+	};
+
+	//! Constructs template for the well-known status code
+	/*!
+	 * \param statusCode Status code (reason phrase is taken from the table, see reasonPhrase())
+	 * \param headers Headers to render
+	 * \param slots Slots of the template (see SlotFlags)
+	 * \param version HTTP-version of the response
+	 */
+	ResponseTemplate(int statusCode, const Headers& headers, int slots = ContentLengthSlot,
+			ProtocolVersion version = Http11ProtocolVersion);
+	//! Constructs template with custom tokens of the status line
+	/*!
+	 * \param versionToken HTTP-version token
+	 * \param statusCode Status code
+	 * \param reasonPhrase Reason phrase
+	 * \param headers Headers to render
+	 * \param slots Slots of the template (see SlotFlags)
+	 */
+	ResponseTemplate(const std::string& versionToken, int statusCode, const std::string& reasonPhrase,
+			const Headers& headers, int slots = ContentLengthSlot);
+
+	//! Returns status code of the response
+	inline int statusCode() const
+	{
+		return _statusCode;
+	}
+	//! Returns slots of the template
+	inline int slots() const
+	{
+		return _slots;
+	}
+	//! Returns size of the envelope
+	/*!
+	 * \param payloadLen Length of the payload data in HTTP-response (ignored if there is no
+	 *                   "Content-Length" slot)
+	 */
+	inline size_t envelopeSize(size_t payloadLen = 0U) const
+	{
+		return _rendered.size() + ((_slots & ContentLengthSlot) ? decimalLength(payloadLen) + 4U : 0U);
+	}
+	//! Composes envelope into buffer
+	/*!
+	 * \param buffer Pointer to result buffer to compose envelope into
+	 * \param bufLen Length of the result buffer
+	 * \param payloadLen Length of the payload data in HTTP-response ("Content-Length: 0" is
+	 *                   composed for empty payload)
+	 * \param date "Date" header value of DateLength characters (current date is used by default, see currentHttpDate())
+	 * \return Length of the envelope
+	 */
+	size_t composeEnvelope(void * buffer, size_t bufLen, size_t payloadLen = 0U, const char * date = 0) const;
+	//! Prepends data with envelope to compose an HTTP-response
+	/*!
+	 * \param buffer Pointer to result buffer to compose envelope into
+	 * \param envelopePartLen Length of the envelope part in result buffer
+	 * \param payloadLen Length of the data in buffer to send (should start from 'envelopePartLen' offset)
+	 * \param date "Date" header value of DateLength characters (current date is used by default, see currentHttpDate())
+	 * \return Pointer to HTTP-packet and it's length (envelope + data)
+	 */
+	MessageComposer::Packet prependEnvelope(void * buffer, size_t envelopePartLen, size_t payloadLen = 0U,
+			const char * date = 0) const;
+	//! Appends envelope segments to scatter-gather packet
+	/*!
+	 * Segments reference the rendered bytes of the template, so it should outlive the packet.
+	 * \param target Packet to append envelope segments to
+	 * \param payloadLen Length of the payload data in HTTP-response
+	 * \param date "Date" header value of DateLength characters (current date is used by default, see currentHttpDate())
+	 */
+	void composeEnvelope(ScatterPacket& target, size_t payloadLen = 0U, const char * date = 0) const;
+private:
+	ResponseTemplate();
+
+	void render(const std::string& statusLine, const Headers& headers);
+
+	int _statusCode;
+	int _slots;
+	std::string _rendered;
+	size_t _dateOffset;
+};
+
+} // namespace httpxx
+
+#endif
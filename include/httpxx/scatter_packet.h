@@ -0,0 +1,120 @@
+#ifndef HTTPXX_SCATTER_PACKET_H
+#define HTTPXX_SCATTER_PACKET_H
+
+#include <httpxx/arena.h>
+#include <sys/uio.h>
+#include <cstddef>
+#include <string>
+
+namespace httpxx
+{
+
+//! Scatter-gather HTTP-packet
+/*!
+ * Packet is a sequence of segments, which reference the data instead of
+ * copying it, so an HTTP-message could be sent by a single writev()/sendmsg()
+ * call with no copies of the headers and the payload:
+ *
+ * \code{.cpp}
+ * ...
+ *
+ * httpxx::ScatterPacket packet;
+ * composer.composeEnvelope(packet, headers, payloadLen);
+ * packet.append(payload, payloadLen);
+ * while (!packet.empty()) {
+ *     ssize_t sent = writev(sock, packet.segments(), std::min<size_t>(packet.segmentsAmount(), IOV_MAX));
+ *     ...
+ *     packet.consume(sent);
+ * }
+ *
+ * ...
+ * \endcode
+ *
+ * Adjacent segments are merged, the data, which is generated during the
+ * composition (e.g. the Content-Length value), is stored in the arena of the
+ * packet.
+ *
+ * \note Referenced data (headers, composer tokens, payload) should outlive
+ *       the packet or it's next clear().
+ */
+class ScatterPacket
+{
+public:
+	//! Class constants
+	enum Constants {
+		InlineSegmentsAmount = 64,		//!< Amount of segments, which are stored inline
+		ArenaBlockSize = 256			//!< Block size of the arena for the generated data
+	};
+
+	//! Constructs an empty packet
+	ScatterPacket();
+	~ScatterPacket();
+
+	//! Returns the first segment to send
+	inline const struct iovec * segments() const
+	{
+		return _segments + _first;
+	}
+	//! Returns amount of segments to send
+	inline size_t segmentsAmount() const
+	{
+		return _size - _first;
+	}
+	//! Returns amount of bytes to send
+	inline size_t size() const
+	{
+		return _bytes;
+	}
+	//! Returns TRUE if there is nothing to send
+	inline bool empty() const
+	{
+		return _bytes <= 0U;
+	}
+	//! Appends the segment, which references the data
+	/*!
+	 * \param buf Data to reference
+	 * \param len Data length
+	 */
+	void append(const void * buf, size_t len);
+	//! Allocates the storage, which lives until the packet is cleared
+	/*!
+	 * Use it for the data, which should be referenced by the packet, but has
+	 * no owner of it's own.
+	 * \param len Amount of bytes to allocate
+	 */
+	inline char * allocate(size_t len)
+	{
+		return static_cast<char *>(_arena.allocate(len, 1U));
+	}
+	//! Copies the data of the segments into the buffer
+	/*!
+	 * \param buf Buffer to copy into
+	 * \param len Length of the buffer
+	 * \return Amount of bytes copied
+	 */
+	size_t copy(void * buf, size_t len) const;
+	//! Returns a copy of the data of the segments
+	std::string str() const;
+	//! Removes sent bytes from the beginning of the packet
+	/*!
+	 * \param len Amount of bytes sent (should not exceed size())
+	 */
+	void consume(size_t len);
+	//! Removes all the segments keeping the storage to be reused
+	void clear();
+private:
+	ScatterPacket(const ScatterPacket&);
+	ScatterPacket& operator=(const ScatterPacket&);
+
+	struct iovec * _segments;
+	size_t _first;
+	size_t _size;
+	size_t _capacity;
+	size_t _bytes;
+	Arena _arena;
+	struct iovec _inlineSegments[InlineSegmentsAmount];
+};
+
+} // namespace httpxx
+
+#endif
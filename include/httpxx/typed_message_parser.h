@@ -0,0 +1,131 @@
+#ifndef HTTPXX_TYPED_MESSAGE_PARSER_H
+#define HTTPXX_TYPED_MESSAGE_PARSER_H
+
+#include <string>
+#include <httpxx/headers.h>
+#include <httpxx/basic_message_parser.h>
+
+namespace httpxx
+{
+
+//! Base class of the HTTP-request/HTTP-response parsers
+/*!
+ * Collects headers and body chunks of the HTTP-message, leaving the first
+ * line to the handler (see RequestParser and ResponseParser).
+ * Handler should call onMessageBegin() of this class from it's own one.
+ */
+template <class Handler>
+class TypedMessageParser : public BasicMessageParser<Handler>
+{
+public:
+	//! Returns a constant reference to the HTTP-message headers
+	inline const Headers& headers() const
+	{
+		return _headers;
+	}
+	//! Parses next character
+	/*!
+	  \param ch Next character to parse
+	  \return TRUE if complete message has been successfully parsed
+	*/
+	bool parse(char ch)
+	{
+		_payload = 0;
+		return BasicMessageParser<Handler>::parse(ch);
+	}
+	//! Parses buffer for an HTTP-message and composes payload chunks container
+	/*!
+	 * Body bytes are not copied: each payload chunk points into the supplied buffer.
+	 * \param buf Pointer to the buffer to parse
+	 * \param bufLen Size of the buffer to parse
+	 * \param payload Optional pointer to payload chunks container to fill in [out]
+	 * \return A pair with complete message flag and parsed bytes amount
+	*/
+	std::pair<bool, size_t> parse(const void * buf, size_t bufLen, MessageParserBase::Payload * payload = 0)
+	{
+		_payload = payload;
+		return BasicMessageParser<Handler>::parse(buf, bufLen);
+	}
+	//! Parses next character without throwing an exception on error
+	/*!
+	  \param ch Next character to parse
+	  \return Parsing result
+	*/
+	MessageParserBase::ParseResult tryParse(char ch)
+	{
+		_payload = 0;
+		return BasicMessageParser<Handler>::tryParse(ch);
+	}
+	//! Parses buffer for an HTTP-message and composes payload chunks container without throwing an exception on error
+	/*!
+	 * \param buf Pointer to the buffer to parse
+	 * \param bufLen Size of the buffer to parse
+	 * \param payload Optional pointer to payload chunks container to fill in [out]
+	 * \return Parsing result
+	*/
+	MessageParserBase::ParseResult tryParse(const void * buf, size_t bufLen, MessageParserBase::Payload * payload = 0)
+	{
+		_payload = payload;
+		return BasicMessageParser<Handler>::tryParse(buf, bufLen);
+	}
+protected:
+	TypedMessageParser(size_t maxFirstTokenLength, size_t maxSecondTokenLength, size_t maxThirdTokenLength,
+			size_t maxHeaderNameLength, size_t maxHeaderValueLength, size_t maxHeadersAmount) :
+		BasicMessageParser<Handler>(maxFirstTokenLength, maxSecondTokenLength, maxThirdTokenLength,
+				maxHeaderNameLength, maxHeaderValueLength, maxHeadersAmount),
+		_headerFieldName(),
+		_headerFieldValue(),
+		_headers(),
+		_payload(0)
+	{}
+	~TypedMessageParser()
+	{}
+
+	//! New message hook, which clears headers of the previous message
+	inline void onMessageBegin()
+	{
+		_headerFieldName.clear();
+		_headerFieldValue.clear();
+		_headers.clear();
+	}
+private:
+	friend class BasicMessageParser<Handler>;
+
+	TypedMessageParser();
+
+	inline void onHeaderName(const char * p, size_t len)
+	{
+		_headerFieldName.append(p, len);
+	}
+	inline void onHeaderValue(const char * p, size_t len)
+	{
+		_headerFieldValue.append(p, len);
+	}
+	void onHeaderFieldComplete()
+	{
+		// Leading whitespace is skipped by parser
+		std::string::size_type valueEnd = _headerFieldValue.size();
+		while (valueEnd > 0U && isSpaceOrTab(_headerFieldValue[valueEnd - 1U])) {
+			--valueEnd;
+		}
+		_headerFieldValue.erase(valueEnd);
+		_headers.insert(Headers::value_type(_headerFieldName, _headerFieldValue));
+		_headerFieldName.clear();
+		_headerFieldValue.clear();
+	}
+	inline void onBodyData(const char * p, size_t len)
+	{
+		if (_payload != 0) {
+			_payload->push_back(MessageParserBase::PayloadChunk(p, len));
+		}
+	}
+
+	std::string _headerFieldName;
+	std::string _headerFieldValue;
+	Headers _headers;
+	MessageParserBase::Payload * _payload;
+};
+
+} // namespace httpxx
+
+#endif
@@ -3,11 +3,14 @@
 
 #include <httpxx/common.h>
 #include <ostream>
+#include <memory>
 
 namespace httpxx
 {
 
-class Params;
+template <class Allocator>
+class BasicParams;
+typedef BasicParams<std::allocator<char> > Params;
 
 //! Uniform Resource Identifier (<a href="https://www.ietf.org/rfc/rfc3986.txt">RFC-3986</a>)
 /*!
@@ -0,0 +1,118 @@
+#include <httpxx/arena.h>
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+
+namespace httpxx
+{
+
+Arena::Arena(size_t blockSize) :
+	_blockSize(blockSize),
+	_blocks(0),
+	_freeBlocks(0),
+	_top(0),
+	_end(0)
+{}
+
+Arena::~Arena()
+{
+	freeBlocks(_blocks);
+	freeBlocks(_freeBlocks);
+}
+
+void * Arena::allocate(size_t len, size_t alignment)
+{
+	size_t padding = (alignment - reinterpret_cast<uintptr_t>(_top) % alignment) % alignment;
+	if (_top == 0 || available() < padding + len) {
+		// Block data is aligned to the maximum alignment
+		reserve(len);
+		padding = 0U;
+	}
+	char * result = _top + padding;
+	_top = result + len;
+	return result;
+}
+
+char * Arena::reserve(size_t len)
+{
+	if (_top != 0 && available() >= len) {
+		return _top;
+	}
+	// Rest of the current block is wasted
+	Block * block = 0;
+	for (Block ** i = &_freeBlocks; *i != 0; i = &(*i)->next) {
+		if ((*i)->size >= len) {
+			block = *i;
+			*i = block->next;
+			break;
+		}
+	}
+	if (block == 0) {
+		size_t size = len > _blockSize ? len : _blockSize;
+		block = static_cast<Block *>(::operator new(HeaderSize + size));
+		block->size = size;
+	}
+	block->next = _blocks;
+	_blocks = block;
+	_top = blockData(block);
+	_end = _top + block->size;
+	return _top;
+}
+
+char * Arena::grow(const char * data, size_t size, size_t len)
+{
+	if (size > 0U && data + size == _top && available() >= len) {
+		return _top - size;
+	}
+	char * result = reserve(std::max(size + len, size * 2U));
+	if (size > 0U) {
+		memcpy(result, data, size);
+		commit(size);
+	}
+	return result;
+}
+
+size_t Arena::capacity() const
+{
+	size_t result = 0U;
+	for (Block * block = _blocks; block != 0; block = block->next) {
+		result += block->size;
+	}
+	for (Block * block = _freeBlocks; block != 0; block = block->next) {
+		result += block->size;
+	}
+	return result;
+}
+
+void Arena::reset()
+{
+	while (_blocks != 0) {
+		Block * block = _blocks;
+		_blocks = block->next;
+		block->next = _freeBlocks;
+		_freeBlocks = block;
+	}
+	_top = 0;
+	_end = 0;
+}
+
+void Arena::clear()
+{
+	freeBlocks(_blocks);
+	freeBlocks(_freeBlocks);
+	_blocks = 0;
+	_freeBlocks = 0;
+	_top = 0;
+	_end = 0;
+}
+
+void Arena::freeBlocks(Block * block)
+{
+	while (block != 0) {
+		Block * next = block->next;
+		::operator delete(block);
+		block = next;
+	}
+}
+
+} // namespace httpxx
@@ -0,0 +1,123 @@
+#include <httpxx/basic_message_parser.h>
+#include <sstream>
+
+namespace {
+
+const char * ErrorCodeMessages[] =
+	{
+		"Invalid character in first token", /* Exception::InvalidFirstToken */
+		"First token is too long", /* Exception::FirstTokenIsTooLong */
+		"Invalid character in second token", /* Exception::InvalidSecondToken */
+		"Second token is too long", /* Exception::SecondTokenIsTooLong */
+		"Invalid character in third token", /* Exception::InvalidThirdToken */
+		"Third token is too long", /* Exception::ThirdTokenIsTooLong */
+		"First line CR is followed by invalid character", /* Exception::InvalidFirstLineLF */
+		"Too many headers", /* Exception::TooManyHeaders */
+		"Empty header name", /* Exception::EmptyHeaderName */
+		"Invalid header name", /* Exception::InvalidHeaderName */
+		"Header name is too long", /* Exception::HeaderNameIsTooLong */
+		"Header is missing ':' separator", /* Exception::HeaderIsMissingColon */
+		"Invalid header value", /* Exception::InvalidHeaderValue */
+		"Header value is too long", /* Exception::HeaderValueIsTooLong */
+		"Header CR is followed by invalid character", /* Exception::InvalidHeaderLF */
+		"Invalid content length", /* Exception::InvalidContentLength */
+		"Empty chunk size", /* Exception::EmptyChunkSize */
+		"Invalid chunk size", /* Exception::InvalidChunkSize */
+		"Chunk size CR is followed by invalid character", /* Exception::InvalidChunkSizeLF */
+		"Chunk data is followed by invalid character", /* Exception::InvalidChunkDataCR */
+		"Chunk data CR is followed by invalid character", /* Exception::InvalidChunkDataLF */
+		"Final CR is followed by invalid character", /* Exception::InvalidFinalLF */
+		"Invalid parser state", /* Exception::InvalidState - should never happens */
+	};
+
+struct ListElement
+{
+	const char * name;
+	size_t len;
+	unsigned int flags;
+};
+
+const ListElement TransferCodings[] = {
+	{ "chunked", 7, httpxx::MessageParserBase::ChunkedTransferCoding },
+	{ "gzip", 4, httpxx::MessageParserBase::GzipTransferCoding },
+	{ "x-gzip", 6, httpxx::MessageParserBase::GzipTransferCoding },
+	{ "deflate", 7, httpxx::MessageParserBase::DeflateTransferCoding },
+	{ "compress", 8, httpxx::MessageParserBase::CompressTransferCoding },
+	{ "x-compress", 10, httpxx::MessageParserBase::CompressTransferCoding },
+	{ "identity", 8, httpxx::MessageParserBase::IdentityTransferCoding }
+};
+
+const ListElement ConnectionOptions[] = {
+	{ "close", 5, httpxx::MessageParserBase::CloseConnectionOption },
+	{ "keep-alive", 10, httpxx::MessageParserBase::KeepAliveConnectionOption },
+	{ "upgrade", 7, httpxx::MessageParserBase::UpgradeConnectionOption }
+};
+
+template <size_t N>
+unsigned int listElementFlags(const ListElement (&elements)[N], const char * name, size_t len)
+{
+	for (size_t i = 0U; i < N; ++i) {
+		if (elements[i].len == len && httpxx::equalsIgnoreCase(elements[i].name, name, len)) {
+			return elements[i].flags;
+		}
+	}
+	return 0U;
+}
+
+}
+
+namespace httpxx
+{
+
+//------------------------------------------------------------------------------
+// MessageParserBase
+//------------------------------------------------------------------------------
+
+const char * MessageParserBase::errorMessage(Exception::Code code)
+{
+	return ErrorCodeMessages[code];
+}
+
+unsigned int MessageParserBase::transferCoding(const char * name, size_t len)
+{
+	unsigned int result = listElementFlags(TransferCodings, name, len);
+	return result != 0U ? result : static_cast<unsigned int>(UnknownTransferCoding);
+}
+
+unsigned int MessageParserBase::connectionOption(const char * name, size_t len)
+{
+	return listElementFlags(ConnectionOptions, name, len);
+}
+
+//------------------------------------------------------------------------------
+// MessageParserBase::Exception
+//------------------------------------------------------------------------------
+
+MessageParserBase::Exception::Exception(char ch, int pos, int line, int col, Code code) :
+	std::exception(),
+	_ch(ch),
+	_pos(pos),
+	_line(line),
+	_col(col),
+	_code(code),
+	_what()
+{}
+
+const char * MessageParserBase::Exception::msg() const throw ()
+{
+	return errorMessage(_code);
+}
+
+const char * MessageParserBase::Exception::what() const throw ()
+{
+	if (_what.empty()) {
+		std::ostringstream oss;
+		oss << "HTTP-message parsing error (pos: " << _pos << ", line: " << _line << ", col: " << _col <<
+			", character: " << std::showbase << std::hex << static_cast<int>(_ch) << "): " <<
+			ErrorCodeMessages[_code];
+		_what = oss.str();
+	}
+	return _what.c_str();
+}
+
+} // namespace httpxx
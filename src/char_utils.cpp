@@ -1,8 +1,32 @@
-#include "char_utils.h"
+#include <httpxx/char_utils.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace httpxx
 {
 
+const unsigned char CharClasses[256] = {
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x07, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,	// 0x00
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,	// 0x10
+	0x46, 0x48, 0x44, 0x48, 0x48, 0x48, 0x48, 0x48, 0x44, 0x44, 0x48, 0x48, 0x44, 0x48, 0x48, 0x44,	// 0x20
+	0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,	// 0x30
+	0x44, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48,	// 0x40
+	0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x44, 0x44, 0x44, 0x48, 0x48,	// 0x50
+	0x48, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48,	// 0x60
+	0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x48, 0x44, 0x48, 0x44, 0x48, 0x01,	// 0x70
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,	// 0x80
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,	// 0x90
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,	// 0xA0
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,	// 0xB0
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,	// 0xC0
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,	// 0xD0
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,	// 0xE0
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00	// 0xF0
+};
+
 unsigned char hexValue(unsigned char ch)
 {
 	if (isDigit(ch)) {
@@ -16,4 +40,478 @@ unsigned char hexValue(unsigned char ch)
 	}
 }
 
+namespace {
+
+#if defined(__SSE2__)
+
+// Returns a mask of bytes which are in [lo, hi] range (unsigned comparison)
+inline __m128i inRange(__m128i v, unsigned char lo, unsigned char hi)
+{
+	__m128i shifted = _mm_sub_epi8(v, _mm_set1_epi8(static_cast<char>(lo)));
+	return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(static_cast<char>(hi - lo))), shifted);
+}
+
+// Returns a mask of bytes which are equal to the character
+inline __m128i isEqual(__m128i v, unsigned char ch)
+{
+	return _mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(ch)));
+}
+
+#endif
+
+// Character classes: each one provides a scalar predicate and a vectorized mask
+
+struct VisibleChars
+{
+	static inline bool accepts(unsigned char ch)
+	{
+		return isChar(ch) && !isControl(ch) && !isSpaceOrTab(ch);
+	}
+#if defined(__SSE2__)
+	static inline __m128i mask(__m128i v)
+	{
+		return inRange(v, 0x21, 0x7E);
+	}
+#endif
+};
+
+struct PrintableChars
+{
+	static inline bool accepts(unsigned char ch)
+	{
+		return isChar(ch) && !isControl(ch);
+	}
+#if defined(__SSE2__)
+	static inline __m128i mask(__m128i v)
+	{
+		return inRange(v, 0x20, 0x7E);
+	}
+#endif
+};
+
+struct TokenChars
+{
+	static inline bool accepts(unsigned char ch)
+	{
+		return isToken(ch);
+	}
+#if defined(__SSE2__)
+	static inline __m128i mask(__m128i v)
+	{
+		// Separators except SP/HT, which are not visible anyway:
+		// '"', '(', ')', ',', '/', ':', ';', '<', '=', '>', '?', '@', '[', '\', ']', '{', '}'
+		__m128i separators = _mm_or_si128(
+				_mm_or_si128(
+					_mm_or_si128(isEqual(v, '"'), inRange(v, '(', ')')),
+					_mm_or_si128(isEqual(v, ','), isEqual(v, '/'))),
+				_mm_or_si128(
+					_mm_or_si128(inRange(v, ':', '@'), inRange(v, '[', ']')),
+					_mm_or_si128(isEqual(v, '{'), isEqual(v, '}'))));
+		return _mm_andnot_si128(separators, VisibleChars::mask(v));
+	}
+#endif
+};
+
+struct NonControlChars
+{
+	static inline bool accepts(unsigned char ch)
+	{
+		return !isControl(ch);
+	}
+#if defined(__SSE2__)
+	static inline __m128i mask(__m128i v)
+	{
+		__m128i controls = _mm_or_si128(inRange(v, 0x00, 0x1F), isEqual(v, 0x7F));
+		return _mm_xor_si128(controls, _mm_set1_epi8(static_cast<char>(0xFF)));
+	}
+#endif
+};
+
+template <class CharClass>
+size_t spanChars(const char * buf, size_t len)
+{
+	size_t pos = 0U;
+#if defined(__SSE2__)
+	// Inspecting 16 bytes at once
+	while (pos + sizeof(__m128i) <= len) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + pos));
+		unsigned int rejected = static_cast<unsigned int>(_mm_movemask_epi8(CharClass::mask(v))) ^ 0xFFFFU;
+		if (rejected != 0U) {
+			return pos + __builtin_ctz(rejected);
+		}
+		pos += sizeof(__m128i);
+	}
+#endif
+	while (pos < len && CharClass::accepts(buf[pos])) {
+		++pos;
+	}
+	return pos;
+}
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define HTTPXX_SWAR_DIGITS
+#endif
+
+// Repeats the byte in each byte of the word
+inline uint64_t repeatByte(unsigned char byte)
+{
+	return UINT64_C(0x0101010101010101) * byte;
+}
+
+// Loads eight characters, the first one goes to the least significant byte on little-endian
+inline uint64_t loadWord(const char * buf)
+{
+	uint64_t v;
+	memcpy(&v, buf, sizeof(v));
+	return v;
+}
+
+// Loads less than eight characters to the low bytes of the word, the rest of the word is zeroed
+inline uint64_t loadPartialWord(const char * buf, size_t len)
+{
+	// Short loop is cheaper than the variable-length memcpy() call
+	uint64_t v = 0U;
+	for (size_t i = 0U; i < len; ++i) {
+		v |= static_cast<uint64_t>(static_cast<unsigned char>(buf[i])) << (i * 8U);
+	}
+	return v;
+}
+
+// Converts ASCII upper-case letters of the word to lower-case ones
+inline uint64_t foldWord(uint64_t v)
+{
+	// 0x80 in each byte in 'A'..'Z' range, non-ASCII bytes are excluded
+	uint64_t heptets = v & repeatByte(0x7F);
+	uint64_t upper = (heptets + repeatByte(0x80 - 'A')) & ~(heptets + repeatByte(0x7F - 'Z')) &
+		~v & repeatByte(0x80);
+	return v | (upper >> 2);
+}
+
+inline unsigned char foldChar(unsigned char ch)
+{
+	return ch | (static_cast<unsigned char>(ch - 'A') < 26U ? 0x20U : 0x00U);
+}
+
+#if defined(__SSE2__)
+
+// Converts ASCII upper-case letters to lower-case ones
+inline __m128i foldVector(__m128i v)
+{
+	return _mm_or_si128(v, _mm_and_si128(inRange(v, 'A', 'Z'), _mm_set1_epi8(0x20)));
+}
+
+// Returns a bit mask of the bytes, which are different after case-folding
+inline unsigned int foldedMismatch(const char * lhs, const char * rhs)
+{
+	__m128i l = foldVector(_mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs)));
+	__m128i r = foldVector(_mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs)));
+	return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(l, r))) ^ 0xFFFFU;
+}
+
+#endif
+
+#if defined(HTTPXX_SWAR_DIGITS)
+
+// Returns 0x80 in each byte of the word, which is in [lo, hi] range (bytes are to be less than 0x80)
+inline uint64_t inRange(uint64_t v, unsigned char lo, unsigned char hi)
+{
+	return (v + repeatByte(0x80 - lo)) & ~(v + repeatByte(0x7F - hi)) & repeatByte(0x80);
+}
+
+// Converts eight decimal digits, returns FALSE if there is a non-digit
+inline bool parseDecimalWord(const char * buf, uint64_t& result)
+{
+	uint64_t v = loadWord(buf);
+	if ((v & repeatByte(0x80)) != 0U || inRange(v, '0', '9') != repeatByte(0x80)) {
+		return false;
+	}
+	v &= repeatByte(0x0F);
+	// Combining adjacent digits to 2-, 4- and then 8-digit numbers
+	v = (v * 10U + (v >> 8)) & UINT64_C(0x00FF00FF00FF00FF);
+	v = (v * 100U + (v >> 16)) & UINT64_C(0x0000FFFF0000FFFF);
+	result = (v * 10000U + (v >> 32)) & UINT64_C(0x00000000FFFFFFFF);
+	return true;
+}
+
+// Converts eight hex digits, returns FALSE if there is a non-hex-digit
+inline bool parseHexWord(const char * buf, uint64_t& result)
+{
+	uint64_t v = loadWord(buf);
+	if ((v & repeatByte(0x80)) != 0U) {
+		return false;
+	}
+	uint64_t letters = inRange(v | repeatByte(0x20), 'a', 'f');
+	if ((inRange(v, '0', '9') | letters) != repeatByte(0x80)) {
+		return false;
+	}
+	// Letter's low nibble is it's value minus 9
+	v = (v & repeatByte(0x0F)) + (letters >> 7) * 9U;
+	v = ((v << 4) + (v >> 8)) & UINT64_C(0x00FF00FF00FF00FF);
+	v = ((v << 8) + (v >> 16)) & UINT64_C(0x0000FFFF0000FFFF);
+	result = ((v << 16) + (v >> 32)) & UINT64_C(0x00000000FFFFFFFF);
+	return true;
+}
+
+#endif
+
+// Two-digit decimal representations of 0..99
+const char DecimalPairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+} // anonymous namespace
+
+// Strings, which are longer than a block, are inspected by blocks with the last block overlapping
+// the previous one, so there is no character by character tail
+
+bool equalsIgnoreCase(const char * lhs, const char * rhs, size_t len)
+{
+#if defined(__SSE2__)
+	if (len >= 16U) {
+		for (size_t pos = 0U; pos < len; pos += 16U) {
+			size_t block = (pos + 16U <= len) ? pos : len - 16U;
+			if (foldedMismatch(lhs + block, rhs + block) != 0U) {
+				return false;
+			}
+		}
+		return true;
+	}
+#endif
+	if (len >= 8U) {
+		for (size_t pos = 0U; pos < len; pos += 8U) {
+			size_t block = (pos + 8U <= len) ? pos : len - 8U;
+			if (foldWord(loadWord(lhs + block)) != foldWord(loadWord(rhs + block))) {
+				return false;
+			}
+		}
+		return true;
+	}
+	for (size_t pos = 0U; pos < len; ++pos) {
+		if (foldChar(lhs[pos]) != foldChar(rhs[pos])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int compareIgnoreCase(const char * lhs, size_t lhsLen, const char * rhs, size_t rhsLen)
+{
+	size_t len = lhsLen < rhsLen ? lhsLen : rhsLen;
+	size_t pos = 0U;
+#if defined(__SSE2__)
+	if (len >= 16U) {
+		for (; pos < len; pos += 16U) {
+			size_t block = (pos + 16U <= len) ? pos : len - 16U;
+			unsigned int mismatch = foldedMismatch(lhs + block, rhs + block);
+			if (mismatch != 0U) {
+				// Characters before the block are equal, so the first mismatch in it decides the order
+				block += __builtin_ctz(mismatch);
+				return foldChar(lhs[block]) < foldChar(rhs[block]) ? -1 : 1;
+			}
+		}
+	}
+#endif
+	if (len >= 8U) {
+		for (; pos < len; pos += 8U) {
+			size_t block = (pos + 8U <= len) ? pos : len - 8U;
+			uint64_t mismatch = foldWord(loadWord(lhs + block)) ^ foldWord(loadWord(rhs + block));
+			if (mismatch != 0U) {
+#if defined(HTTPXX_SWAR_DIGITS)
+				// The first character is the least significant byte
+				block += __builtin_ctzll(mismatch) / 8U;
+				return foldChar(lhs[block]) < foldChar(rhs[block]) ? -1 : 1;
+#else
+				pos = block;
+				break;
+#endif
+			}
+		}
+	}
+	for (; pos < len; ++pos) {
+		unsigned char l = foldChar(lhs[pos]);
+		unsigned char r = foldChar(rhs[pos]);
+		if (l != r) {
+			return l < r ? -1 : 1;
+		}
+	}
+	return lhsLen < rhsLen ? -1 : (lhsLen > rhsLen ? 1 : 0);
+}
+
+size_t hashIgnoreCase(const char * buf, size_t len)
+{
+	// FNV-1a over the case-folded words with a final avalanche
+	static const uint64_t Prime = UINT64_C(0x100000001B3);
+	uint64_t h = UINT64_C(0xCBF29CE484222325) ^ len;
+	if (len >= 8U) {
+		for (size_t pos = 0U; pos < len; pos += 8U) {
+			h = (h ^ foldWord(loadWord(buf + ((pos + 8U <= len) ? pos : len - 8U)))) * Prime;
+		}
+	} else {
+		h = (h ^ foldWord(loadPartialWord(buf, len))) * Prime;
+	}
+	h ^= h >> 33;
+	h *= UINT64_C(0xFF51AFD7ED558CCD);
+	h ^= h >> 33;
+	return static_cast<size_t>(h);
+}
+
+bool parseDecimal(const char * buf, size_t len, uint64_t& result)
+{
+	if (len <= 0) {
+		return false;
+	}
+	// Leading zeros do not count for overflow
+	size_t pos = 0U;
+	while (pos + 1U < len && buf[pos] == '0') {
+		++pos;
+	}
+	static const uint64_t MaxValue = ~UINT64_C(0);
+	uint64_t value = 0U;
+#if defined(HTTPXX_SWAR_DIGITS)
+	// Up to 19 digits never overflow, so two words are converted without checks
+	if (len - pos <= 19U) {
+		uint64_t word;
+		for (; pos + 8U <= len; pos += 8U) {
+			if (!parseDecimalWord(buf + pos, word)) {
+				return false;
+			}
+			value = value * UINT64_C(100000000) + word;
+		}
+	}
+#endif
+	for (; pos < len; ++pos) {
+		if (!isDigit(buf[pos])) {
+			return false;
+		}
+		uint64_t digit = buf[pos] - '0';
+		if (value > (MaxValue - digit) / 10U) {
+			return false;
+		}
+		value = value * 10U + digit;
+	}
+	result = value;
+	return true;
+}
+
+bool parseHex(const char * buf, size_t len, uint64_t& result)
+{
+	if (len <= 0) {
+		return false;
+	}
+	size_t pos = 0U;
+	while (pos + 1U < len && buf[pos] == '0') {
+		++pos;
+	}
+	if (len - pos > 16U) {
+		// 64-bit value has 16 hex digits at most, non-digits are failing anyway
+		return false;
+	}
+	uint64_t value = 0U;
+#if defined(HTTPXX_SWAR_DIGITS)
+	uint64_t word;
+	for (; pos + 8U <= len; pos += 8U) {
+		if (!parseHexWord(buf + pos, word)) {
+			return false;
+		}
+		value = (value << 32) | word;
+	}
+#endif
+	for (; pos < len; ++pos) {
+		if (!isHexDigit(buf[pos])) {
+			return false;
+		}
+		value = (value << 4) | hexValue(buf[pos]);
+	}
+	result = value;
+	return true;
+}
+
+size_t decimalLength(uint64_t value)
+{
+	size_t result = 1U;
+	// Four digits are skipped at a time for the large values
+	while (value >= 10000U) {
+		value /= 10000U;
+		result += 4U;
+	}
+	if (value >= 1000U) {
+		return result + 3U;
+	}
+	if (value >= 100U) {
+		return result + 2U;
+	}
+	return value >= 10U ? result + 1U : result;
+}
+
+size_t formatDecimal(uint64_t value, char * buf)
+{
+	size_t len = decimalLength(value);
+	char * p = buf + len;
+	while (value >= 100U) {
+		const char * pair = DecimalPairs + (value % 100U) * 2U;
+		value /= 100U;
+		*--p = pair[1];
+		*--p = pair[0];
+	}
+	if (value >= 10U) {
+		*--p = DecimalPairs[value * 2U + 1U];
+		*--p = DecimalPairs[value * 2U];
+	} else {
+		*--p = static_cast<char>('0' + value);
+	}
+	return len;
+}
+
+size_t hexLength(uint64_t value)
+{
+#if defined(__GNUC__)
+	return value == 0U ? 1U : (67U - static_cast<size_t>(__builtin_clzll(value))) / 4U;
+#else
+	size_t result = 1U;
+	while (value >= 16U) {
+		value >>= 4;
+		++result;
+	}
+	return result;
+#endif
+}
+
+size_t formatHex(uint64_t value, char * buf)
+{
+	static const char HexDigits[] = "0123456789abcdef";
+	size_t len = hexLength(value);
+	for (char * p = buf + len; p != buf; value >>= 4) {
+		*--p = HexDigits[value & 0x0FU];
+	}
+	return len;
+}
+
+size_t spanVisibleChars(const char * buf, size_t len)
+{
+	return spanChars<VisibleChars>(buf, len);
+}
+
+size_t spanPrintableChars(const char * buf, size_t len)
+{
+	return spanChars<PrintableChars>(buf, len);
+}
+
+size_t spanTokenChars(const char * buf, size_t len)
+{
+	return spanChars<TokenChars>(buf, len);
+}
+
+size_t spanNonControlChars(const char * buf, size_t len)
+{
+	return spanChars<NonControlChars>(buf, len);
+}
+
 } // namespace httpxx
@@ -0,0 +1,145 @@
+#include <httpxx/chunked_streambuf.h>
+
+namespace httpxx
+{
+
+ChunkedStreambuf::ChunkedStreambuf(MessageComposer& composer, const Headers& headers, std::ostream& target,
+		size_t chunkSize) :
+	std::streambuf(),
+	_composer(composer),
+	_headers(headers),
+	_target(target),
+	_chunkSize(chunkSize > 0U ? chunkSize : 1U),
+	_buffer(new char[EnvelopeSlotSize + _chunkSize]),
+	_chunksAmount(0U),
+	_closed(false)
+{
+	resetPutArea();
+}
+
+ChunkedStreambuf::~ChunkedStreambuf()
+{
+	delete [] _buffer;
+}
+
+bool ChunkedStreambuf::close(const Headers& trailers)
+{
+	if (_closed) {
+		return true;
+	}
+	if (!sendBuffered()) {
+		return false;
+	}
+	_closed = true;
+	if (_chunksAmount <= 0U) {
+		// Headers are not sent yet
+		_composer.composeChunkedEnvelope(_target, _headers);
+	}
+	_composer.composeLastChunk(_target, trailers);
+	_target.flush();
+	return _target.good();
+}
+
+ChunkedStreambuf::int_type ChunkedStreambuf::overflow(int_type ch)
+{
+	if (_closed || !sendBuffered()) {
+		return traits_type::eof();
+	}
+	if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+		*pptr() = traits_type::to_char_type(ch);
+		pbump(1);
+	}
+	return traits_type::not_eof(ch);
+}
+
+std::streamsize ChunkedStreambuf::xsputn(const char_type * s, std::streamsize n)
+{
+	if (_closed) {
+		return 0;
+	}
+	size_t len = static_cast<size_t>(n);
+	size_t buffered = static_cast<size_t>(pptr() - pbase());
+	if (buffered + len <= _chunkSize) {
+		traits_type::copy(pptr(), s, len);
+		pbump(static_cast<int>(len));
+		return n;
+	}
+	// Buffered data is completed up to the chunk size, the rest is sent as a chunk
+	// without copying unless it fits the buffer
+	size_t head = 0U;
+	if (buffered > 0U) {
+		head = _chunkSize - buffered;
+		traits_type::copy(pptr(), s, head);
+		pbump(static_cast<int>(head));
+		if (!sendBuffered()) {
+			return static_cast<std::streamsize>(head);
+		}
+	}
+	if (len - head >= _chunkSize) {
+		if (!sendChunk(s + head, len - head)) {
+			return static_cast<std::streamsize>(head);
+		}
+	} else {
+		traits_type::copy(pptr(), s + head, len - head);
+		pbump(static_cast<int>(len - head));
+	}
+	return n;
+}
+
+int ChunkedStreambuf::sync()
+{
+	if (!sendBuffered()) {
+		return -1;
+	}
+	_target.flush();
+	return _target.good() ? 0 : -1;
+}
+
+bool ChunkedStreambuf::sendBuffered()
+{
+	size_t len = static_cast<size_t>(pptr() - pbase());
+	if (len <= 0U) {
+		return true;
+	}
+	resetPutArea();
+	if (_chunksAmount > 0U) {
+		// Envelope is composed into the slot right before the data
+		size_t envelopeLen = _composer.nextChunkEnvelopeSize(len);
+		char * envelope = _buffer + EnvelopeSlotSize - envelopeLen;
+		_composer.composeNextChunkEnvelope(envelope, envelopeLen, len);
+		_target.write(envelope, envelopeLen + len);
+		++_chunksAmount;
+		return _target.good();
+	}
+	return sendChunk(_buffer + EnvelopeSlotSize, len);
+}
+
+bool ChunkedStreambuf::sendChunk(const char * data, size_t len)
+{
+	if (_chunksAmount > 0U) {
+		char envelope[EnvelopeSlotSize];
+		_target.write(envelope, _composer.composeNextChunkEnvelope(envelope, sizeof(envelope), len));
+	} else {
+		_composer.composeFirstChunkEnvelope(_target, _headers, len);
+	}
+	_target.write(data, len);
+	++_chunksAmount;
+	return _target.good();
+}
+
+ChunkedOStream::ChunkedOStream(MessageComposer& composer, const Headers& headers, std::ostream& target,
+		size_t chunkSize) :
+	std::ostream(0),
+	_streambuf(composer, headers, target, chunkSize)
+{
+	std::ostream::rdbuf(&_streambuf);
+}
+
+void ChunkedOStream::close(const Headers& trailers)
+{
+	if (!_streambuf.close(trailers)) {
+		setstate(std::ios::badbit);
+	}
+}
+
+} // namespace httpxx
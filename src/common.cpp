@@ -1,12 +1,18 @@
 #include <httpxx/common.h>
-#include <cstring>
+#include <httpxx/char_utils.h>
+#include <ostream>
 
 namespace httpxx
 {
 
 bool CaseInsensitiveComparator::operator()(const std::string &lhs, const std::string &rhs) const
 {
-	return strcasecmp(lhs.c_str(), rhs.c_str()) < 0;
+	return compareIgnoreCase(lhs.data(), lhs.size(), rhs.data(), rhs.size()) < 0;
+}
+
+std::ostream& operator<<(std::ostream& os, const StringView& sv)
+{
+	return os.write(sv.data(), sv.size());
 }
 
 } // namespace httpxx
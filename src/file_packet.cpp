@@ -0,0 +1,162 @@
+#include <httpxx/file_packet.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#endif
+
+namespace httpxx
+{
+
+namespace {
+
+const size_t InitialBufferSize = 1024U;
+
+// Writes memory part, MSG_MORE lets the kernel to merge it with the following file data
+ssize_t sendMemory(int fd, const char * buf, size_t len, bool more)
+{
+#if defined(__linux__)
+	ssize_t result = ::send(fd, buf, len, MSG_NOSIGNAL | (more ? MSG_MORE : 0));
+	if (result >= 0 || errno != ENOTSOCK) {
+		return result;
+	}
+#else
+	(void) more;
+#endif
+	return ::write(fd, buf, len);
+}
+
+ssize_t sendFile(int fd, int fileFd, off_t offset, size_t len)
+{
+#if defined(__linux__)
+	ssize_t result = ::sendfile(fd, fileFd, &offset, len);
+#else
+	// No portable zero-copy transfer: file data is copied through the stack buffer
+	char buf[16384];
+	ssize_t result = ::pread(fileFd, buf, std::min(len, sizeof(buf)), offset);
+	if (result > 0) {
+		result = ::write(fd, buf, static_cast<size_t>(result));
+	}
+#endif
+	if (result == 0 && len > 0U) {
+		// File is shorter than the range
+		errno = EIO;
+		return -1;
+	}
+	return result;
+}
+
+} // anonymous namespace
+
+FilePacket::FilePacket() :
+	_buffer(0),
+	_bufferUsed(0U),
+	_bufferCapacity(0U),
+	_parts(),
+	_first(0U),
+	_size(0U)
+{}
+
+FilePacket::~FilePacket()
+{
+	delete [] _buffer;
+}
+
+void FilePacket::append(const void * buf, size_t len)
+{
+	if (len > 0U) {
+		memcpy(reserve(len), buf, len);
+	}
+}
+
+char * FilePacket::reserve(size_t len)
+{
+	if (_bufferUsed + len > _bufferCapacity) {
+		// Parts refer to the offsets, so the buffer could be moved
+		size_t capacity = std::max(std::max(_bufferCapacity * 2U, _bufferUsed + len), InitialBufferSize);
+		char * buffer = new char[capacity];
+		if (_bufferUsed > 0U) {
+			memcpy(buffer, _buffer, _bufferUsed);
+		}
+		delete [] _buffer;
+		_buffer = buffer;
+		_bufferCapacity = capacity;
+	}
+	// Memory parts are adjacent in the buffer unless a partially sent one is followed
+	if (_parts.size() > _first && _parts.back().fd < 0 &&
+			static_cast<size_t>(_parts.back().offset) + _parts.back().length == _bufferUsed) {
+		_parts.back().length += len;
+	} else {
+		Part part = { -1, static_cast<off_t>(_bufferUsed), len };
+		_parts.push_back(part);
+	}
+	char * result = _buffer + _bufferUsed;
+	_bufferUsed += len;
+	_size += len;
+	return result;
+}
+
+void FilePacket::appendFile(int fd, off_t offset, size_t len)
+{
+	if (len <= 0U) {
+		return;
+	}
+	Part part = { fd, offset, len };
+	_parts.push_back(part);
+	_size += len;
+}
+
+ssize_t FilePacket::send(int fd)
+{
+	size_t sent = 0U;
+	while (_first < _parts.size()) {
+		const Part& part = _parts[_first];
+		ssize_t result;
+		if (part.fd < 0) {
+			bool more = _first + 1U < _parts.size();
+			result = sendMemory(fd, _buffer + part.offset, part.length, more);
+		} else {
+			result = sendFile(fd, part.fd, part.offset, part.length);
+		}
+		if (result < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return sent > 0U ? static_cast<ssize_t>(sent) : -1;
+		}
+		consume(static_cast<size_t>(result));
+		sent += static_cast<size_t>(result);
+	}
+	return static_cast<ssize_t>(sent);
+}
+
+void FilePacket::clear()
+{
+	_bufferUsed = 0U;
+	_parts.clear();
+	_first = 0U;
+	_size = 0U;
+}
+
+void FilePacket::consume(size_t len)
+{
+	_size -= len;
+	while (len > 0U) {
+		Part& part = _parts[_first];
+		if (len < part.length) {
+			part.offset += static_cast<off_t>(len);
+			part.length -= len;
+			return;
+		}
+		len -= part.length;
+		++_first;
+	}
+	if (_first >= _parts.size()) {
+		clear();
+	}
+}
+
+} // namespace httpxx
@@ -0,0 +1,126 @@
+#include <httpxx/header_ids.h>
+#include <httpxx/char_utils.h>
+
+namespace {
+
+struct HeaderName
+{
+	const char * name;
+	size_t len;
+};
+
+// Indexed by HeaderId
+const HeaderName HeaderNames[] = {
+	{ "", 0 },
+	{ "Accept", 6 },
+	{ "Accept-Charset", 14 },
+	{ "Accept-Encoding", 15 },
+	{ "Accept-Language", 15 },
+	{ "Accept-Ranges", 13 },
+	{ "Access-Control-Allow-Origin", 27 },
+	{ "Age", 3 },
+	{ "Allow", 5 },
+	{ "Authorization", 13 },
+	{ "Cache-Control", 13 },
+	{ "Connection", 10 },
+	{ "Content-Disposition", 19 },
+	{ "Content-Encoding", 16 },
+	{ "Content-Language", 16 },
+	{ "Content-Length", 14 },
+	{ "Content-Location", 16 },
+	{ "Content-Range", 13 },
+	{ "Content-Type", 12 },
+	{ "Cookie", 6 },
+	{ "Date", 4 },
+	{ "ETag", 4 },
+	{ "Expect", 6 },
+	{ "Expires", 7 },
+	{ "From", 4 },
+	{ "Host", 4 },
+	{ "If-Match", 8 },
+	{ "If-Modified-Since", 17 },
+	{ "If-None-Match", 13 },
+	{ "If-Range", 8 },
+	{ "If-Unmodified-Since", 19 },
+	{ "Keep-Alive", 10 },
+	{ "Last-Modified", 13 },
+	{ "Location", 8 },
+	{ "Max-Forwards", 12 },
+	{ "Origin", 6 },
+	{ "Pragma", 6 },
+	{ "Proxy-Authenticate", 18 },
+	{ "Proxy-Authorization", 19 },
+	{ "Proxy-Connection", 16 },
+	{ "Range", 5 },
+	{ "Referer", 7 },
+	{ "Retry-After", 11 },
+	{ "Server", 6 },
+	{ "Set-Cookie", 10 },
+	{ "TE", 2 },
+	{ "Trailer", 7 },
+	{ "Transfer-Encoding", 17 },
+	{ "Upgrade", 7 },
+	{ "User-Agent", 10 },
+	{ "Vary", 4 },
+	{ "Via", 3 },
+	{ "Warning", 7 },
+	{ "WWW-Authenticate", 16 },
+	{ "X-Forwarded-For", 15 },
+	{ "X-Forwarded-Proto", 17 },
+	{ "X-Real-IP", 9 },
+};
+
+// Perfect hash table: { hash => HeaderId }, hash function multipliers are chosen to have no collisions
+const unsigned char HeaderIdsTable[256] = {
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 37,  0, 53,  0,  0,
+	 0, 41,  0,  0,  0,  0,  0, 16,  0,  0,  0, 46,  0, 43,  0,  0,
+	 0, 56,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0, 12,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 49,  0, 34,  0,
+	39,  0,  0, 50,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0, 38,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 55,  0,  0,
+	 0,  0,  0,  0,  0,  7,  0,  0,  0,  6,  0,  0,  0,  0,  0,  0,
+	54,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0, 21,  0, 20,  0,  0,  0, 19,  0,  0, 51,  0,  0,  0, 36,  0,
+	 0,  0,  0,  0, 45,  0,  0,  0,  0,  0,  0,  0,  0,  0, 15, 29,
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 40,
+	 0,  0,  0,  0, 26, 31,  0,  0,  0,  0,  0,  0, 24,  0,  0,  0,
+	18,  0,  0,  0,  0,  0,  0,  0, 17,  0,  4,  0, 48,  0,  0,  0,
+	 0,  3,  0,  0,  0,  0,  0, 32, 14,  0,  0, 44, 52,  5, 11, 13,
+	28,  0, 47,  0,  1,  0, 35,  0, 10,  0,  0,  0,  0,  0,  0, 27,
+	22,  0,  0,  0,  0, 23,  9, 25,  8, 42, 33,  0, 30,  0,  0,  0,
+};
+
+// ASCII letters are the only characters to be case-folded in the well-known header names
+inline unsigned char fold(char ch)
+{
+	return static_cast<unsigned char>(ch) | 0x20U;
+}
+
+inline size_t hash(const char * name, size_t len)
+{
+	return (len * 8U + fold(name[0]) * 3U + fold(name[len - 1U]) * 7U + fold(name[len >> 1])) & 0xFFU;
+}
+
+}
+
+namespace httpxx
+{
+
+HeaderId headerId(const char * name, size_t len)
+{
+	if (len < 2U || len > MaxKnownHeaderNameLength) {
+		return UnknownHeaderId;
+	}
+	HeaderId id = static_cast<HeaderId>(HeaderIdsTable[hash(name, len)]);
+	if (id == UnknownHeaderId || HeaderNames[id].len != len || !equalsIgnoreCase(name, HeaderNames[id].name, len)) {
+		return UnknownHeaderId;
+	}
+	return id;
+}
+
+const char * headerName(HeaderId id)
+{
+	return id < HeaderIdsAmount ? HeaderNames[id].name : "";
+}
+
+} // namespace httpxx
@@ -0,0 +1,363 @@
+#include <httpxx/headers.h>
+#include <httpxx/char_utils.h>
+#include <algorithm>
+#include <cstring>
+
+namespace httpxx
+{
+
+namespace {
+
+const size_t NoIndex = static_cast<size_t>(-1);
+
+inline bool equalsIgnoreCase(const StringView& lhs, const StringView& rhs)
+{
+	return lhs.size() == rhs.size() && httpxx::equalsIgnoreCase(lhs.data(), rhs.data(), lhs.size());
+}
+
+inline bool equals(const StringView& lhs, const StringView& rhs)
+{
+	return lhs.size() == rhs.size() && memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+inline HeaderId headerId(const StringView& name)
+{
+	return httpxx::headerId(name.data(), name.size());
+}
+
+// Moves view into the new arena if it points into the old one
+inline void rebase(StringView& view, const char * oldArena, size_t oldArenaUsed, const char * newArena)
+{
+	if (view.data() >= oldArena && view.data() < oldArena + oldArenaUsed) {
+		view = StringView(newArena + (view.data() - oldArena), view.size());
+	}
+}
+
+} // anonymous namespace
+
+Headers::Headers() :
+	_headers(_inlineHeaders),
+	_size(0U),
+	_capacity(InlineHeadersAmount),
+	_arena(_inlineArena),
+	_arenaUsed(0U),
+	_arenaCapacity(InlineArenaSize),
+	_index(),
+	_inlineHeaders(),
+	_inlineArena()
+{
+	std::fill(_index, _index + HeaderIdsAmount, NoIndex);
+}
+
+Headers::Headers(const Headers& other) :
+	_headers(_inlineHeaders),
+	_size(0U),
+	_capacity(InlineHeadersAmount),
+	_arena(_inlineArena),
+	_arenaUsed(0U),
+	_arenaCapacity(InlineArenaSize),
+	_index(),
+	_inlineHeaders(),
+	_inlineArena()
+{
+	std::fill(_index, _index + HeaderIdsAmount, NoIndex);
+	copyFrom(other);
+}
+
+Headers::~Headers()
+{
+	if (_headers != _inlineHeaders) {
+		delete [] _headers;
+	}
+	if (_arena != _inlineArena) {
+		delete [] _arena;
+	}
+}
+
+Headers& Headers::operator=(const Headers& other)
+{
+	if (&other != this) {
+		clear();
+		copyFrom(other);
+	}
+	return *this;
+}
+
+Headers::iterator Headers::insert(iterator position, const value_type& header)
+{
+	size_type pos = position - _headers;
+	// Header could refer to the own headers or arena, so it is copied first
+	value_type h(header);
+	char * p = allocate(h.first.size() + h.second.size(), h);
+	if (!h.first.empty()) {
+		memcpy(p, h.first.data(), h.first.size());
+	}
+	if (!h.second.empty()) {
+		memcpy(p + h.first.size(), h.second.data(), h.second.size());
+	}
+	h.first = StringView(p, h.first.size());
+	h.second = StringView(p + h.first.size(), h.second.size());
+	reserveHeaders(_size + 1U);
+	std::copy_backward(_headers + pos, _headers + _size, _headers + _size + 1U);
+	_headers[pos] = h;
+	for (size_t i = 0U; i < HeaderIdsAmount; ++i) {
+		if (_index[i] >= pos && _index[i] < _size) {
+			++_index[i];
+		}
+	}
+	++_size;
+	HeaderId id = headerId(h.first);
+	if (id != UnknownHeaderId && _index[id] > pos) {
+		_index[id] = pos;
+	}
+	return _headers + pos;
+}
+
+void Headers::erase(iterator position)
+{
+	size_type pos = position - _headers;
+	HeaderId id = headerId(position->first);
+	std::copy(_headers + pos + 1U, _headers + _size, _headers + pos);
+	--_size;
+	for (size_t i = 0U; i < HeaderIdsAmount; ++i) {
+		if (_index[i] > pos && _index[i] <= _size) {
+			--_index[i];
+		}
+	}
+	if (id != UnknownHeaderId && _index[id] == pos) {
+		_index[id] = NoIndex;
+		for (size_type i = pos; i < _size; ++i) {
+			if (headerId(_headers[i].first) == id) {
+				_index[id] = i;
+				break;
+			}
+		}
+	}
+	if (_size <= 0U) {
+		_arenaUsed = 0U;
+	}
+}
+
+Headers::size_type Headers::erase(const StringView& name)
+{
+	HeaderId id = headerId(name);
+	if (id != UnknownHeaderId) {
+		return erase(id);
+	}
+	size_type last = 0U;
+	for (size_type i = 0U; i < _size; ++i) {
+		if (!equalsIgnoreCase(_headers[i].first, name)) {
+			_headers[last++] = _headers[i];
+		}
+	}
+	size_type result = _size - last;
+	if (result > 0U) {
+		_size = last;
+		rebuildIndex();
+	}
+	return result;
+}
+
+Headers::size_type Headers::erase(HeaderId id)
+{
+	if (_index[id] >= _size) {
+		return 0U;
+	}
+	size_type last = _index[id];
+	for (size_type i = _index[id]; i < _size; ++i) {
+		if (headerId(_headers[i].first) != id) {
+			_headers[last++] = _headers[i];
+		}
+	}
+	size_type result = _size - last;
+	_size = last;
+	rebuildIndex();
+	return result;
+}
+
+void Headers::erase(iterator first, iterator last)
+{
+	std::copy(last, end(), _headers + (first - _headers));
+	_size -= last - first;
+	rebuildIndex();
+}
+
+void Headers::clear()
+{
+	// Allocated storage is kept to be reused by the next headers
+	_size = 0U;
+	_arenaUsed = 0U;
+	std::fill(_index, _index + HeaderIdsAmount, NoIndex);
+}
+
+void Headers::swap(Headers& other)
+{
+	if (_headers != _inlineHeaders && _arena != _inlineArena &&
+			other._headers != other._inlineHeaders && other._arena != other._inlineArena) {
+		std::swap(_headers, other._headers);
+		std::swap(_size, other._size);
+		std::swap(_capacity, other._capacity);
+		std::swap(_arena, other._arena);
+		std::swap(_arenaUsed, other._arenaUsed);
+		std::swap(_arenaCapacity, other._arenaCapacity);
+		std::swap_ranges(_index, _index + HeaderIdsAmount, other._index);
+	} else {
+		// Inline storage could not be exchanged without copying
+		Headers tmp(other);
+		other = *this;
+		*this = tmp;
+	}
+}
+
+void Headers::take(Headers& other)
+{
+	if (&other == this) {
+		return;
+	}
+	clear();
+	const char * otherArena = other._arena;
+	if (other._arena != other._inlineArena) {
+		if (_arena != _inlineArena) {
+			std::swap(_arena, other._arena);
+			std::swap(_arenaCapacity, other._arenaCapacity);
+		} else {
+			_arena = other._arena;
+			_arenaCapacity = other._arenaCapacity;
+			other._arena = other._inlineArena;
+			other._arenaCapacity = InlineArenaSize;
+		}
+	} else if (other._arenaUsed > 0U) {
+		// Inline storage fits the storage of any headers
+		memcpy(_arena, other._arena, other._arenaUsed);
+	}
+	_arenaUsed = other._arenaUsed;
+	if (other._headers != other._inlineHeaders) {
+		if (_headers != _inlineHeaders) {
+			std::swap(_headers, other._headers);
+			std::swap(_capacity, other._capacity);
+		} else {
+			_headers = other._headers;
+			_capacity = other._capacity;
+			other._headers = other._inlineHeaders;
+			other._capacity = InlineHeadersAmount;
+		}
+	} else {
+		std::copy(other._headers, other._headers + other._size, _headers);
+	}
+	_size = other._size;
+	if (_arena != otherArena) {
+		for (size_type i = 0U; i < _size; ++i) {
+			rebase(_headers[i].first, otherArena, _arenaUsed, _arena);
+			rebase(_headers[i].second, otherArena, _arenaUsed, _arena);
+		}
+	}
+	std::copy(other._index, other._index + HeaderIdsAmount, _index);
+	other.clear();
+}
+
+Headers::const_iterator Headers::find(const StringView& name) const
+{
+	HeaderId id = headerId(name);
+	if (id != UnknownHeaderId) {
+		return find(id);
+	}
+	for (const_iterator i = begin(); i != end(); ++i) {
+		if (equalsIgnoreCase(i->first, name)) {
+			return i;
+		}
+	}
+	return end();
+}
+
+bool Headers::have(HeaderId id, const StringView& value) const
+{
+	for (size_type i = _index[id]; i < _size; ++i) {
+		if (equals(_headers[i].second, value) && headerId(_headers[i].first) == id) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool Headers::have(const StringView& name, const StringView& value) const
+{
+	HeaderId id = headerId(name);
+	if (id != UnknownHeaderId) {
+		return have(id, value);
+	}
+	for (const_iterator i = begin(); i != end(); ++i) {
+		if (equals(i->second, value) && equalsIgnoreCase(i->first, name)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void Headers::copyFrom(const Headers& other)
+{
+	reserveHeaders(other._size);
+	size_t arenaSize = 0U;
+	for (const_iterator i = other.begin(); i != other.end(); ++i) {
+		arenaSize += i->first.size() + i->second.size();
+	}
+	value_type none;
+	allocate(arenaSize, none);
+	_arenaUsed = 0U;
+	for (const_iterator i = other.begin(); i != other.end(); ++i) {
+		insert(end(), *i);
+	}
+}
+
+void Headers::reserveHeaders(size_type amount)
+{
+	if (amount <= _capacity) {
+		return;
+	}
+	size_type capacity = std::max(_capacity * 2U, amount);
+	value_type * headers = new value_type[capacity];
+	std::copy(_headers, _headers + _size, headers);
+	if (_headers != _inlineHeaders) {
+		delete [] _headers;
+	}
+	_headers = headers;
+	_capacity = capacity;
+}
+
+char * Headers::allocate(size_t len, value_type& header)
+{
+	if (_arenaUsed + len > _arenaCapacity) {
+		size_t capacity = std::max(_arenaCapacity * 2U, _arenaUsed + len);
+		char * arena = new char[capacity];
+		memcpy(arena, _arena, _arenaUsed);
+		for (size_type i = 0U; i < _size; ++i) {
+			rebase(_headers[i].first, _arena, _arenaUsed, arena);
+			rebase(_headers[i].second, _arena, _arenaUsed, arena);
+		}
+		rebase(header.first, _arena, _arenaUsed, arena);
+		rebase(header.second, _arena, _arenaUsed, arena);
+		if (_arena != _inlineArena) {
+			delete [] _arena;
+		}
+		_arena = arena;
+		_arenaCapacity = capacity;
+	}
+	char * result = _arena + _arenaUsed;
+	_arenaUsed += len;
+	return result;
+}
+
+void Headers::rebuildIndex()
+{
+	std::fill(_index, _index + HeaderIdsAmount, NoIndex);
+	for (size_type i = 0U; i < _size; ++i) {
+		HeaderId id = headerId(_headers[i].first);
+		if (id != UnknownHeaderId && _index[id] == NoIndex) {
+			_index[id] = i;
+		}
+	}
+	if (_size <= 0U) {
+		_arenaUsed = 0U;
+	}
+}
+
+} // namespace httpxx
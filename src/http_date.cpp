@@ -0,0 +1,259 @@
+#include <httpxx/http_date.h>
+#include <httpxx/char_utils.h>
+#include <cstring>
+#include <stdint.h>
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+#if defined(__GNUC__)
+#define HTTPXX_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define HTTPXX_THREAD_LOCAL __declspec(thread)
+#else
+// No thread-local storage: the cache is shared by the threads
+#define HTTPXX_THREAD_LOCAL
+#endif
+
+namespace httpxx
+{
+
+namespace {
+
+const char * const DayNames[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+const char * const LongDayNames[] = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
+const char * const MonthNames[] = {
+	"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+};
+
+const int64_t SecondsPerDay = 86400;
+
+// Days since 1970-01-01 of the proleptic Gregorian date (month is 1..12)
+int64_t daysFromCivil(int64_t year, unsigned int month, unsigned int day)
+{
+	year -= month <= 2U ? 1 : 0;
+	int64_t era = (year >= 0 ? year : year - 399) / 400;
+	unsigned int yearOfEra = static_cast<unsigned int>(year - era * 400);
+	unsigned int dayOfYear = (153U * (month > 2U ? month - 3U : month + 9U) + 2U) / 5U + day - 1U;
+	unsigned int dayOfEra = yearOfEra * 365U + yearOfEra / 4U - yearOfEra / 100U + dayOfYear;
+	return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+// Proleptic Gregorian date of the days since 1970-01-01
+void civilFromDays(int64_t days, int64_t& year, unsigned int& month, unsigned int& day)
+{
+	days += 719468;
+	int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+	unsigned int dayOfEra = static_cast<unsigned int>(days - era * 146097);
+	unsigned int yearOfEra = (dayOfEra - dayOfEra / 1460U + dayOfEra / 36524U - dayOfEra / 146096U) / 365U;
+	unsigned int dayOfYear = dayOfEra - (365U * yearOfEra + yearOfEra / 4U - yearOfEra / 100U);
+	unsigned int mp = (5U * dayOfYear + 2U) / 153U;
+	day = dayOfYear - (153U * mp + 2U) / 5U + 1U;
+	month = mp < 10U ? mp + 3U : mp - 9U;
+	year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2U ? 1 : 0);
+}
+
+inline bool isLeapYear(int64_t year)
+{
+	return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+inline unsigned int daysInMonth(int64_t year, unsigned int month)
+{
+	static const unsigned int Days[] = { 31U, 28U, 31U, 30U, 31U, 30U, 31U, 31U, 30U, 31U, 30U, 31U };
+	return month == 2U && isLeapYear(year) ? 29U : Days[month - 1U];
+}
+
+inline void formatTwoDigits(unsigned int value, char * buf)
+{
+	buf[0] = static_cast<char>('0' + value / 10U);
+	buf[1] = static_cast<char>('0' + value % 10U);
+}
+
+// Sequential parser of the date fields
+class DateReader
+{
+public:
+	DateReader(const char * buf, size_t len) :
+		_pos(buf),
+		_end(buf + len)
+	{}
+
+	inline bool atEnd() const
+	{
+		return _pos == _end;
+	}
+	inline bool skip(char ch)
+	{
+		if (_pos == _end || *_pos != ch) {
+			return false;
+		}
+		++_pos;
+		return true;
+	}
+	inline bool skip(const char * str, size_t len)
+	{
+		if (static_cast<size_t>(_end - _pos) < len || memcmp(_pos, str, len) != 0) {
+			return false;
+		}
+		_pos += len;
+		return true;
+	}
+	// Reads one of the names (case-sensitive as HTTP-date is) and returns it's index
+	bool readName(const char * const * names, size_t amount, unsigned int& index)
+	{
+		for (size_t i = 0U; i < amount; ++i) {
+			if (skip(names[i], strlen(names[i]))) {
+				index = static_cast<unsigned int>(i);
+				return true;
+			}
+		}
+		return false;
+	}
+	bool readDigits(size_t amount, unsigned int& value)
+	{
+		if (static_cast<size_t>(_end - _pos) < amount) {
+			return false;
+		}
+		value = 0U;
+		for (size_t i = 0U; i < amount; ++i, ++_pos) {
+			if (!isDigit(*_pos)) {
+				return false;
+			}
+			value = value * 10U + static_cast<unsigned int>(*_pos - '0');
+		}
+		return true;
+	}
+	// Reads "HH:MM:SS"
+	bool readTime(unsigned int& hour, unsigned int& minute, unsigned int& second)
+	{
+		return readDigits(2U, hour) && skip(':') && readDigits(2U, minute) && skip(':') &&
+			readDigits(2U, second) && hour < 24U && minute < 60U && second <= 60U;
+	}
+private:
+	const char * _pos;
+	const char * _end;
+};
+
+struct DateCache
+{
+	time_t time;
+	char date[HttpDateLength + 1U];
+};
+
+HTTPXX_THREAD_LOCAL DateCache currentDate = { static_cast<time_t>(-1), { 0 } };
+
+inline time_t now()
+{
+#if defined(__linux__) && defined(CLOCK_REALTIME_COARSE)
+	// Coarse clock is read from vDSO without the timer access
+	struct timespec ts;
+	if (clock_gettime(CLOCK_REALTIME_COARSE, &ts) == 0) {
+		return ts.tv_sec;
+	}
+#endif
+	return time(0);
+}
+
+} // anonymous namespace
+
+size_t formatHttpDate(time_t time, char * buf)
+{
+	int64_t seconds = static_cast<int64_t>(time);
+	int64_t days = (seconds >= 0 ? seconds : seconds - (SecondsPerDay - 1)) / SecondsPerDay;
+	unsigned int secondOfDay = static_cast<unsigned int>(seconds - days * SecondsPerDay);
+	int64_t year;
+	unsigned int month;
+	unsigned int day;
+	civilFromDays(days, year, month, day);
+	// 1970-01-01 is Thursday
+	int64_t weekday = (days + 4) % 7;
+	memcpy(buf, DayNames[weekday >= 0 ? weekday : weekday + 7], 3U);
+	memcpy(buf + 3U, ", ", 2U);
+	formatTwoDigits(day, buf + 5U);
+	buf[7] = ' ';
+	memcpy(buf + 8U, MonthNames[month - 1U], 3U);
+	buf[11] = ' ';
+	unsigned int fourDigitYear = static_cast<unsigned int>(year < 0 ? 0 : (year > 9999 ? 9999 : year));
+	formatTwoDigits(fourDigitYear / 100U, buf + 12U);
+	formatTwoDigits(fourDigitYear % 100U, buf + 14U);
+	buf[16] = ' ';
+	formatTwoDigits(secondOfDay / 3600U, buf + 17U);
+	buf[19] = ':';
+	formatTwoDigits(secondOfDay / 60U % 60U, buf + 20U);
+	buf[22] = ':';
+	formatTwoDigits(secondOfDay % 60U, buf + 23U);
+	memcpy(buf + 25U, " GMT", 4U);
+	return HttpDateLength;
+}
+
+bool parseHttpDate(const char * buf, size_t len, time_t& result)
+{
+	DateReader reader(buf, len);
+	unsigned int weekday;
+	unsigned int day;
+	unsigned int monthIndex;
+	unsigned int year;
+	unsigned int hour;
+	unsigned int minute;
+	unsigned int second;
+	if (reader.readName(LongDayNames, sizeof(LongDayNames) / sizeof(LongDayNames[0]), weekday)) {
+		// RFC 850: "Sunday, 06-Nov-94 08:49:37 GMT"
+		if (!reader.skip(", ", 2U) || !reader.readDigits(2U, day) || !reader.skip('-') ||
+				!reader.readName(MonthNames, 12U, monthIndex) || !reader.skip('-') ||
+				!reader.readDigits(2U, year) || !reader.skip(' ') ||
+				!reader.readTime(hour, minute, second) || !reader.skip(" GMT", 4U)) {
+			return false;
+		}
+		year += year < 70U ? 2000U : 1900U;
+	} else if (reader.readName(DayNames, sizeof(DayNames) / sizeof(DayNames[0]), weekday)) {
+		if (reader.skip(',')) {
+			// IMF-fixdate: "Sun, 06 Nov 1994 08:49:37 GMT"
+			if (!reader.skip(' ') || !reader.readDigits(2U, day) || !reader.skip(' ') ||
+					!reader.readName(MonthNames, 12U, monthIndex) || !reader.skip(' ') ||
+					!reader.readDigits(4U, year) || !reader.skip(' ') ||
+					!reader.readTime(hour, minute, second) || !reader.skip(" GMT", 4U)) {
+				return false;
+			}
+		} else {
+			// asctime(): "Sun Nov  6 08:49:37 1994"
+			if (!reader.skip(' ') || !reader.readName(MonthNames, 12U, monthIndex) || !reader.skip(' ')) {
+				return false;
+			}
+			if (reader.skip(' ')) {
+				if (!reader.readDigits(1U, day)) {
+					return false;
+				}
+			} else if (!reader.readDigits(2U, day)) {
+				return false;
+			}
+			if (!reader.skip(' ') || !reader.readTime(hour, minute, second) || !reader.skip(' ') ||
+					!reader.readDigits(4U, year)) {
+				return false;
+			}
+		}
+	} else {
+		return false;
+	}
+	if (!reader.atEnd() || day < 1U || day > daysInMonth(year, monthIndex + 1U)) {
+		return false;
+	}
+	// Leap second is folded into the next one
+	int64_t seconds = daysFromCivil(year, monthIndex + 1U, day) * SecondsPerDay +
+		static_cast<int64_t>(hour * 3600U + minute * 60U + second);
+	result = static_cast<time_t>(seconds);
+	return static_cast<int64_t>(result) == seconds;
+}
+
+const char * currentHttpDate()
+{
+	time_t time = now();
+	if (time != currentDate.time) {
+		formatHttpDate(time, currentDate.date);
+		currentDate.date[HttpDateLength] = '\0';
+		currentDate.time = time;
+	}
+	return currentDate.date;
+}
+
+} // namespace httpxx
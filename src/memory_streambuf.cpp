@@ -0,0 +1,137 @@
+#include <httpxx/memory_streambuf.h>
+#include <algorithm>
+#include <cstring>
+
+namespace httpxx
+{
+
+MemoryStreambuf::MemoryStreambuf(size_t segmentSize) :
+	std::streambuf(),
+	_buffer(0),
+	_bufferLen(0U),
+	_arena(segmentSize > 0U ? segmentSize : 1U),
+	_packet(),
+	_inArena(false)
+{}
+
+MemoryStreambuf::MemoryStreambuf(void * buffer, size_t len, size_t segmentSize) :
+	std::streambuf(),
+	_buffer(static_cast<char *>(buffer)),
+	_bufferLen(len),
+	_arena(segmentSize > 0U ? segmentSize : 1U),
+	_packet(),
+	_inArena(false)
+{
+	setp(_buffer, _buffer + _bufferLen);
+}
+
+ScatterPacket& MemoryStreambuf::packet()
+{
+	flushPutArea();
+	return _packet;
+}
+
+size_t MemoryStreambuf::copy(void * buf, size_t len) const
+{
+	char * p = static_cast<char *>(buf);
+	size_t copied = _packet.copy(p, len);
+	size_t part = std::min(static_cast<size_t>(pptr() - pbase()), len - copied);
+	if (part > 0U) {
+		memcpy(p + copied, pbase(), part);
+		copied += part;
+	}
+	return copied;
+}
+
+std::string MemoryStreambuf::str() const
+{
+	std::string result(size(), '\0');
+	if (!result.empty()) {
+		copy(&result[0], result.size());
+	}
+	return result;
+}
+
+void MemoryStreambuf::clear()
+{
+	_packet.clear();
+	_arena.reset();
+	_inArena = false;
+	setp(_buffer, _buffer + _bufferLen);
+}
+
+MemoryStreambuf::int_type MemoryStreambuf::overflow(int_type ch)
+{
+	if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+		nextSegment(1U);
+		*pptr() = traits_type::to_char_type(ch);
+		pbump(1);
+	}
+	return traits_type::not_eof(ch);
+}
+
+std::streamsize MemoryStreambuf::xsputn(const char_type * s, std::streamsize n)
+{
+	size_t len = static_cast<size_t>(n);
+	while (len > 0U) {
+		size_t available = static_cast<size_t>(epptr() - pptr());
+		if (available <= 0U) {
+			// The rest of the write goes into a single segment
+			nextSegment(len);
+			continue;
+		}
+		size_t part = std::min(available, len);
+		traits_type::copy(pptr(), s, part);
+		pbump(static_cast<int>(part));
+		s += part;
+		len -= part;
+	}
+	return n;
+}
+
+MemoryStreambuf::pos_type MemoryStreambuf::seekoff(off_type off, std::ios_base::seekdir way,
+		std::ios_base::openmode which)
+{
+	// Only tellp() is supported
+	if (off == 0 && way == std::ios_base::cur && (which & std::ios_base::out)) {
+		return pos_type(static_cast<off_type>(size()));
+	}
+	return pos_type(off_type(-1));
+}
+
+void MemoryStreambuf::flushPutArea()
+{
+	size_t len = static_cast<size_t>(pptr() - pbase());
+	if (len > 0U) {
+		_packet.append(pbase(), len);
+		if (_inArena) {
+			_arena.commit(len);
+		}
+	}
+	setp(pptr(), epptr());
+}
+
+void MemoryStreambuf::nextSegment(size_t len)
+{
+	flushPutArea();
+	// The rest of the current arena block is used unless the data does not fit it
+	char * segment = _arena.reserve(len);
+	setp(segment, segment + _arena.available());
+	_inArena = true;
+}
+
+MemoryOStream::MemoryOStream(size_t segmentSize) :
+	std::ostream(0),
+	_streambuf(segmentSize)
+{
+	std::ostream::rdbuf(&_streambuf);
+}
+
+MemoryOStream::MemoryOStream(void * buffer, size_t len, size_t segmentSize) :
+	std::ostream(0),
+	_streambuf(buffer, len, segmentSize)
+{
+	std::ostream::rdbuf(&_streambuf);
+}
+
+} // namespace httpxx
@@ -0,0 +1,111 @@
+#include <httpxx/message_batch_composer.h>
+#include <algorithm>
+#include <cstring>
+
+namespace httpxx
+{
+
+MessageBatchComposer::MessageBatchComposer(size_t copyThreshold) :
+	_copyThreshold(copyThreshold),
+	_buffer(0),
+	_bufferUsed(0U),
+	_bufferCapacity(0U),
+	_parts(),
+	_referencesAmount(0U),
+	_messagesAmount(0U),
+	_size(0U),
+	_packet()
+{}
+
+MessageBatchComposer::~MessageBatchComposer()
+{
+	delete [] _buffer;
+}
+
+void MessageBatchComposer::add(MessageComposer& composer, const Headers& headers, const void * payload,
+		size_t payloadLen)
+{
+	size_t envelopeSize = composer.envelopeSize(headers, payloadLen);
+	char * envelope = reserve(envelopeSize);
+	composer.composeEnvelope(envelope, envelopeSize, headers, payloadLen);
+	addPayload(payload, payloadLen);
+	++_messagesAmount;
+}
+
+void MessageBatchComposer::add(const ResponseTemplate& responseTemplate, const void * payload, size_t payloadLen,
+		const char * date)
+{
+	size_t envelopeSize = responseTemplate.envelopeSize(payloadLen);
+	char * envelope = reserve(envelopeSize);
+	responseTemplate.composeEnvelope(envelope, envelopeSize, payloadLen, date);
+	addPayload(payload, payloadLen);
+	++_messagesAmount;
+}
+
+void MessageBatchComposer::append(const void * buf, size_t len)
+{
+	addPayload(buf, len);
+}
+
+ScatterPacket& MessageBatchComposer::packet()
+{
+	// Copied parts are adjacent in the output buffer, so the packet merges them
+	_packet.clear();
+	for (Parts::const_iterator i = _parts.begin(); i != _parts.end(); ++i) {
+		_packet.append(i->data != 0 ? i->data : _buffer + i->offset, i->length);
+	}
+	return _packet;
+}
+
+void MessageBatchComposer::clear()
+{
+	_bufferUsed = 0U;
+	_parts.clear();
+	_referencesAmount = 0U;
+	_messagesAmount = 0U;
+	_size = 0U;
+	_packet.clear();
+}
+
+char * MessageBatchComposer::reserve(size_t len)
+{
+	if (_bufferUsed + len > _bufferCapacity) {
+		// Parts refer to the offsets, so the buffer could be moved
+		size_t capacity = std::max(std::max(_bufferCapacity * 2U, _bufferUsed + len),
+				static_cast<size_t>(InitialBufferSize));
+		char * buffer = new char[capacity];
+		if (_bufferUsed > 0U) {
+			memcpy(buffer, _buffer, _bufferUsed);
+		}
+		delete [] _buffer;
+		_buffer = buffer;
+		_bufferCapacity = capacity;
+	}
+	if (!_parts.empty() && _parts.back().data == 0) {
+		_parts.back().length += len;
+	} else {
+		Part part = { 0, _bufferUsed, len };
+		_parts.push_back(part);
+	}
+	char * result = _buffer + _bufferUsed;
+	_bufferUsed += len;
+	_size += len;
+	return result;
+}
+
+void MessageBatchComposer::addPayload(const void * payload, size_t payloadLen)
+{
+	if (payloadLen <= 0U) {
+		return;
+	}
+	if (payloadLen <= _copyThreshold) {
+		memcpy(reserve(payloadLen), payload, payloadLen);
+		return;
+	}
+	Part part = { static_cast<const char *>(payload), 0U, payloadLen };
+	_parts.push_back(part);
+	++_referencesAmount;
+	_size += payloadLen;
+}
+
+} // namespace httpxx
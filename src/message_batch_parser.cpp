@@ -0,0 +1,90 @@
+#include <httpxx/message_batch_parser.h>
+
+namespace {
+
+inline void extendView(httpxx::StringView& view, const char * p, size_t len)
+{
+	// Fragments of the field are contiguous within the buffer
+	view = view.empty() ? httpxx::StringView(p, len) : httpxx::StringView(view.data(), view.size() + len);
+}
+
+}
+
+namespace httpxx
+{
+
+//------------------------------------------------------------------------------
+// MessageBatchParser
+//------------------------------------------------------------------------------
+
+MessageBatchParser::MessageBatchParser(size_t maxFirstTokenLength, size_t maxSecondTokenLength,
+		size_t maxThirdTokenLength, size_t maxHeaderNameLength, size_t maxHeaderValueLength,
+		size_t maxHeadersAmount) :
+	BasicMessageParser<MessageBatchParser>(maxFirstTokenLength, maxSecondTokenLength, maxThirdTokenLength,
+			maxHeaderNameLength, maxHeaderValueLength, maxHeadersAmount),
+	_messages(),
+	_payload(),
+	_buf(0),
+	_message()
+{}
+
+MessageBatchParser::BatchResult MessageBatchParser::parse(const void * buf, size_t bufLen)
+{
+	BatchResult result;
+	_messages.clear();
+	_payload.clear();
+	_buf = static_cast<const char *>(buf);
+	reset();
+	while (result.bytesConsumed < bufLen) {
+		_message = MessageDescriptor();
+		_message.offset = result.bytesConsumed;
+		_message.payloadBegin = _payload.size();
+		ParseResult res = tryParse(_buf + result.bytesConsumed, bufLen - result.bytesConsumed);
+		if (!res.completed) {
+			// Dropping body chunks of the incomplete message
+			_payload.resize(_message.payloadBegin);
+			result.partialState = state();
+			result.partialLength = bufLen - result.bytesConsumed;
+			result.failed = res.failed;
+			result.error = res.error;
+			break;
+		}
+		_message.length = res.bytesParsed;
+		_message.payloadEnd = _payload.size();
+		_messages.push_back(_message);
+		result.bytesConsumed += res.bytesParsed;
+	}
+	// Next batch starts from scratch
+	reset();
+	return result;
+}
+
+void MessageBatchParser::onFirstToken(const char * p, size_t len)
+{
+	extendView(_message.firstToken, p, len);
+}
+
+void MessageBatchParser::onSecondToken(const char * p, size_t len)
+{
+	extendView(_message.secondToken, p, len);
+}
+
+void MessageBatchParser::onThirdToken(const char * p, size_t len)
+{
+	extendView(_message.thirdToken, p, len);
+}
+
+void MessageBatchParser::onHeadersComplete()
+{
+	// Header section starts after the first line CRLF and ends with the current LF
+	const char * headerBegin = _message.thirdToken.data() + _message.thirdToken.size() + 2U;
+	const char * headerEnd = _buf + _message.offset + pos() + 1U;
+	_message.header = StringView(headerBegin, headerEnd - headerBegin);
+}
+
+void MessageBatchParser::onBodyData(const char * p, size_t len)
+{
+	_payload.push_back(PayloadChunk(p, len));
+}
+
+} // namespace httpxx
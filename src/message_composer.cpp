@@ -1,4 +1,10 @@
 #include <httpxx/message_composer.h>
+#include <httpxx/char_utils.h>
+#include <httpxx/file_packet.h>
+#include <httpxx/http_date.h>
+#include <httpxx/scatter_packet.h>
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 #include <stdexcept>
 
@@ -7,29 +13,315 @@ namespace httpxx
 
 namespace {
 
-static const char * ContentLengthHeader = "Content-Length";
-static const char * TransferEncodingHeader = "Transfer-Encoding";
+// Separators have static storage, so scatter-gather packets could reference them
+const char Space[] = " ";
+const char Crlf[] = "\r\n";
+const char HeaderSeparator[] = ": ";
+const char LastChunkLine[] = "\r\n0\r\n";
+const char Chunked[] = "chunked";
+const char DateHeader[] = "Date: ";
 
-inline void composeFirstLine(std::ostream& target, const std::string& firstToken,
+// Writer, which composes into the output stream
+class StreamWriter
+{
+public:
+	explicit StreamWriter(std::ostream& target) :
+		_target(target)
+	{}
+
+	inline void write(const char * buf, size_t len)
+	{
+		_target.write(buf, len);
+	}
+	inline void writeCopy(const char * buf, size_t len)
+	{
+		_target.write(buf, len);
+	}
+	inline char * scratch(size_t /* len */)
+	{
+		return _scratch;
+	}
+private:
+	std::ostream& _target;
+	char _scratch[MaxDecimalLength];
+};
+
+// Writer, which composes into the buffer while the data fits it, but counts all the data,
+// so it could be used to find out the composed size as well
+class BufferWriter
+{
+public:
+	BufferWriter(char * buf, size_t len) :
+		_buf(buf),
+		_capacity(len),
+		_size(0U)
+	{}
+
+	inline void write(const char * buf, size_t len)
+	{
+		if (len > 0U && _size + len <= _capacity) {
+			memcpy(_buf + _size, buf, len);
+		}
+		_size += len;
+	}
+	inline void writeCopy(const char * buf, size_t len)
+	{
+		write(buf, len);
+	}
+	inline char * scratch(size_t /* len */)
+	{
+		return _scratch;
+	}
+	inline size_t size() const
+	{
+		return _size;
+	}
+private:
+	char * _buf;
+	size_t _capacity;
+	size_t _size;
+	char _scratch[MaxDecimalLength];
+};
+
+// Writer, which appends the segments referencing the data to the scatter-gather packet
+class ScatterWriter
+{
+public:
+	explicit ScatterWriter(ScatterPacket& target) :
+		_target(target)
+	{}
+
+	inline void write(const char * buf, size_t len)
+	{
+		_target.append(buf, len);
+	}
+	// Copies the data, which does not outlive the composition, into the packet
+	inline void writeCopy(const char * buf, size_t len)
+	{
+		char * copy = _target.allocate(len);
+		memcpy(copy, buf, len);
+		_target.append(copy, len);
+	}
+	inline char * scratch(size_t len)
+	{
+		return _target.allocate(len);
+	}
+private:
+	ScatterPacket& _target;
+};
+
+template <class Writer>
+inline void writeString(Writer& writer, const std::string& str)
+{
+	writer.write(str.data(), str.size());
+}
+
+template <class Writer>
+inline void writeView(Writer& writer, const StringView& view)
+{
+	writer.write(view.data(), view.size());
+}
+
+// Generated data is formatted into the scratch storage of the writer, written data
+// should outlive the composition for ScatterWriter, which references it
+template <class Writer>
+inline void writeHex(Writer& writer, uint64_t value)
+{
+	char * buf = writer.scratch(MaxHexLength);
+	writer.write(buf, formatHex(value, buf));
+}
+
+template <class Writer>
+inline void composeFirstLine(Writer& writer, const std::string& firstToken,
 		const std::string& secondToken, const std::string& thirdToken)
 {
-	target << firstToken << ' ' << secondToken << ' ' << thirdToken << "\r\n";
+	writeString(writer, firstToken);
+	writer.write(Space, 1U);
+	writeString(writer, secondToken);
+	writer.write(Space, 1U);
+	writeString(writer, thirdToken);
+	writer.write(Crlf, 2U);
 }
 
-inline void composeHeader(std::ostream& target, const Headers& headers)
+template <class Writer>
+inline void composeHeader(Writer& writer, const StringView& name, const StringView& value)
+{
+	writeView(writer, name);
+	writer.write(HeaderSeparator, 2U);
+	writeView(writer, value);
+	writer.write(Crlf, 2U);
+}
+
+template <class Writer>
+void composeHeaders(Writer& writer, const Headers& headers)
 {
 	for (Headers::const_iterator i = headers.begin(); i != headers.end(); ++i) {
-		target << i->first << ": " << i->second  << "\r\n";
+		composeHeader(writer, i->first, i->second);
 	}
 }
 
+// Composes "Date" header with the current date (cached one is changed once a second)
+template <class Writer>
+inline void composeDate(Writer& writer, const char * date)
+{
+	writer.write(DateHeader, 6U);
+	writer.writeCopy(date, HttpDateLength);
+	writer.write(Crlf, 2U);
+}
+
+// Composes headers without "Content-Length" and "Transfer-Encoding" ones (and without
+// "Date" ones if the date is composed), optionally adding a framing header instead of
+// the first of them or after the rest of the headers
+template <class Writer>
+void composeFramedHeaders(Writer& writer, const Headers& headers, HeaderId framingHeader,
+		const StringView& framingValue, const char * date)
+{
+	if (date != 0) {
+		composeDate(writer, date);
+	}
+	bool framingHeaderComposed = framingHeader == UnknownHeaderId;
+	for (Headers::const_iterator i = headers.begin(); i != headers.end(); ++i) {
+		HeaderId id = headerId(i->first.data(), i->first.size());
+		if (id == DateHeaderId && date != 0) {
+			continue;
+		} else if (id == ContentLengthHeaderId || id == TransferEncodingHeaderId) {
+			if (!framingHeaderComposed) {
+				composeHeader(writer, headerName(framingHeader), framingValue);
+				framingHeaderComposed = true;
+			}
+		} else {
+			composeHeader(writer, i->first, i->second);
+		}
+	}
+	if (!framingHeaderComposed) {
+		composeHeader(writer, headerName(framingHeader), framingValue);
+	}
+}
+
+template <class Writer>
+void composeEnvelope(Writer& writer, const std::string& firstToken, const std::string& secondToken,
+		const std::string& thirdToken, const Headers& headers, const char * date, size_t payloadLen)
+{
+	composeFirstLine(writer, firstToken, secondToken, thirdToken);
+	if (payloadLen > 0U) {
+		char * buf = writer.scratch(MaxDecimalLength);
+		composeFramedHeaders(writer, headers, ContentLengthHeaderId,
+				StringView(buf, formatDecimal(payloadLen, buf)), date);
+	} else {
+		composeFramedHeaders(writer, headers, UnknownHeaderId, StringView(), date);
+	}
+	writer.write(Crlf, 2U);
+}
+
+// Composes chunked-encoded transmission envelope without the CRLF, which ends the header
+// section: it is the leading CRLF of the next or the last chunk
+template <class Writer>
+void composeChunkedEnvelope(Writer& writer, const std::string& firstToken, const std::string& secondToken,
+		const std::string& thirdToken, const Headers& headers, const char * date)
+{
+	composeFirstLine(writer, firstToken, secondToken, thirdToken);
+	composeFramedHeaders(writer, headers, TransferEncodingHeaderId, StringView(Chunked, 7U), date);
+}
+
+template <class Writer>
+void composeNextChunkEnvelope(Writer& writer, size_t payloadLen)
+{
+	if (payloadLen <= 0U) {
+		throw std::runtime_error("Could not compose envelope for empty chunk");
+	}
+	writer.write(Crlf, 2U);
+	writeHex(writer, payloadLen);
+	writer.write(Crlf, 2U);
+}
+
+template <class Writer>
+void composeFirstChunkEnvelope(Writer& writer, const std::string& firstToken, const std::string& secondToken,
+		const std::string& thirdToken, const Headers& headers, const char * date, size_t payloadLen)
+{
+	if (payloadLen <= 0U) {
+		throw std::runtime_error("Could not compose envelope for empty chunk");
+	}
+	composeChunkedEnvelope(writer, firstToken, secondToken, thirdToken, headers, date);
+	composeNextChunkEnvelope(writer, payloadLen);
+}
+
+template <class Writer>
+void composeLastChunk(Writer& writer, const Headers& headers)
+{
+	writer.write(LastChunkLine, 5U);
+	composeHeaders(writer, headers);
+	writer.write(Crlf, 2U);
+}
+
+// Returns size of the headers, which composeFramedHeaders() composes
+size_t framedHeadersSize(const Headers& headers, HeaderId framingHeader, size_t framingValueLen, bool dateComposed)
+{
+	size_t result = headers.composedSize();
+	// Skipped headers of the message could not precede the first indexed one
+	Headers::const_iterator first = std::min(headers.find(ContentLengthHeaderId),
+			headers.find(TransferEncodingHeaderId));
+	if (dateComposed) {
+		first = std::min(first, headers.find(DateHeaderId));
+		result += 6U + HttpDateLength + 2U;
+	}
+	for (Headers::const_iterator i = first; i != headers.end(); ++i) {
+		HeaderId id = headerId(i->first.data(), i->first.size());
+		if (id == ContentLengthHeaderId || id == TransferEncodingHeaderId || (id == DateHeaderId && dateComposed)) {
+			result -= i->first.size() + i->second.size() + 4U;
+		}
+	}
+	if (framingHeader != UnknownHeaderId) {
+		result += strlen(headerName(framingHeader)) + framingValueLen + 4U;
+	}
+	return result;
+}
+
+inline size_t firstLineSize(const std::string& firstToken, const std::string& secondToken,
+		const std::string& thirdToken)
+{
+	return firstToken.size() + secondToken.size() + thirdToken.size() + 4U;
+}
+
+// Returns size of the chunk size line with the CRLF, which ends the previous chunk
+inline size_t chunkEnvelopeSize(size_t payloadLen)
+{
+	return (payloadLen > 0U ? hexLength(payloadLen) : static_cast<size_t>(MaxHexLength)) + 4U;
+}
+
+void throwNotEnoughBuffer(size_t available, size_t needed)
+{
+	std::ostringstream msg;
+	msg << "Not enough buffer for envelope: " << available <<
+		" bytes available, " << needed << " bytes needed";
+	throw std::runtime_error(msg.str());
+}
+
+// Checks that the composed data has fit the buffer and returns it's size
+inline size_t composedSize(const BufferWriter& writer, size_t bufLen)
+{
+	if (writer.size() > bufLen) {
+		throwNotEnoughBuffer(bufLen, writer.size());
+	}
+	return writer.size();
+}
+
+// Returns the pointer to the envelope, which ends at the end of the envelope part of the buffer
+inline char * envelopePtr(void * buffer, size_t envelopePartLen, size_t envelopeLen)
+{
+	if (envelopeLen > envelopePartLen) {
+		throwNotEnoughBuffer(envelopePartLen, envelopeLen);
+	}
+	return static_cast<char *>(buffer) + envelopePartLen - envelopeLen;
+}
+
 } // anonymous namespace
 
 MessageComposer::MessageComposer(const std::string& firstToken, const std::string& secondToken,
 		const std::string& thirdToken) :
 	_firstToken(firstToken),
 	_secondToken(secondToken),
-	_thirdToken(thirdToken)
+	_thirdToken(thirdToken),
+	_dateComposed(false)
 {}
 
 MessageComposer::~MessageComposer()
@@ -43,153 +335,197 @@ void MessageComposer::reset(const std::string& firstToken, const std::string& se
 	_thirdToken = thirdToken;
 }
 
+void MessageComposer::setDateComposed(bool dateComposed)
+{
+	_dateComposed = dateComposed;
+}
+
 void MessageComposer::composeEnvelope(std::ostream& target, const Headers& headers, size_t payloadLen)
 {
-	Headers actualHeaders(headers);
-	actualHeaders.erase(ContentLengthHeader);
-	actualHeaders.erase(TransferEncodingHeader);
-	if (payloadLen > 0U) {
-		std::ostringstream oss;
-		oss << payloadLen;
-		actualHeaders.add(ContentLengthHeader, oss.str());
-	}
-	composeFirstLine(target, _firstToken, _secondToken, _thirdToken);
-	composeHeader(target, actualHeaders);
-	target << "\r\n";
+	StreamWriter writer(target);
+	httpxx::composeEnvelope(writer, _firstToken, _secondToken, _thirdToken, headers, composedDate(), payloadLen);
 }
 
 size_t MessageComposer::composeEnvelope(void * buffer, size_t bufLen, const Headers& headers, size_t payloadLen)
 {
-	std::ostringstream envelope;
-	composeEnvelope(envelope, headers, payloadLen);
-	if (envelope.str().size() > bufLen) {
-		std::ostringstream msg;
-		msg << "Not enough buffer for envelope: " << bufLen <<
-			" bytes available, " << envelope.str().size() << " bytes needed";
-		throw std::runtime_error(msg.str());
-	}
-	envelope.str().copy(static_cast<char *>(buffer), envelope.str().size());
-	return envelope.str().size();
+	BufferWriter writer(static_cast<char *>(buffer), bufLen);
+	httpxx::composeEnvelope(writer, _firstToken, _secondToken, _thirdToken, headers, composedDate(), payloadLen);
+	return composedSize(writer, bufLen);
+}
+
+void MessageComposer::composeEnvelope(ScatterPacket& target, const Headers& headers, size_t payloadLen)
+{
+	ScatterWriter writer(target);
+	httpxx::composeEnvelope(writer, _firstToken, _secondToken, _thirdToken, headers, composedDate(), payloadLen);
 }
 
 MessageComposer::Packet MessageComposer::prependEnvelope(void * buffer, size_t envelopePartLen,
 		const Headers& headers, size_t payloadLen)
 {
-	std::ostringstream envelope;
-	composeEnvelope(envelope, headers, payloadLen);
-	if (envelope.str().size() > envelopePartLen) {
-		std::ostringstream msg;
-		msg << "Not enough buffer for envelope: " << envelopePartLen <<
-			" bytes available, " << envelope.str().size() << " bytes needed";
-		throw std::runtime_error(msg.str());
-	}
-	char * packetPtr = static_cast<char *>(buffer) + envelopePartLen - envelope.str().size(); 
-	envelope.str().copy(packetPtr, envelope.str().size());
-	return Packet(packetPtr, envelope.str().size() + payloadLen);
+	// Envelope size is computed first to compose it right before the payload
+	size_t size = envelopeSize(headers, payloadLen);
+	char * packetPtr = envelopePtr(buffer, envelopePartLen, size);
+	BufferWriter writer(packetPtr, size);
+	httpxx::composeEnvelope(writer, _firstToken, _secondToken, _thirdToken, headers, composedDate(), payloadLen);
+	return Packet(packetPtr, size + payloadLen);
+}
+
+size_t MessageComposer::envelopeSize(const Headers& headers, size_t payloadLen)
+{
+	return firstLineSize(_firstToken, _secondToken, _thirdToken) + (payloadLen > 0U ?
+			framedHeadersSize(headers, ContentLengthHeaderId, decimalLength(payloadLen), _dateComposed) :
+			framedHeadersSize(headers, UnknownHeaderId, 0U, _dateComposed)) + 2U;
+}
+
+void MessageComposer::composeChunkedEnvelope(std::ostream& target, const Headers& headers)
+{
+	StreamWriter writer(target);
+	httpxx::composeChunkedEnvelope(writer, _firstToken, _secondToken, _thirdToken, headers, composedDate());
 }
 
 void MessageComposer::composeFirstChunkEnvelope(std::ostream& target, 
 		const Headers& headers, size_t payloadLen)
 {
-	if (payloadLen <= 0U) {
-		throw std::runtime_error("Could not compose envelope for empty chunk");
-	}
-	Headers actualHeaders(headers);
-	actualHeaders.erase(ContentLengthHeader);
-	actualHeaders.erase(TransferEncodingHeader);
-	actualHeaders.add(TransferEncodingHeader, "chunked");
-	composeFirstLine(target, _firstToken, _secondToken, _thirdToken);
-	composeHeader(target, actualHeaders);
-	target << "\r\n" << std::hex << payloadLen << "\r\n";
+	StreamWriter writer(target);
+	httpxx::composeFirstChunkEnvelope(writer, _firstToken, _secondToken, _thirdToken, headers, composedDate(), payloadLen);
 }
 
 size_t MessageComposer::composeFirstChunkEnvelope(void * buffer, size_t bufLen, const Headers& headers,
 		size_t payloadLen)
 {
-	std::ostringstream envelope;
-	composeFirstChunkEnvelope(envelope, headers, payloadLen);
-	if (envelope.str().size() > bufLen) {
-		std::ostringstream msg;
-		msg << "Not enough buffer for envelope: " << bufLen <<
-			" bytes available, " << envelope.str().size() << " bytes needed";
-		throw std::runtime_error(msg.str());
-	}
-	envelope.str().copy(static_cast<char *>(buffer), envelope.str().size());
-	return envelope.str().size();
+	BufferWriter writer(static_cast<char *>(buffer), bufLen);
+	httpxx::composeFirstChunkEnvelope(writer, _firstToken, _secondToken, _thirdToken, headers, composedDate(), payloadLen);
+	return composedSize(writer, bufLen);
+}
+
+void MessageComposer::composeFirstChunkEnvelope(ScatterPacket& target, const Headers& headers,
+		size_t payloadLen)
+{
+	ScatterWriter writer(target);
+	httpxx::composeFirstChunkEnvelope(writer, _firstToken, _secondToken, _thirdToken, headers, composedDate(), payloadLen);
 }
 
 MessageComposer::Packet MessageComposer::prependFirstChunkEnvelope(void * buffer,
 		size_t envelopePartLen, const Headers& headers, size_t payloadLen)
 {
-	std::ostringstream envelope;
-	composeFirstChunkEnvelope(envelope, headers, payloadLen);
-	if (envelope.str().size() > envelopePartLen) {
-		std::ostringstream msg;
-		msg << "Not enough buffer for envelope: " << envelopePartLen <<
-			" bytes available, " << envelope.str().size() << " bytes needed";
-		throw std::runtime_error(msg.str());
+	if (payloadLen <= 0U) {
+		throw std::runtime_error("Could not compose envelope for empty chunk");
 	}
-	char * packetPtr = static_cast<char *>(buffer) + envelopePartLen - envelope.str().size(); 
-	envelope.str().copy(packetPtr, envelope.str().size());
-	return Packet(packetPtr, envelope.str().size() + payloadLen);
+	size_t size = firstChunkEnvelopeSize(headers, payloadLen);
+	char * packetPtr = envelopePtr(buffer, envelopePartLen, size);
+	BufferWriter writer(packetPtr, size);
+	httpxx::composeFirstChunkEnvelope(writer, _firstToken, _secondToken, _thirdToken, headers, composedDate(), payloadLen);
+	return Packet(packetPtr, size + payloadLen);
+}
+
+size_t MessageComposer::firstChunkEnvelopeSize(const Headers& headers, size_t payloadLen)
+{
+	return firstLineSize(_firstToken, _secondToken, _thirdToken) +
+		framedHeadersSize(headers, TransferEncodingHeaderId, 7U, _dateComposed) + chunkEnvelopeSize(payloadLen);
 }
 
 void MessageComposer::composeNextChunkEnvelope(std::ostream& target, size_t payloadLen)
 {
-	if (payloadLen <= 0U) {
-		throw std::runtime_error("Could not compose envelope for empty chunk");
-	}
-	target << "\r\n" << std::hex << payloadLen << "\r\n";
+	StreamWriter writer(target);
+	httpxx::composeNextChunkEnvelope(writer, payloadLen);
 }
 
 size_t MessageComposer::composeNextChunkEnvelope(void * buffer, size_t bufLen, size_t payloadLen)
 {
-	std::ostringstream envelope;
-	composeNextChunkEnvelope(envelope, payloadLen);
-	if (envelope.str().size() > bufLen) {
-		std::ostringstream msg;
-		msg << "Not enough buffer for envelope: " << bufLen <<
-			" bytes available, " << envelope.str().size() << " bytes needed";
-		throw std::runtime_error(msg.str());
-	}
-	envelope.str().copy(static_cast<char *>(buffer), envelope.str().size());
-	return envelope.str().size();
+	BufferWriter writer(static_cast<char *>(buffer), bufLen);
+	httpxx::composeNextChunkEnvelope(writer, payloadLen);
+	return composedSize(writer, bufLen);
+}
+
+void MessageComposer::composeNextChunkEnvelope(ScatterPacket& target, size_t payloadLen)
+{
+	ScatterWriter writer(target);
+	httpxx::composeNextChunkEnvelope(writer, payloadLen);
 }
 
 MessageComposer::Packet MessageComposer::prependNextChunkEnvelope(void * buffer, size_t envelopePartLen, size_t payloadLen)
 {
-	std::ostringstream envelope;
-	composeNextChunkEnvelope(envelope, payloadLen);
-	if (envelope.str().size() > envelopePartLen) {
-		std::ostringstream msg;
-		msg << "Not enough buffer for envelope: " << envelopePartLen <<
-			" bytes available, " << envelope.str().size() << " bytes needed";
-		throw std::runtime_error(msg.str());
+	if (payloadLen <= 0U) {
+		throw std::runtime_error("Could not compose envelope for empty chunk");
 	}
-	char * packetPtr = static_cast<char *>(buffer) + envelopePartLen - envelope.str().size(); 
-	envelope.str().copy(packetPtr, envelope.str().size());
-	return Packet(packetPtr, envelope.str().size() + payloadLen);
+	size_t size = nextChunkEnvelopeSize(payloadLen);
+	char * packetPtr = envelopePtr(buffer, envelopePartLen, size);
+	BufferWriter writer(packetPtr, size);
+	httpxx::composeNextChunkEnvelope(writer, payloadLen);
+	return Packet(packetPtr, size + payloadLen);
+}
+
+size_t MessageComposer::nextChunkEnvelopeSize(size_t payloadLen)
+{
+	return chunkEnvelopeSize(payloadLen);
 }
 
 void MessageComposer::composeLastChunk(std::ostream& target, const Headers& headers)
 {
-	target << "\r\n0\r\n";
-	composeHeader(target, headers);
-	target << "\r\n";
+	StreamWriter writer(target);
+	httpxx::composeLastChunk(writer, headers);
 }
 
 size_t MessageComposer::composeLastChunk(char * buffer, size_t bufLen, const Headers& headers)
 {
-	std::ostringstream envelope;
-	composeLastChunk(envelope, headers);
-	if (envelope.str().size() > bufLen) {
-		std::ostringstream msg;
-		msg << "Not enough buffer for envelope: " << bufLen <<
-			" bytes available, " << envelope.str().size() << " bytes needed";
-		throw std::runtime_error(msg.str());
+	BufferWriter writer(buffer, bufLen);
+	httpxx::composeLastChunk(writer, headers);
+	return composedSize(writer, bufLen);
+}
+
+void MessageComposer::composeLastChunk(ScatterPacket& target, const Headers& headers)
+{
+	ScatterWriter writer(target);
+	httpxx::composeLastChunk(writer, headers);
+}
+
+size_t MessageComposer::lastChunkSize(const Headers& headers)
+{
+	return headers.composedSize() + 7U;
+}
+
+void MessageComposer::composeFileMessage(FilePacket& target, const Headers& headers, int fd, uint64_t offset,
+		size_t len)
+{
+	size_t size = envelopeSize(headers, len);
+	BufferWriter writer(target.reserve(size), size);
+	httpxx::composeEnvelope(writer, _firstToken, _secondToken, _thirdToken, headers, composedDate(), len);
+	target.appendFile(fd, static_cast<off_t>(offset), len);
+}
+
+void MessageComposer::composeFirstFileChunk(FilePacket& target, const Headers& headers, int fd, uint64_t offset,
+		size_t len)
+{
+	if (len <= 0U) {
+		throw std::runtime_error("Could not compose envelope for empty chunk");
 	}
-	envelope.str().copy(buffer, envelope.str().size());
-	return envelope.str().size();
+	size_t size = firstChunkEnvelopeSize(headers, len);
+	BufferWriter writer(target.reserve(size), size);
+	httpxx::composeFirstChunkEnvelope(writer, _firstToken, _secondToken, _thirdToken, headers, composedDate(), len);
+	target.appendFile(fd, static_cast<off_t>(offset), len);
+}
+
+void MessageComposer::composeNextFileChunk(FilePacket& target, int fd, uint64_t offset, size_t len)
+{
+	if (len <= 0U) {
+		throw std::runtime_error("Could not compose envelope for empty chunk");
+	}
+	size_t size = nextChunkEnvelopeSize(len);
+	BufferWriter writer(target.reserve(size), size);
+	httpxx::composeNextChunkEnvelope(writer, len);
+	target.appendFile(fd, static_cast<off_t>(offset), len);
+}
+
+void MessageComposer::composeLastChunk(FilePacket& target, const Headers& headers)
+{
+	size_t size = lastChunkSize(headers);
+	BufferWriter writer(target.reserve(size), size);
+	httpxx::composeLastChunk(writer, headers);
+}
+
+const char * MessageComposer::composedDate() const
+{
+	return _dateComposed ? currentHttpDate() : 0;
 }
 
 } // namespace httpxx
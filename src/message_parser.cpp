@@ -1,36 +1,27 @@
 #include <httpxx/message_parser.h>
-#include <sstream>
-#include "char_utils.h"
+#include <cstring>
+#include <httpxx/char_utils.h>
 #include "string_utils.h"
 
 namespace {
 
-const char * ErrorCodeMessages[] =
-	{
-		"Invalid character in first token", /* Exception::InvalidFirstToken */
-		"First token is too long", /* Exception::FirstTokenIsTooLong */
-		"Invalid character in second token", /* Exception::InvalidSecondToken */
-		"Second token is too long", /* Exception::SecondTokenIsTooLong */
-		"Invalid character in third token", /* Exception::InvalidThirdToken */
-		"Third token is too long", /* Exception::ThirdTokenIsTooLong */
-		"First line CR is followed by invalid character", /* Exception::InvalidFirstLineLF */
-		"Too many headers", /* Exception::TooManyHeaders */
-		"Empty header name", /* Exception::EmptyHeaderName */
-		"Invalid header name", /* Exception::InvalidHeaderName */
-		"Header name is too long", /* Exception::HeaderNameIsTooLong */
-		"Header is missing ':' separator", /* Exception::HeaderIsMissingColon */
-		"Invalid header value", /* Exception::InvalidHeaderValue */
-		"Header value is too long", /* Exception::HeaderValueIsTooLong */
-		"Header CR is followed by invalid character", /* Exception::InvalidHeaderLF */
-		"Invalid content length", /* Exception::InvalidContentLength */
-		"Empty chunk size", /* Exception::EmptyChunkSize */
-		"Invalid chunk size", /* Exception::InvalidChunkSize */
-		"Chunk size CR is followed by invalid character", /* Exception::InvalidChunkSizeLF */
-		"Chunk data is followed by invalid character", /* Exception::InvalidChunkDataCR */
-		"Chunk data CR is followed by invalid character", /* Exception::InvalidChunkDataLF */
-		"Final CR is followed by invalid character", /* Exception::InvalidFinalLF */
-		"Invalid parser state", /* Exception::InvalidState - should never happens */
-	};
+inline bool isTrimmed(char ch)
+{
+	return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+}
+
+inline httpxx::StringView trimView(const httpxx::StringView& sv)
+{
+	const char * begin = sv.data();
+	const char * end = sv.data() + sv.size();
+	while (begin < end && isTrimmed(*begin)) {
+		++begin;
+	}
+	while (end > begin && isTrimmed(*(end - 1))) {
+		--end;
+	}
+	return httpxx::StringView(begin, end - begin);
+}
 
 }
 
@@ -38,427 +29,242 @@ namespace httpxx
 {
 
 //------------------------------------------------------------------------------
-// MessageParser
+// GenericMessageParser
 //------------------------------------------------------------------------------
 
-MessageParser::MessageParser(size_t maxFirstTokenLength, size_t maxSecondTokenLength, size_t maxThirdTokenLength,
-		size_t maxHeaderNameLength, size_t maxHeaderValueLength, size_t maxHeadersAmount) :
-	_state(ParsingMessage),
-	_pos(0),
-	_line(1),
-	_col(1),
+template <bool LazyPosition>
+GenericMessageParser<LazyPosition>::GenericMessageParser(size_t maxFirstTokenLength, size_t maxSecondTokenLength,
+		size_t maxThirdTokenLength, size_t maxHeaderNameLength, size_t maxHeaderValueLength, size_t maxHeadersAmount) :
+	BasicMessageParser<GenericMessageParser>(maxFirstTokenLength, maxSecondTokenLength, maxThirdTokenLength,
+			maxHeaderNameLength, maxHeaderValueLength, maxHeadersAmount),
 	_firstToken(),
 	_secondToken(),
 	_thirdToken(),
 	_headerFieldName(),
 	_headerFieldValue(),
 	_headers(),
-	_contentLength(0),
-	_identityBodyBytesParsed(0),
-	_chunkSizeStr(),
-	_chunkSize(0),
-	_chunkBytesParsed(0),
-	_maxFirstTokenLength(maxFirstTokenLength),
-	_maxSecondTokenLength(maxSecondTokenLength),
-	_maxThirdTokenLength(maxThirdTokenLength),
-	_maxHeaderNameLength(maxHeaderNameLength),
-	_maxHeaderValueLength(maxHeaderValueLength),
-	_maxHeadersAmount(maxHeadersAmount)
+	_viewMode(false),
+	_transientInput(false),
+	_payload(0),
+	_payloadStream(0),
+	_firstTokenView(),
+	_secondTokenView(),
+	_thirdTokenView(),
+	_headerNameView(),
+	_headerValueView(),
+	_headerViews(),
+	_arena()
 {}
 
-MessageParser::~MessageParser()
+template <bool LazyPosition>
+GenericMessageParser<LazyPosition>::~GenericMessageParser()
 {}
 
-bool MessageParser::parse(char ch, bool * isBodyChar)
+template <bool LazyPosition>
+bool GenericMessageParser<LazyPosition>::parse(char ch, bool * isBodyChar)
 {
-	bool bodyByteExtracted = bodyExpected();
-	switch (_state) {
-	case ParsingMessage:
-		if (isSpaceOrTab(ch)) {
-			reset();
-			_state = ParsingLeadingSP;
-		} else if (isChar(ch) && !isControl(ch)) {
-			reset();
-			_firstToken += ch;
-			_state = ParsingFirstToken;
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidFirstToken);
-		}
-		break;
-	case ParsingLeadingSP:
-		if (isSpaceOrTab(ch)) {
-			// Just ignore leading space
-		} else if (isChar(ch) && !isControl(ch)) {
-			_firstToken += ch;
-			_state = ParsingFirstToken;
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidFirstToken);
-		}
-		break;
-	case ParsingFirstToken:
-		if (isSpaceOrTab(ch)) {
-			_state = ParsingFirstTokenSP;
-		} else if (isChar(ch) && !isControl(ch)) {
-			if (_firstToken.length() >= _maxFirstTokenLength) {
-				throw Exception(ch, _pos, _line, _col, Exception::FirstTokenIsTooLong);
-			} else {
-				_firstToken += ch;
-			}
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidFirstToken);
-		}
-		break;
-	case ParsingFirstTokenSP:
-		if (isSpaceOrTab(ch)) {
-			// Just ignore it
-		} else if (isChar(ch) && !isControl(ch)) {
-			// Second token is empty -> no length check
-			_secondToken += ch;
-			_state = ParsingSecondToken;
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidSecondToken);
-		}
-		break;
-	case ParsingSecondToken:
-		if (isSpaceOrTab(ch)) {
-			_state = ParsingSecondTokenSP;
-		} else if (isChar(ch) && !isControl(ch)) {
-			if (_secondToken.length() >= _maxSecondTokenLength) {
-				throw Exception(ch, _pos, _line, _col, Exception::SecondTokenIsTooLong);
-			} else {
-				_secondToken += ch;
-			}
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidSecondToken);
-		}
-		break;
-	case ParsingSecondTokenSP:
-		if (isSpaceOrTab(ch)) {
-			// Just ignore it
-		} else if (isChar(ch) && !isControl(ch)) {
-			// Third token is empty -> no length check
-			_thirdToken += ch;
-			_state = ParsingThirdToken;
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidThirdToken);
-		}
-		break;
-	case ParsingThirdToken:
-		if (isCarriageReturn(ch)) {
-			_state = ParsingFirstLineLF;
-		} else if (isChar(ch) && !isControl(ch)) {
-			if (_thirdToken.length() >= _maxThirdTokenLength) {
-				throw Exception(ch, _pos, _line, _col, Exception::ThirdTokenIsTooLong);
-			} else {
-				_thirdToken += ch;
-			} 
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidThirdToken);
-		}
-		break;
-	case ParsingFirstLineLF:
-		if (isLineFeed(ch)) {
-			_state = ParsingHeader;
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidFirstLineLF);
-		}
-		break;
-	case ParsingHeader:
-		parseHeader(ch, false);
-		break;
-	case ParsingHeaderName:
-		parseHeaderName(ch, false);
-		break;
-	case ParsingHeaderValue:
-		parseHeaderValue(ch, false);
-		break;
-	case ParsingHeaderValueLF:
-		parseHeaderValueLF(ch, false);
-		break;
-	case ParsingHeaderValueLWS:
-		parseHeaderValueLWS(ch, false);
-		break;
-	case ParsingEndOfHeader:
-		if (isLineFeed(ch)) {
-			if (_headers.have("Transfer-Encoding", "chunked")) {
-				_state = ParsingChunkSize;
-			} else if (_headers.have("Content-Length")) {
-				// Extracting the content length
-				try {
-					_contentLength = toUnsignedInt(_headers.value("Content-Length"));
-				} catch (std::exception& /* e */) {
-					throw Exception(ch, _pos, _line, _col, Exception::InvalidContentLength);
-				}
-				if (_contentLength <= 0) {
-					_state = ParsingMessage;
-				} else {
-					_state = ParsingIdentityBody;
-				}
-			} else {
-				_state = ParsingMessage;
-			}
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidHeaderLF);
-		}
-		break;
-	case ParsingIdentityBody:
-		++_identityBodyBytesParsed;
-		if (_identityBodyBytesParsed >= _contentLength) {
-			_state = ParsingMessage;
-		}
-		break;
-	case ParsingChunkSize:
-		if (isHexDigit(ch)) {
-			_chunkSizeStr += ch;
-		} else {
-			if (_chunkSizeStr.empty()) {
-				throw Exception(ch, _pos, _line, _col, Exception::EmptyChunkSize);
-			} else {
-				try {
-					_chunkSize = toUnsignedInt(_chunkSizeStr, true);
-				} catch (std::exception& /* e */) {
-					throw Exception(ch, _pos, _line, _col, Exception::InvalidChunkSize);
-				}
-				_chunkBytesParsed = 0;
-				_chunkSizeStr.clear();
-				if (isCarriageReturn(ch)) {
-					_state = ParsingChunkSizeLF;
-				} else {
-					_state = ParsingChunkExtension;
-				}
-			}
-		}
-		break;
-	case ParsingChunkExtension:
-		// Just ignore a chunk extension.
-		if (isCarriageReturn(ch)) {
-			_state = ParsingChunkSizeLF;
-		}
-		break;
-	case ParsingChunkSizeLF:
-		if (isLineFeed(ch)) {
-			_state = (_chunkSize > 0) ? ParsingChunk : ParsingTrailerHeader;
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidChunkSizeLF);
-		}
-		break;
-	case ParsingChunk:
-		++_chunkBytesParsed;
-		if (_chunkBytesParsed >= _chunkSize) {
-			_state = ParsingChunkCR;
-		}
-		break;
-	case ParsingChunkCR:
-		if (isCarriageReturn(ch)) {
-			_state = ParsingChunkLF;
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidChunkDataCR);
-		}
-		break;
-	case ParsingChunkLF:
-		if (isLineFeed(ch)) {
-			_state = ParsingChunkSize;
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidChunkDataLF);
-		}
-		break;
-	case ParsingTrailerHeader:
-		parseHeader(ch, true);
-		break;
-	case ParsingTrailerHeaderName:
-		parseHeaderName(ch, true);
-		break;
-	case ParsingTrailerHeaderValue:
-		parseHeaderValue(ch, true);
-		break;
-	case ParsingTrailerHeaderValueLF:
-		parseHeaderValueLF(ch, true);
-		break;
-	case ParsingTrailerHeaderValueLWS:
-		parseHeaderValueLWS(ch, true);
-		break;
-	case ParsingFinalLF:
-		if (isLineFeed(ch)) {
-			_state = ParsingMessage;
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::InvalidFinalLF);
-		}
-		break;
-	default:
-		throw Exception(ch, _pos, _line, _col, Exception::InvalidState);
-	}
-	// Updating current position data
-	++_pos;
-	if (isLineFeed(ch)) {
-		++_line;
-		_col = 1;
-	} else {
-		++_col;
-	}
+	bool bodyByteExtracted = this->bodyExpected();
+	setInput(true, 0, 0);
+	bool completeMessageDetected = BasicMessageParser<GenericMessageParser>::parse(ch);
 	if (isBodyChar != 0) {
 		*isBodyChar = bodyByteExtracted;
 	}
-	return _state == ParsingMessage;
+	return completeMessageDetected;
 }
 
-std::pair<bool, size_t> MessageParser::parse(const void * buf, size_t bufLen, std::ostream& os)
+template <bool LazyPosition>
+std::pair<bool, size_t> GenericMessageParser<LazyPosition>::parse(const void * buf, size_t bufLen, Payload * payload)
 {
-	const char * pb = static_cast<const char *>(buf);
-	size_t bytesParsed = 0;
-	bool completeMessageDetected = false;
-	while (bytesParsed < bufLen && !completeMessageDetected) {
-		char ch = *(pb + bytesParsed++);
-		bool isBodyChar;
-		completeMessageDetected = parse(ch, &isBodyChar);
-		if (isBodyChar) {
-			os.put(ch);
-		}
+	setInput(false, payload, 0);
+	return BasicMessageParser<GenericMessageParser>::parse(buf, bufLen);
+}
+
+template <bool LazyPosition>
+std::pair<bool, size_t> GenericMessageParser<LazyPosition>::parse(const void * buf, size_t bufLen, std::ostream& os)
+{
+	setInput(false, 0, &os);
+	return BasicMessageParser<GenericMessageParser>::parse(buf, bufLen);
+}
+
+template <bool LazyPosition>
+typename GenericMessageParser<LazyPosition>::ParseResult
+GenericMessageParser<LazyPosition>::tryParse(char ch, bool * isBodyChar)
+{
+	bool bodyByteExtracted = this->bodyExpected();
+	setInput(true, 0, 0);
+	ParseResult result = BasicMessageParser<GenericMessageParser>::tryParse(ch);
+	if (isBodyChar != 0) {
+		*isBodyChar = bodyByteExtracted && !result.failed;
 	}
-	return std::pair<bool, size_t>(completeMessageDetected, bytesParsed);
+	return result;
 }
 
-void MessageParser::reset()
+template <bool LazyPosition>
+typename GenericMessageParser<LazyPosition>::ParseResult
+GenericMessageParser<LazyPosition>::tryParse(const void * buf, size_t bufLen, Payload * payload)
 {
-	_state = ParsingMessage;
-	_pos = 0;
-	_line = 1;
-	_col = 1;
+	setInput(false, payload, 0);
+	return BasicMessageParser<GenericMessageParser>::tryParse(buf, bufLen);
+}
+
+template <bool LazyPosition>
+typename GenericMessageParser<LazyPosition>::ParseResult
+GenericMessageParser<LazyPosition>::tryParse(const void * buf, size_t bufLen, std::ostream& os)
+{
+	setInput(false, 0, &os);
+	return BasicMessageParser<GenericMessageParser>::tryParse(buf, bufLen);
+}
+
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::reset()
+{
+	BasicMessageParser<GenericMessageParser>::reset();
 	_firstToken.clear(),
 	_secondToken.clear(),
 	_thirdToken.clear(),
 	_headerFieldName.clear();
 	_headerFieldValue.clear();
 	_headers.clear();
-	_contentLength = 0;
-	_identityBodyBytesParsed = 0;
-	_chunkSizeStr.clear();
-	_chunkSize = 0;
-	_chunkBytesParsed = 0;
+	_firstTokenView = StringView();
+	_secondTokenView = StringView();
+	_thirdTokenView = StringView();
+	_headerNameView = StringView();
+	_headerValueView = StringView();
+	_headerViews.clear();
+	// Arena keeps it's blocks for the next message
+	_arena.reset();
 }
 
-void MessageParser::appendHeader(char ch)
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::takeHeaders(httpxx::Headers& target)
 {
-	if (_headers.size() >= _maxHeadersAmount) {
-		throw Exception(ch, _pos, _line, _col, Exception::TooManyHeaders);
-	}
-	trim(_headerFieldName);
-	trim(_headerFieldValue);
-	_headers.insert(Headers::value_type(_headerFieldName, _headerFieldValue));
-	_headerFieldName.clear();
-	_headerFieldValue.clear();
+	target.take(_headers);
 }
 
-void MessageParser::parseHeader(char ch, bool isTrailer)
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::takeMessage(Message& target)
 {
-	_headerFieldName.clear();
-	_headerFieldValue.clear();
-	if (isCarriageReturn(ch)) {
-		_state = isTrailer ? ParsingFinalLF : ParsingEndOfHeader;
-	} else if (ch == ':') {
-		throw Exception(ch, _pos, _line, _col, Exception::EmptyHeaderName);
-	} else if (isToken(ch)) {
-		// Header field name is empty -> no length check
-		_headerFieldName += ch;
-		_state = isTrailer ? ParsingTrailerHeaderName : ParsingHeaderName;
+	// Strings exchange their buffers, the parser gets the former ones of the target
+	target.firstToken.swap(_firstToken);
+	target.secondToken.swap(_secondToken);
+	target.thirdToken.swap(_thirdToken);
+	_firstToken.clear();
+	_secondToken.clear();
+	_thirdToken.clear();
+	takeHeaders(target.headers);
+}
+
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::setInput(bool isTransient, Payload * payload, std::ostream * os)
+{
+	_transientInput = isTransient;
+	_payload = payload;
+	_payloadStream = os;
+}
+
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::onMessageBegin()
+{
+	reset();
+}
+
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::onFirstToken(const char * p, size_t len)
+{
+	if (_viewMode) {
+		appendView(_firstTokenView, p, len);
 	} else {
-		throw Exception(ch, _pos, _line, _col, Exception::InvalidHeaderName);
+		_firstToken.append(p, len);
 	}
 }
 
-void MessageParser::parseHeaderName(char ch, bool isTrailer)
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::onSecondToken(const char * p, size_t len)
 {
-	if (isCarriageReturn(ch)) {
-		throw Exception(ch, _pos, _line, _col, Exception::HeaderIsMissingColon);
-	} else if (ch == ':') {
-		_state = isTrailer ? ParsingTrailerHeaderValue : ParsingHeaderValue;
-	} else if (isToken(ch)) {
-		if (_headerFieldName.length() < maxHeaderNameLength()) {
-			_headerFieldName += ch;
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::HeaderNameIsTooLong);
-		}
+	if (_viewMode) {
+		appendView(_secondTokenView, p, len);
 	} else {
-		throw Exception(ch, _pos, _line, _col, Exception::InvalidHeaderName);
+		_secondToken.append(p, len);
 	}
 }
 
-void MessageParser::parseHeaderValue(char ch, bool isTrailer)
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::onThirdToken(const char * p, size_t len)
 {
-	if (isCarriageReturn(ch)) {
-		_state = isTrailer ? ParsingTrailerHeaderValueLF : ParsingHeaderValueLF;
-	} else if (!isControl(ch)) {
-		if (_headerFieldValue.length() < maxHeaderValueLength()) {
-			_headerFieldValue += ch;
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::HeaderValueIsTooLong);
-		}
+	if (_viewMode) {
+		appendView(_thirdTokenView, p, len);
 	} else {
-		throw Exception(ch, _pos, _line, _col, Exception::InvalidHeaderValue);
+		_thirdToken.append(p, len);
 	}
 }
 
-void MessageParser::parseHeaderValueLF(char ch, bool isTrailer)
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::onHeaderName(const char * p, size_t len)
 {
-	if (isLineFeed(ch)) {
-		_state = isTrailer ? ParsingTrailerHeaderValueLWS : ParsingHeaderValueLWS;
+	if (_viewMode) {
+		appendView(_headerNameView, p, len);
 	} else {
-		throw Exception(ch, _pos, _line, _col, Exception::InvalidHeaderLF);
+		_headerFieldName.append(p, len);
 	}
 }
 
-void MessageParser::parseHeaderValueLWS(char ch, bool isTrailer)
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::onHeaderValue(const char * p, size_t len)
 {
-	if (isCarriageReturn(ch)) {
-		appendHeader(ch);
-		_state = isTrailer ? ParsingFinalLF : ParsingEndOfHeader;
-	} else if (ch == ':') {
-		throw Exception(ch, _pos, _line, _col, Exception::EmptyHeaderName);
-	} else if (isSpaceOrTab(ch)) {
-		if (_headerFieldValue.length() < maxHeaderValueLength()) {
-			_headerFieldValue += ' ';
-			_state = isTrailer ? ParsingTrailerHeaderValue : ParsingHeaderValue;
-		} else {
-			throw Exception(ch, _pos, _line, _col, Exception::HeaderValueIsTooLong);
-		}
-	} else if (isToken(ch)) {
-		appendHeader(ch);
-		// Header field name is empty -> no length check
-		_headerFieldName += ch;
-		_state = isTrailer ? ParsingTrailerHeaderName : ParsingHeaderName;
+	if (_viewMode) {
+		appendView(_headerValueView, p, len);
 	} else {
-		throw Exception(ch, _pos, _line, _col, Exception::InvalidHeaderName);
+		_headerFieldValue.append(p, len);
 	}
 }
 
-//------------------------------------------------------------------------------
-// MessageParser::Exception
-//------------------------------------------------------------------------------
-
-MessageParser::Exception::Exception(char ch, int pos, int line, int col, Code code) :
-	std::exception(),
-	_ch(ch),
-	_pos(pos),
-	_line(line),
-	_col(col),
-	_code(code),
-	_what()
-{}
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::onHeaderFieldComplete()
+{
+	if (_viewMode) {
+		_headerViews.push_back(HeaderView(_headerNameView, trimView(_headerValueView)));
+		_headerNameView = StringView();
+		_headerValueView = StringView();
+	} else {
+		trim(_headerFieldValue);
+		_headers.insert(Headers::value_type(_headerFieldName, _headerFieldValue));
+		_headerFieldName.clear();
+		_headerFieldValue.clear();
+	}
+}
 
-const char * MessageParser::Exception::msg() const throw ()
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::onBodyData(const char * p, size_t len)
 {
-	return ErrorCodeMessages[_code];
+	if (_payload != 0) {
+		_payload->push_back(MessageParserBase::PayloadChunk(p, len));
+	}
+	if (_payloadStream != 0) {
+		_payloadStream->write(p, len);
+	}
 }
 
-const char * MessageParser::Exception::what() const throw ()
+template <bool LazyPosition>
+void GenericMessageParser<LazyPosition>::appendView(StringView& view, const char * p, size_t len)
 {
-	if (_what.empty()) {
-		std::ostringstream oss;
-		oss << "HTTP-message parsing error (pos: " << _pos << ", line: " << _line << ", col: " << _col <<
-			", character: " << std::showbase << std::hex << static_cast<int>(_ch) << "): " <<
-			ErrorCodeMessages[_code];
-		_what = oss.str();
+	if (!_transientInput) {
+		if (view.empty()) {
+			view = StringView(p, len);
+			return;
+		} else if (view.data() + view.size() == p) {
+			view = StringView(view.data(), view.size() + len);
+			return;
+		}
 	}
-	return _what.c_str();
+	// Characters do not follow the view in the memory -> assembling the view at the top of the arena,
+	// arena memory is never moved, so the views stay valid until the parser is reset
+	view = StringView(_arena.grow(view.data(), view.size(), len), view.size());
+	memcpy(_arena.top(), p, len);
+	_arena.commit(len);
+	view = StringView(view.data(), view.size() + len);
 }
 
+template class GenericMessageParser<false>;
+template class GenericMessageParser<true>;
+
 } // namespace httpxx
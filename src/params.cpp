@@ -1,83 +1,54 @@
 #include <httpxx/params.h>
-#include <httpxx/uri.h>
-#include "string_utils.h"
-#include <sstream>
+#include <httpxx/char_utils.h>
 
 namespace httpxx
 {
 
-Params::Params(const std::string& str) :
-	std::multimap<std::string, std::string>()
+size_t ParamsBase::decode(const char * buf, size_t len, char * target)
 {
-	parse(str);
-}
-
-Params::Params(const void * buf, size_t len) :
-	std::multimap<std::string, std::string>()
-{
-	parse(std::string(static_cast<const char *>(buf), len));
-}
-
-Params::Params(const Uri& uri) :
-	std::multimap<std::string, std::string>()
-{
-	parse(uri.query());
-}
-
-void Params::parse(const std::string& str)
-{
-	size_t pos = 0;
-	while (pos < str.length()) {
-		// Parsing param name
-		std::string paramName;
-		while (pos < str.length()) {
-			if (str[pos] == '=') {
-				++pos;
-				break;
-			} else if (str[pos] == '&') {
-				break;
-			}
-			paramName.append(1, str[pos]);
-			++pos;
+	size_t targetLen = 0U;
+	size_t i = 0U;
+	while (i < len) {
+		if (buf[i] == '%' && (i + 2U) < len && isHexDigit(buf[i + 1U]) && isHexDigit(buf[i + 2U])) {
+			target[targetLen++] = static_cast<char>(hexValue(buf[i + 1U]) * 16 + hexValue(buf[i + 2U]));
+			i += 3U;
+		} else {
+			target[targetLen++] = buf[i] == '+' ? ' ' : buf[i];
+			++i;
 		}
-		// Parsing param value
-		std::string paramValue;
-		while (pos < str.length()) {
-			if (str[pos] == '&') {
-				++pos;
-				break;
-			}
-			paramValue.append(1, str[pos]);
-			++pos;
-		}
-		// Adding name/value pair to the result
-		insert(value_type(decodePercent(paramName), decodePercent(paramValue)));
 	}
+	return targetLen;
 }
 
-size_t Params::compose(std::ostream& target) const
+size_t ParamsBase::encode(std::ostream& target, const char * buf, size_t len)
 {
-	size_t composedSize = 0U;
-	for (const_iterator i = begin(); i != end(); ++i) {
-		if (i->first.empty()) {
-			continue;
-		}
-		if (composedSize > 0U) {
-			target << '&';
-			++composedSize;
+	static const char * HexDigits = "0123456789ABCDEF";
+	size_t result = 0U;
+	for (size_t i = 0U; i < len; ++i) {
+		unsigned char code = buf[i];
+		if (isSpace(code)) {
+			target.put('+');
+			++result;
+		} else if (!isUrlSafe(code)) {
+			char encoded[3] = { '%', HexDigits[code >> 4], HexDigits[code & 0x0F] };
+			target.write(encoded, sizeof(encoded));
+			result += sizeof(encoded);
+		} else {
+			target.put(static_cast<char>(code));
+			++result;
 		}
-		std::string encodedName = encodePercent(i->first);
-		std::string encodedValue = encodePercent(i->second);
-		target << encodedName << '=' << encodedValue;
-		composedSize += (encodedName.size() + 1U + encodedValue.size());
 	}
-	return composedSize;
+	return result;
 }
 
-size_t Params::composedSize() const
+size_t ParamsBase::encodedSize(const char * buf, size_t len)
 {
-	std::ostringstream target;
-	return compose(target);
+	size_t result = 0U;
+	for (size_t i = 0U; i < len; ++i) {
+		unsigned char code = buf[i];
+		result += (isSpace(code) || isUrlSafe(code)) ? 1U : 3U;
+	}
+	return result;
 }
 
 } // namespace httpxx
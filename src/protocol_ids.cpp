@@ -0,0 +1,216 @@
+#include <httpxx/protocol_ids.h>
+#include <stdint.h>
+#include <cstring>
+
+namespace {
+
+// Indexed by Method
+const char * const MethodNames[] = {
+	"",
+	"GET",
+	"HEAD",
+	"POST",
+	"PUT",
+	"DELETE",
+	"CONNECT",
+	"OPTIONS",
+	"TRACE",
+	"PATCH"
+};
+
+// Indexed by ProtocolVersion
+const char * const ProtocolVersionTokens[] = {
+	"",
+	"HTTP/1.0",
+	"HTTP/1.1"
+};
+
+// Reason phrases of the status codes, indexed by the code without the class digit
+const char * const InformationalReasonPhrases[] = {
+	"Continue",
+	"Switching Protocols",
+	"Processing",
+	"Early Hints"
+};
+
+const char * const SuccessfulReasonPhrases[] = {
+	"OK",
+	"Created",
+	"Accepted",
+	"Non-Authoritative Information",
+	"No Content",
+	"Reset Content",
+	"Partial Content",
+	"Multi-Status",
+	"Already Reported",
+	"", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "",
+	"IM Used"
+};
+
+const char * const RedirectionReasonPhrases[] = {
+	"Multiple Choices",
+	"Moved Permanently",
+	"Found",
+	"See Other",
+	"Not Modified",
+	"Use Proxy",
+	"",
+	"Temporary Redirect",
+	"Permanent Redirect"
+};
+
+const char * const ClientErrorReasonPhrases[] = {
+	"Bad Request",
+	"Unauthorized",
+	"Payment Required",
+	"Forbidden",
+	"Not Found",
+	"Method Not Allowed",
+	"Not Acceptable",
+	"Proxy Authentication Required",
+	"Request Timeout",
+	"Conflict",
+	"Gone",
+	"Length Required",
+	"Precondition Failed",
+	"Content Too Large",
+	"URI Too Long",
+	"Unsupported Media Type",
+	"Range Not Satisfiable",
+	"Expectation Failed",
+	"I'm a teapot",
+	"", "",
+	"Misdirected Request",
+	"Unprocessable Content",
+	"Locked",
+	"Failed Dependency",
+	"Too Early",
+	"Upgrade Required",
+	"",
+	"Precondition Required",
+	"Too Many Requests",
+	"",
+	"Request Header Fields Too Large",
+	"", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "",
+	"Unavailable For Legal Reasons"
+};
+
+const char * const ServerErrorReasonPhrases[] = {
+	"Internal Server Error",
+	"Not Implemented",
+	"Bad Gateway",
+	"Service Unavailable",
+	"Gateway Timeout",
+	"HTTP Version Not Supported",
+	"Variant Also Negotiates",
+	"Insufficient Storage",
+	"Loop Detected",
+	"",
+	"Not Extended",
+	"Network Authentication Required"
+};
+
+struct ReasonPhrases
+{
+	const char * const * phrases;
+	size_t amount;
+};
+
+// Indexed by the status code class digit
+const ReasonPhrases StatusClasses[] = {
+	{ 0, 0U },
+	{ InformationalReasonPhrases, sizeof(InformationalReasonPhrases) / sizeof(InformationalReasonPhrases[0]) },
+	{ SuccessfulReasonPhrases, sizeof(SuccessfulReasonPhrases) / sizeof(SuccessfulReasonPhrases[0]) },
+	{ RedirectionReasonPhrases, sizeof(RedirectionReasonPhrases) / sizeof(RedirectionReasonPhrases[0]) },
+	{ ClientErrorReasonPhrases, sizeof(ClientErrorReasonPhrases) / sizeof(ClientErrorReasonPhrases[0]) },
+	{ ServerErrorReasonPhrases, sizeof(ServerErrorReasonPhrases) / sizeof(ServerErrorReasonPhrases[0]) }
+};
+
+// Loads up to 4 characters into the zero-padded word (folded to a constant for literals)
+inline uint32_t word32(const char * str, size_t len)
+{
+	uint32_t word = 0U;
+	memcpy(&word, str, len);
+	return word;
+}
+
+// Loads up to 8 characters into the zero-padded word (folded to a constant for literals)
+inline uint64_t word64(const char * str, size_t len)
+{
+	uint64_t word = 0U;
+	memcpy(&word, str, len);
+	return word;
+}
+
+}
+
+namespace httpxx
+{
+
+Method methodId(const char * name, size_t len)
+{
+	if (len < 3U) {
+		return UnknownMethod;
+	} else if (len <= 4U) {
+		uint32_t word = word32(name, len);
+		if (word == word32("GET", 3U)) {
+			return GetMethod;
+		} else if (word == word32("POST", 4U)) {
+			return PostMethod;
+		} else if (word == word32("HEAD", 4U)) {
+			return HeadMethod;
+		} else if (word == word32("PUT", 3U)) {
+			return PutMethod;
+		}
+	} else if (len <= 7U) {
+		uint64_t word = word64(name, len);
+		if (word == word64("DELETE", 6U)) {
+			return DeleteMethod;
+		} else if (word == word64("OPTIONS", 7U)) {
+			return OptionsMethod;
+		} else if (word == word64("PATCH", 5U)) {
+			return PatchMethod;
+		} else if (word == word64("CONNECT", 7U)) {
+			return ConnectMethod;
+		} else if (word == word64("TRACE", 5U)) {
+			return TraceMethod;
+		}
+	}
+	return UnknownMethod;
+}
+
+const char * methodName(Method method)
+{
+	return method < MethodsAmount ? MethodNames[method] : "";
+}
+
+ProtocolVersion protocolVersion(const char * token, size_t len)
+{
+	if (len != MaxProtocolVersionLength) {
+		return UnknownProtocolVersion;
+	}
+	uint64_t word = word64(token, len);
+	if (word == word64("HTTP/1.1", 8U)) {
+		return Http11ProtocolVersion;
+	} else if (word == word64("HTTP/1.0", 8U)) {
+		return Http10ProtocolVersion;
+	}
+	return UnknownProtocolVersion;
+}
+
+const char * protocolVersionToken(ProtocolVersion version)
+{
+	return version < ProtocolVersionsAmount ? ProtocolVersionTokens[version] : "";
+}
+
+const char * reasonPhrase(int statusCode)
+{
+	if (statusCode < 100 || statusCode >= 600) {
+		return "";
+	}
+	const ReasonPhrases& statusClass = StatusClasses[statusCode / 100];
+	size_t index = static_cast<size_t>(statusCode % 100);
+	return index < statusClass.amount ? statusClass.phrases[index] : "";
+}
+
+} // namespace httpxx
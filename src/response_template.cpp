@@ -0,0 +1,149 @@
+#include <httpxx/response_template.h>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace httpxx
+{
+
+namespace {
+
+const size_t NoOffset = static_cast<size_t>(-1);
+
+std::string statusLine(const std::string& versionToken, int statusCode, const std::string& reasonPhrase)
+{
+	if (statusCode < 100 || statusCode > 999) {
+		std::ostringstream msg;
+		msg << "Invalid status code: " << statusCode;
+		throw std::runtime_error(msg.str());
+	}
+	char code[MaxDecimalLength];
+	std::string result(versionToken);
+	result += ' ';
+	result.append(code, formatDecimal(static_cast<uint64_t>(statusCode), code));
+	result += ' ';
+	result += reasonPhrase;
+	result += "\r\n";
+	return result;
+}
+
+inline void appendHeader(std::string& target, const StringView& name, const StringView& value)
+{
+	target.append(name.data(), name.size());
+	target += ": ";
+	target.append(value.data(), value.size());
+	target += "\r\n";
+}
+
+char * envelopePtr(void * buffer, size_t envelopePartLen, size_t envelopeLen)
+{
+	if (envelopeLen > envelopePartLen) {
+		std::ostringstream msg;
+		msg << "Not enough buffer for envelope: " << envelopePartLen <<
+			" bytes available, " << envelopeLen << " bytes needed";
+		throw std::runtime_error(msg.str());
+	}
+	return static_cast<char *>(buffer) + envelopePartLen - envelopeLen;
+}
+
+} // anonymous namespace
+
+ResponseTemplate::ResponseTemplate(int statusCode, const Headers& headers, int slots, ProtocolVersion version) :
+	_statusCode(statusCode),
+	_slots(slots),
+	_rendered(),
+	_dateOffset(NoOffset)
+{
+	render(statusLine(protocolVersionToken(version), statusCode, reasonPhrase(statusCode)), headers);
+}
+
+ResponseTemplate::ResponseTemplate(const std::string& versionToken, int statusCode, const std::string& reasonPhrase,
+		const Headers& headers, int slots) :
+	_statusCode(statusCode),
+	_slots(slots),
+	_rendered(),
+	_dateOffset(NoOffset)
+{
+	render(statusLine(versionToken, statusCode, reasonPhrase), headers);
+}
+
+size_t ResponseTemplate::composeEnvelope(void * buffer, size_t bufLen, size_t payloadLen, const char * date) const
+{
+	size_t size = envelopeSize(payloadLen);
+	if (size > bufLen) {
+		std::ostringstream msg;
+		msg << "Not enough buffer for envelope: " << bufLen <<
+			" bytes available, " << size << " bytes needed";
+		throw std::runtime_error(msg.str());
+	}
+	char * p = static_cast<char *>(buffer);
+	memcpy(p, _rendered.data(), _rendered.size());
+	if (_dateOffset != NoOffset) {
+		memcpy(p + _dateOffset, date != 0 ? date : currentHttpDate(), DateLength);
+	}
+	if (_slots & ContentLengthSlot) {
+		p += _rendered.size();
+		p += formatDecimal(payloadLen, p);
+		memcpy(p, "\r\n\r\n", 4U);
+	}
+	return size;
+}
+
+MessageComposer::Packet ResponseTemplate::prependEnvelope(void * buffer, size_t envelopePartLen, size_t payloadLen,
+		const char * date) const
+{
+	size_t size = envelopeSize(payloadLen);
+	char * packetPtr = envelopePtr(buffer, envelopePartLen, size);
+	composeEnvelope(packetPtr, size, payloadLen, date);
+	return MessageComposer::Packet(packetPtr, size + payloadLen);
+}
+
+void ResponseTemplate::composeEnvelope(ScatterPacket& target, size_t payloadLen, const char * date) const
+{
+	if (_dateOffset != NoOffset) {
+		// Rendered bytes are shared, so the date is copied into the packet
+		char * dateCopy = target.allocate(DateLength);
+		memcpy(dateCopy, date != 0 ? date : currentHttpDate(), DateLength);
+		target.append(_rendered.data(), _dateOffset);
+		target.append(dateCopy, DateLength);
+		target.append(_rendered.data() + _dateOffset + DateLength, _rendered.size() - _dateOffset - DateLength);
+	} else {
+		target.append(_rendered.data(), _rendered.size());
+	}
+	if (_slots & ContentLengthSlot) {
+		char * contentLength = target.allocate(MaxDecimalLength + 4U);
+		size_t len = formatDecimal(payloadLen, contentLength);
+		memcpy(contentLength + len, "\r\n\r\n", 4U);
+		target.append(contentLength, len + 4U);
+	}
+}
+
+void ResponseTemplate::render(const std::string& statusLine, const Headers& headers)
+{
+	_rendered = statusLine;
+	for (Headers::const_iterator i = headers.begin(); i != headers.end(); ++i) {
+		HeaderId id = headerId(i->first.data(), i->first.size());
+		if ((_slots & ContentLengthSlot) && (id == ContentLengthHeaderId || id == TransferEncodingHeaderId)) {
+			continue;
+		}
+		if ((_slots & DateSlot) && id == DateHeaderId) {
+			continue;
+		}
+		appendHeader(_rendered, i->first, i->second);
+	}
+	if (_slots & DateSlot) {
+		_rendered += headerName(DateHeaderId);
+		_rendered += ": ";
+		_dateOffset = _rendered.size();
+		_rendered.append(static_cast<size_t>(DateLength), ' ');
+		_rendered += "\r\n";
+	}
+	if (_slots & ContentLengthSlot) {
+		_rendered += headerName(ContentLengthHeaderId);
+		_rendered += ": ";
+	} else {
+		_rendered += "\r\n";
+	}
+}
+
+} // namespace httpxx
@@ -0,0 +1,105 @@
+#include <httpxx/scatter_packet.h>
+#include <algorithm>
+#include <cstring>
+
+namespace httpxx
+{
+
+ScatterPacket::ScatterPacket() :
+	_segments(_inlineSegments),
+	_first(0U),
+	_size(0U),
+	_capacity(InlineSegmentsAmount),
+	_bytes(0U),
+	_arena(ArenaBlockSize),
+	_inlineSegments()
+{}
+
+ScatterPacket::~ScatterPacket()
+{
+	if (_segments != _inlineSegments) {
+		delete [] _segments;
+	}
+}
+
+void ScatterPacket::append(const void * buf, size_t len)
+{
+	if (len <= 0U) {
+		return;
+	}
+	_bytes += len;
+	if (_size > _first) {
+		struct iovec& last = _segments[_size - 1U];
+		if (static_cast<const char *>(last.iov_base) + last.iov_len == buf) {
+			last.iov_len += len;
+			return;
+		}
+	}
+	if (_size >= _capacity) {
+		size_t capacity = _capacity * 2U;
+		struct iovec * segments = new struct iovec[capacity];
+		std::copy(_segments + _first, _segments + _size, segments);
+		if (_segments != _inlineSegments) {
+			delete [] _segments;
+		}
+		_segments = segments;
+		_size -= _first;
+		_first = 0U;
+		_capacity = capacity;
+	}
+	// Segments do not modify the data, but iovec has no const-qualified pointer
+	_segments[_size].iov_base = const_cast<void *>(buf);
+	_segments[_size].iov_len = len;
+	++_size;
+}
+
+size_t ScatterPacket::copy(void * buf, size_t len) const
+{
+	char * p = static_cast<char *>(buf);
+	size_t copied = 0U;
+	for (size_t i = _first; i < _size && copied < len; ++i) {
+		size_t part = std::min(_segments[i].iov_len, len - copied);
+		memcpy(p + copied, _segments[i].iov_base, part);
+		copied += part;
+	}
+	return copied;
+}
+
+std::string ScatterPacket::str() const
+{
+	std::string result(_bytes, '\0');
+	if (!result.empty()) {
+		copy(&result[0], result.size());
+	}
+	return result;
+}
+
+void ScatterPacket::consume(size_t len)
+{
+	len = std::min(len, _bytes);
+	_bytes -= len;
+	while (len > 0U) {
+		struct iovec& segment = _segments[_first];
+		if (len < segment.iov_len) {
+			segment.iov_base = static_cast<char *>(segment.iov_base) + len;
+			segment.iov_len -= len;
+			return;
+		}
+		len -= segment.iov_len;
+		++_first;
+	}
+	if (_first >= _size) {
+		_first = 0U;
+		_size = 0U;
+	}
+}
+
+void ScatterPacket::clear()
+{
+	_first = 0U;
+	_size = 0U;
+	_bytes = 0U;
+	_arena.reset();
+}
+
+} // namespace httpxx
@@ -1,5 +1,5 @@
 #include "string_utils.h"
-#include "char_utils.h"
+#include <httpxx/char_utils.h>
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
@@ -52,48 +52,26 @@ std::string decodePercent(const std::string &str)
 	return decodedString;
 }
 
-unsigned int toUnsignedInt(const std::string& str, bool isHex)
+uint64_t toUnsignedInt(const std::string& str, bool isHex)
 {
-	std::string strToParse = str;
-	trim(strToParse);
-	if (strToParse.empty()) {
+	// Trimming without copying
+	static const char * CharsToTrim = " \t\r\n";
+	std::string::size_type first = str.find_first_not_of(CharsToTrim);
+	if (first == std::string::npos) {
 		return 0U;
 	}
-	unsigned int result = 0U;
-	if (isHex) {
-		for (size_t curPos = 0; curPos < strToParse.size(); ++curPos) {
-			unsigned int newResult;
-			if (strToParse[curPos] >= '0' && strToParse[curPos] <= '9') {
-				newResult = result * 16U + strToParse[curPos] - '0';
-			} else if (strToParse[curPos] >= 'a' && strToParse[curPos] <= 'f') {
-				newResult = result * 16U + strToParse[curPos] - 'a' + 10U;
-			} else if (strToParse[curPos] >= 'A' && strToParse[curPos] <= 'F') {
-				newResult = result * 16U + strToParse[curPos] - 'A' + 10U;
-			} else {
-				std::ostringstream msg;
-				msg << "Invalid hex digit character '" << strToParse[curPos] <<
-					"' on " << curPos << " position";
-				throw std::runtime_error(msg.str());
-			}
-			if (newResult < result) {
-				throw std::runtime_error("Integer overflow has been detected");
-			}
-			result = newResult;
-		}
-	} else {
-		for (size_t curPos = (strToParse[0] == '+' ? 1 : 0); curPos < strToParse.size(); ++curPos) {
-			if (!isDigit(strToParse[curPos])) {
-				std::ostringstream msg;
-				msg << "Invalid decimal digit character '" << strToParse[curPos] <<
-					"' on " << curPos << " position";
-				throw std::runtime_error(msg.str());
-			}
-			unsigned int newResult = result * 10 + strToParse[curPos] - '0';
-			if (newResult < result) {
-				throw std::runtime_error("Integer overflow has been detected");
-			}
-			result = newResult;
-		}
+	std::string::size_type last = str.find_last_not_of(CharsToTrim);
+	if (!isHex && str[first] == '+') {
+		++first;
+	}
+	uint64_t result = 0U;
+	if (first > last) {
+		return result;
+	}
+	if (isHex ? !parseHex(str.data() + first, last - first + 1U, result) :
+			!parseDecimal(str.data() + first, last - first + 1U, result)) {
+		throw std::runtime_error(isHex ? "Invalid hex integer or integer overflow" :
+				"Invalid decimal integer or integer overflow");
 	}
 	return result;
 }
@@ -2,6 +2,7 @@
 #define HTTPXX_STRING_H
 
 #include <string>
+#include <stdint.h>
 
 namespace httpxx
 {
@@ -12,11 +13,12 @@ std::string encodePercent(const std::string &str);
 //! Decodes string using Percent-encoding (see http://en.wikipedia.org/wiki/Percent-encoding)
 std::string decodePercent(const std::string &str);
 
-// Converts string to unsigned int
+//! Converts string to unsigned 64-bit integer
 /*!
- * TODO
+ * Surrounding whitespace is ignored, decimal value could be prefixed with '+'.
+ * \throw std::runtime_error On invalid digit or integer overflow
  */
-unsigned int toUnsignedInt(const std::string& str, bool isHex = false);
+uint64_t toUnsignedInt(const std::string& str, bool isHex = false);
 
 //! Trims space characters on the both ends of the string
 void trim(std::string &str);
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <stdint.h>
+#include <httpxx/arena.h>
+
+using namespace httpxx;
+
+TEST(Arena, Allocate)
+{
+	Arena arena(64U);
+	char * first = static_cast<char *>(arena.allocate(3U, 1U));
+	memcpy(first, "abc", 3U);
+	void * aligned = arena.allocate(8U, 8U);
+	EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(aligned) % 8U);
+	EXPECT_LE(static_cast<void *>(first + 3U), aligned);
+	// Larger allocation than the block size takes it's own block
+	char * large = static_cast<char *>(arena.allocate(1000U));
+	memset(large, 'x', 1000U);
+	EXPECT_EQ(0, memcmp(first, "abc", 3U));
+
+	// Reserved memory is allocated by commit()
+	char * top = arena.reserve(16U);
+	EXPECT_EQ(top, arena.top());
+	EXPECT_LE(16U, arena.available());
+	memcpy(top, "0123", 4U);
+	arena.commit(4U);
+	EXPECT_EQ(top + 4U, arena.top());
+	EXPECT_EQ(top + 4U, arena.reserve(4U));
+
+	// Blocks are reused after reset
+	arena.reset();
+	EXPECT_EQ(0U, arena.available());
+	char * reused = static_cast<char *>(arena.allocate(1000U));
+	EXPECT_EQ(large, reused);
+	arena.clear();
+	EXPECT_EQ(0U, arena.available());
+}
+
+TEST(Arena, Grow)
+{
+	Arena arena(64U);
+	// Allocation at the top grows in place while the block has room
+	char * field = arena.grow(0, 0U, 1U);
+	for (size_t i = 0U; i < 64U; ++i) {
+		EXPECT_EQ(field, arena.grow(field, i, 1U));
+		field[i] = static_cast<char>('a' + i % 26);
+		arena.commit(1U);
+	}
+	EXPECT_EQ(64U, arena.capacity());
+	// Moved allocation gets room to grow, so it is not moved on each byte
+	char * moved = arena.grow(field, 64U, 1U);
+	EXPECT_NE(field, moved);
+	EXPECT_EQ(0, memcmp(field, moved, 64U));
+	EXPECT_LE(64U, arena.available());
+	EXPECT_EQ(64U + 128U, arena.capacity());
+	// Allocation, which is not at the top, is copied to the top
+	char * copy = arena.grow("xyz", 3U, 1U);
+	EXPECT_EQ(0, memcmp(copy, "xyz", 3U));
+	EXPECT_EQ(copy + 3U, arena.top());
+	arena.reset();
+	EXPECT_EQ(64U + 128U, arena.capacity());
+	arena.clear();
+	EXPECT_EQ(0U, arena.capacity());
+}
+
+TEST(Arena, Allocator)
+{
+	Arena arena;
+	std::vector<uint64_t, ArenaAllocator<uint64_t> > v((ArenaAllocator<uint64_t>(arena)));
+	for (uint64_t i = 0U; i < 1000U; ++i) {
+		v.push_back(i);
+	}
+	EXPECT_EQ(999U, v.back());
+	EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(&v[0]) % sizeof(uint64_t));
+
+	typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char> > ArenaString;
+	ArenaString onArena("This string is long enough to be allocated", ArenaAllocator<char>(arena));
+	ArenaString onHeap("This string is long enough to be allocated");
+	EXPECT_TRUE(onArena == onHeap);
+	EXPECT_TRUE(onArena.get_allocator() != onHeap.get_allocator());
+	EXPECT_TRUE(ArenaAllocator<int>(arena) == ArenaAllocator<char>(arena));
+}
@@ -0,0 +1,401 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <httpxx/basic_message_parser.h>
+
+using namespace httpxx;
+
+namespace {
+
+// Records parser events as "<event>[:<data>]" strings, merging adjacent fragments of the same event
+class EventRecorder : public BasicMessageParser<EventRecorder>
+{
+public:
+	EventRecorder() :
+		BasicMessageParser<EventRecorder>(10U, 24U, 24U),
+		events(),
+		fragments(0U),
+		bodyFragments(0U),
+		headerIds()
+	{}
+
+	void onMessageBegin()
+	{
+		addEvent("begin", 0, 0U);
+	}
+	void onFirstToken(const char * p, size_t len)
+	{
+		addEvent("first", p, len);
+	}
+	void onSecondToken(const char * p, size_t len)
+	{
+		addEvent("second", p, len);
+	}
+	void onThirdToken(const char * p, size_t len)
+	{
+		addEvent("third", p, len);
+	}
+	void onHeaderName(const char * p, size_t len)
+	{
+		addEvent("name", p, len);
+	}
+	void onHeaderValue(const char * p, size_t len)
+	{
+		addEvent("value", p, len);
+	}
+	void onHeaderFieldComplete()
+	{
+		headerIds.push_back(headerFieldId());
+		addEvent("field", 0, 0U);
+	}
+	void onHeadersComplete()
+	{
+		addEvent("headers", 0, 0U);
+	}
+	void onBodyData(const char * p, size_t len)
+	{
+		++bodyFragments;
+		addEvent("body", p, len);
+	}
+	void onMessageComplete()
+	{
+		addEvent("complete", 0, 0U);
+	}
+
+	std::vector<std::string> events;
+	size_t fragments;
+	size_t bodyFragments;
+	std::vector<HeaderId> headerIds;
+private:
+	void addEvent(const char * event, const char * p, size_t len)
+	{
+		++fragments;
+		std::string prefix = std::string(event) + (p != 0 ? ":" : "");
+		if (p != 0 && !events.empty() && events.back().compare(0, prefix.size(), prefix) == 0) {
+			events.back().append(p, len);
+		} else {
+			events.push_back(prefix + std::string(p != 0 ? p : "", len));
+		}
+	}
+};
+
+// Counts complete messages only, other hooks are the default ones
+class MessageCounter : public BasicMessageParser<MessageCounter>
+{
+public:
+	MessageCounter() :
+		BasicMessageParser<MessageCounter>(10U, 24U, 24U),
+		messages(0U)
+	{}
+
+	void onMessageComplete()
+	{
+		++messages;
+	}
+
+	size_t messages;
+};
+
+const char * ChunkedMessage =
+	"POST /upload HTTP/1.1\r\n"
+	"Host:  localhost \r\n"
+	"X-Multi: foo\r\n"
+	"\tbar\r\n"
+	"Transfer-Encoding: chunked\r\n"
+	"\r\n"
+	"5\r\n"
+	"Hello\r\n"
+	"7;ext=1\r\n"
+	", World\r\n"
+	"0\r\n"
+	"X-Trailer: baz\r\n"
+	"\r\n";
+
+const char * ChunkedMessageEvents[] = {
+	"begin",
+	"first:POST",
+	"second:/upload",
+	"third:HTTP/1.1",
+	"name:Host",
+	"value:localhost ",
+	"field",
+	"name:X-Multi",
+	"value:foo bar",
+	"field",
+	"name:Transfer-Encoding",
+	"value:chunked",
+	"field",
+	"headers",
+	"body:Hello, World",
+	"name:X-Trailer",
+	"value:baz",
+	"field",
+	"complete"
+};
+
+}
+
+TEST(BasicMessageParserTest, ParseBufferEvents)
+{
+	EventRecorder parser;
+	std::pair<bool, size_t> res = parser.parse(ChunkedMessage, strlen(ChunkedMessage));
+	EXPECT_TRUE(res.first);
+	EXPECT_EQ(strlen(ChunkedMessage), res.second);
+	EXPECT_TRUE(parser.isChunked());
+	ASSERT_EQ(sizeof(ChunkedMessageEvents) / sizeof(ChunkedMessageEvents[0]), parser.events.size());
+	for (size_t i = 0U; i < parser.events.size(); ++i) {
+		EXPECT_EQ(ChunkedMessageEvents[i], parser.events[i]);
+	}
+	ASSERT_EQ(4U, parser.headerIds.size());
+	EXPECT_EQ(HostHeaderId, parser.headerIds[0]);
+	EXPECT_EQ(UnknownHeaderId, parser.headerIds[1]);
+	EXPECT_EQ(TransferEncodingHeaderId, parser.headerIds[2]);
+	EXPECT_EQ(UnknownHeaderId, parser.headerIds[3]);
+}
+
+TEST(BasicMessageParserTest, ParseSplitBufferEvents)
+{
+	for (size_t splitPos = 1U; splitPos < strlen(ChunkedMessage); ++splitPos) {
+		// Copying each part to it's own buffer to make sure fragments are not read beyond it
+		std::vector<char> head(ChunkedMessage, ChunkedMessage + splitPos);
+		std::vector<char> tail(ChunkedMessage + splitPos, ChunkedMessage + strlen(ChunkedMessage));
+		EventRecorder parser;
+		std::pair<bool, size_t> res = parser.parse(&head[0], head.size());
+		EXPECT_FALSE(res.first);
+		EXPECT_EQ(head.size(), res.second);
+		res = parser.parse(&tail[0], tail.size());
+		EXPECT_TRUE(res.first);
+		EXPECT_EQ(tail.size(), res.second);
+		ASSERT_EQ(sizeof(ChunkedMessageEvents) / sizeof(ChunkedMessageEvents[0]), parser.events.size());
+		for (size_t i = 0U; i < parser.events.size(); ++i) {
+			EXPECT_EQ(ChunkedMessageEvents[i], parser.events[i]);
+		}
+	}
+}
+
+TEST(BasicMessageParserTest, ParseCharsEvents)
+{
+	EventRecorder parser;
+	for (size_t i = 0U; i < strlen(ChunkedMessage); ++i) {
+		EXPECT_EQ(i == strlen(ChunkedMessage) - 1U, parser.parse(ChunkedMessage[i]));
+	}
+	ASSERT_EQ(sizeof(ChunkedMessageEvents) / sizeof(ChunkedMessageEvents[0]), parser.events.size());
+	for (size_t i = 0U; i < parser.events.size(); ++i) {
+		EXPECT_EQ(ChunkedMessageEvents[i], parser.events[i]);
+	}
+	// Each character is reported separately
+	EXPECT_EQ(strlen("Hello, World"), parser.bodyFragments);
+}
+
+TEST(BasicMessageParserTest, ParseIdentityBodyInBulk)
+{
+	static const char * IdentityEncodedMessage =
+		"HTTP/1.1 200 OK\r\n"
+		"content-length: +10\r\n"
+		"Content-Length: 5\r\n"
+		"\r\n"
+		"0123456789";
+
+	EventRecorder parser;
+	std::pair<bool, size_t> res = parser.parse(IdentityEncodedMessage, strlen(IdentityEncodedMessage));
+	EXPECT_TRUE(res.first);
+	EXPECT_EQ(strlen(IdentityEncodedMessage), res.second);
+	EXPECT_FALSE(parser.isChunked());
+	EXPECT_EQ(10U, parser.contentLength());
+	ASSERT_LE(2U, parser.events.size());
+	EXPECT_EQ("body:0123456789", parser.events[parser.events.size() - 2U]);
+	EXPECT_EQ(1U, parser.bodyFragments);
+}
+
+TEST(BasicMessageParserTest, MessageProperties)
+{
+	static const char * Message =
+		"HTTP/1.1 200 OK\r\n"
+		"Connection: Keep-Alive,  Upgrade\r\n"
+		"Content-Length: 3 \r\n"
+		"Transfer-Encoding: gzip;q=1, x-foo\r\n"
+		"connection: te\r\n"
+		"Transfer-Encoding: \r\n"
+		" CHUNKED \r\n"
+		"\r\n"
+		"3\r\n"
+		"abc\r\n"
+		"0\r\n"
+		"Connection: close\r\n"
+		"Transfer-Encoding: gzip\r\n"
+		"\r\n";
+
+	// Properties do not depend on the way the message is split between buffers
+	for (size_t splitPos = 0U; splitPos < strlen(Message); ++splitPos) {
+		EventRecorder parser;
+		std::pair<bool, size_t> res = parser.parse(Message, splitPos);
+		EXPECT_FALSE(res.first);
+		res = parser.parse(Message + splitPos, strlen(Message) - splitPos);
+		ASSERT_TRUE(res.first) << splitPos;
+		const MessageParserBase::MessageProperties& properties = parser.properties();
+		EXPECT_TRUE(properties.hasContentLength) << splitPos;
+		EXPECT_EQ(3U, properties.contentLength) << splitPos;
+		EXPECT_EQ(static_cast<unsigned int>(MessageParserBase::KeepAliveConnectionOption |
+					MessageParserBase::UpgradeConnectionOption), properties.connectionOptions) << splitPos;
+		EXPECT_EQ(static_cast<unsigned int>(MessageParserBase::GzipTransferCoding |
+					MessageParserBase::UnknownTransferCoding | MessageParserBase::ChunkedTransferCoding),
+				properties.transferCodings) << splitPos;
+		EXPECT_EQ(3U, properties.transferCodingsAmount) << splitPos;
+		EXPECT_TRUE(properties.isChunked) << splitPos;
+		EXPECT_TRUE(parser.isChunked()) << splitPos;
+	}
+
+	static const char * NotChunkedMessages[] = {
+		"HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked, gzip\r\nContent-Length: 0\r\n\r\n",
+		"HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nTransfer-Encoding: gzip\r\n\r\n",
+		"HTTP/1.1 200 OK\r\nTransfer-Encoding: chun ked\r\n\r\n",
+		"HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked-chunked-chunked-chunked-chunked\r\n\r\n",
+		"HTTP/1.1 200 OK\r\nX-Transfer-Encoding: chunked\r\nConnection: closed\r\n\r\n"
+	};
+	for (size_t i = 0U; i < sizeof(NotChunkedMessages) / sizeof(NotChunkedMessages[0]); ++i) {
+		EventRecorder parser;
+		std::pair<bool, size_t> res = parser.parse(NotChunkedMessages[i], strlen(NotChunkedMessages[i]));
+		EXPECT_TRUE(res.first) << NotChunkedMessages[i];
+		EXPECT_FALSE(parser.properties().isChunked) << NotChunkedMessages[i];
+		EXPECT_EQ(0U, parser.properties().connectionOptions) << NotChunkedMessages[i];
+	}
+	EventRecorder parser;
+	parser.parse(NotChunkedMessages[0], strlen(NotChunkedMessages[0]));
+	EXPECT_EQ(2U, parser.properties().transferCodingsAmount);
+	EXPECT_TRUE(parser.properties().hasContentLength);
+	parser.parse(NotChunkedMessages[4], strlen(NotChunkedMessages[4]));
+	EXPECT_FALSE(parser.properties().hasContentLength);
+	EXPECT_EQ(0U, parser.properties().transferCodings);
+}
+
+TEST(BasicMessageParserTest, ParseLargeBodySizes)
+{
+	static const char * IdentityEncodedMessage =
+		"HTTP/1.1 200 OK\r\n"
+		"Content-Length: 0000005000000000\r\n"
+		"\r\n"
+		"0123456789";
+
+	EventRecorder parser;
+	std::pair<bool, size_t> res = parser.parse(IdentityEncodedMessage, strlen(IdentityEncodedMessage));
+	EXPECT_FALSE(res.first);
+	EXPECT_EQ(strlen(IdentityEncodedMessage), res.second);
+	EXPECT_EQ(UINT64_C(5000000000), parser.contentLength());
+	EXPECT_EQ(MessageParserBase::ParsingIdentityBody, parser.state());
+
+	static const char * ChunkedMessage =
+		"HTTP/1.1 200 OK\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"\r\n"
+		"0000000000000000001\r\n"
+		"a\r\n"
+		"1fFfFfFfF\r\n"
+		"0123456789";
+
+	// Chunk size digits are split between the buffers
+	for (size_t splitPos = strlen(ChunkedMessage) - 24U; splitPos < strlen(ChunkedMessage) - 10U; ++splitPos) {
+		EventRecorder chunkedParser;
+		res = chunkedParser.parse(ChunkedMessage, splitPos);
+		EXPECT_FALSE(res.first);
+		EXPECT_EQ(splitPos, res.second);
+		res = chunkedParser.parse(ChunkedMessage + splitPos, strlen(ChunkedMessage) - splitPos);
+		EXPECT_FALSE(res.first);
+		EXPECT_EQ(strlen(ChunkedMessage) - splitPos, res.second);
+		EXPECT_EQ(MessageParserBase::ParsingChunk, chunkedParser.state());
+		ASSERT_LE(2U, chunkedParser.events.size());
+		EXPECT_EQ("body:a0123456789", chunkedParser.events.back());
+	}
+
+	static const char * InvalidChunkSizes[] = {
+		"10000000000000000",
+		"fffffffffffffffff"
+	};
+	for (size_t i = 0U; i < sizeof(InvalidChunkSizes) / sizeof(InvalidChunkSizes[0]); ++i) {
+		std::string message = std::string("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n") +
+			InvalidChunkSizes[i] + "\r\n";
+		MessageCounter counter;
+		try {
+			counter.parse(message.data(), message.size());
+			ADD_FAILURE() << "Exception expected for \"" << InvalidChunkSizes[i] << '"';
+		} catch (MessageParserBase::Exception& e) {
+			EXPECT_EQ(MessageParserBase::Exception::InvalidChunkSize, e.code());
+			EXPECT_EQ(message.size() - 2U, static_cast<size_t>(e.pos()));
+		}
+	}
+}
+
+TEST(BasicMessageParserTest, ParseMultipleWithDefaultHooks)
+{
+	static const char * Messages =
+		"GET / HTTP/1.1\r\n"
+		"\r\n"
+		"HTTP/1.1 200 OK\r\n"
+		"Transfer-Encoding: gzip\r\n"
+		"Content-Length: 3\r\n"
+		"\r\n"
+		"abc"
+		"GET /next HTTP/1.1\r\n"
+		"Content-Length: 0\r\n"
+		"\r\n";
+
+	MessageCounter parser;
+	size_t bytesParsed = 0U;
+	while (bytesParsed < strlen(Messages)) {
+		std::pair<bool, size_t> res = parser.parse(Messages + bytesParsed, strlen(Messages) - bytesParsed);
+		EXPECT_TRUE(res.first);
+		bytesParsed += res.second;
+	}
+	EXPECT_EQ(3U, parser.messages);
+}
+
+TEST(BasicMessageParserTest, ParseErrors)
+{
+	static const char * InvalidContentLengths[] = {
+		"1a",
+		"-1",
+		"1 2",
+		"99999999999999999999999999999999",
+		"123456789012345678901234567890123"
+	};
+	for (size_t i = 0U; i < sizeof(InvalidContentLengths) / sizeof(InvalidContentLengths[0]); ++i) {
+		std::string message = std::string("GET / HTTP/1.1\r\nContent-Length: ") + InvalidContentLengths[i] +
+			"\r\n\r\n";
+		MessageCounter parser;
+		try {
+			parser.parse(message.data(), message.size());
+			ADD_FAILURE() << "Exception expected for \"" << InvalidContentLengths[i] << '"';
+		} catch (MessageParserBase::Exception& e) {
+			EXPECT_EQ(MessageParserBase::Exception::InvalidContentLength, e.code());
+			EXPECT_EQ(message.size() - 1U, static_cast<size_t>(e.pos()));
+		}
+	}
+
+	static const char * TooManyHeaders =
+		"GET / HTTP/1.1\r\n"
+		"A: 1\r\n"
+		"B: 2\r\n"
+		"\r\n";
+	MessageCounter parser;
+	parser.setMaxHeadersAmount(1U);
+	try {
+		parser.parse(TooManyHeaders, strlen(TooManyHeaders));
+		ADD_FAILURE() << "Exception expected";
+	} catch (MessageParserBase::Exception& e) {
+		EXPECT_EQ(MessageParserBase::Exception::TooManyHeaders, e.code());
+		EXPECT_EQ(4, e.line());
+	}
+
+	static const char * HugeChunkSize =
+		"POST / HTTP/1.1\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"\r\n"
+		"10000000000000000000000\r\n";
+	parser.reset();
+	try {
+		parser.parse(HugeChunkSize, strlen(HugeChunkSize));
+		ADD_FAILURE() << "Exception expected";
+	} catch (MessageParserBase::Exception& e) {
+		EXPECT_EQ(MessageParserBase::Exception::InvalidChunkSize, e.code());
+	}
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <algorithm>
+#include <httpxx/char_utils.h>
+
+using namespace httpxx;
+
+typedef size_t (*SpanFunc)(const char *, size_t);
+typedef bool (*CharPredicate)(unsigned char);
+
+static bool isVisible(unsigned char ch)
+{
+	return isChar(ch) && !isControl(ch) && !isSpaceOrTab(ch);
+}
+
+static bool isPrintable(unsigned char ch)
+{
+	return isChar(ch) && !isControl(ch);
+}
+
+static bool isNonControl(unsigned char ch)
+{
+	return !isControl(ch);
+}
+
+// Puts every character on every position of the run and checks, that the span stops at it if rejected
+static void checkSpan(SpanFunc span, CharPredicate accepts, char filler)
+{
+	static const size_t BufLen = 40U;
+	char buf[BufLen];
+	for (int ch = 0; ch < 256; ++ch) {
+		for (size_t pos = 0U; pos < BufLen; ++pos) {
+			memset(buf, filler, BufLen);
+			buf[pos] = static_cast<char>(ch);
+			size_t expected = accepts(static_cast<unsigned char>(ch)) ? BufLen : pos;
+			EXPECT_EQ(expected, span(buf, BufLen)) << "character: " << ch << ", position: " << pos;
+		}
+	}
+}
+
+TEST(CharUtils, spanVisibleChars)
+{
+	checkSpan(spanVisibleChars, isVisible, 'a');
+	EXPECT_EQ(3U, spanVisibleChars("GET /index.html HTTP/1.1", 24U));
+	EXPECT_EQ(0U, spanVisibleChars("", 0U));
+}
+
+TEST(CharUtils, spanPrintableChars)
+{
+	checkSpan(spanPrintableChars, isPrintable, 'a');
+	EXPECT_EQ(8U, spanPrintableChars("HTTP/1.1\r\n", 10U));
+}
+
+TEST(CharUtils, spanTokenChars)
+{
+	checkSpan(spanTokenChars, isToken, 'a');
+	EXPECT_EQ(14U, spanTokenChars("Content-Length: 10", 18U));
+}
+
+TEST(CharUtils, spanNonControlChars)
+{
+	checkSpan(spanNonControlChars, isNonControl, 'a');
+	EXPECT_EQ(14U, spanNonControlChars("text/html; q=1\r\n", 16U));
+}
+
+TEST(CharUtils, parseDecimal)
+{
+	static const char * Numbers[] = {
+		"0", "7", "12345678", "123456789", "1234567890123456", "00000000000000000000000000042",
+		"4294967296", "9999999999999999999", "18446744073709551615"
+	};
+	for (size_t i = 0U; i < sizeof(Numbers) / sizeof(Numbers[0]); ++i) {
+		uint64_t result = 1U;
+		ASSERT_TRUE(parseDecimal(Numbers[i], strlen(Numbers[i]), result)) << Numbers[i];
+		EXPECT_EQ(strtoull(Numbers[i], 0, 10), result) << Numbers[i];
+	}
+	static const char * Invalid[] = {
+		"", "+1", "-1", " 1", "1234567a", "12345678a", "123456789012345/", "18446744073709551616",
+		"99999999999999999999", "1234567:"
+	};
+	for (size_t i = 0U; i < sizeof(Invalid) / sizeof(Invalid[0]); ++i) {
+		uint64_t result = 1U;
+		EXPECT_FALSE(parseDecimal(Invalid[i], strlen(Invalid[i]), result)) << Invalid[i];
+		EXPECT_EQ(1U, result) << Invalid[i];
+	}
+}
+
+TEST(CharUtils, parseHex)
+{
+	static const char * Numbers[] = {
+		"0", "f", "A", "1234abcd", "1234ABCDe", "deadBEEF01234567", "000000000000000000100000000",
+		"ffffffffffffffff"
+	};
+	for (size_t i = 0U; i < sizeof(Numbers) / sizeof(Numbers[0]); ++i) {
+		uint64_t result = 1U;
+		ASSERT_TRUE(parseHex(Numbers[i], strlen(Numbers[i]), result)) << Numbers[i];
+		EXPECT_EQ(strtoull(Numbers[i], 0, 16), result) << Numbers[i];
+	}
+	static const char * Invalid[] = {
+		"", "0x1", "g", "1234abcG", "1234abc@", "1234abc`", "1234abc:", "1234abc/", "10000000000000000"
+	};
+	for (size_t i = 0U; i < sizeof(Invalid) / sizeof(Invalid[0]); ++i) {
+		uint64_t result = 1U;
+		EXPECT_FALSE(parseHex(Invalid[i], strlen(Invalid[i]), result)) << Invalid[i];
+		EXPECT_EQ(1U, result) << Invalid[i];
+	}
+}
+
+TEST(CharUtils, formatInteger)
+{
+	uint64_t value = 0U;
+	for (int i = 0; i < 1000; ++i) {
+		char buf[MaxDecimalLength + 1];
+		char expected[MaxDecimalLength + 1];
+		size_t len = formatDecimal(value, buf);
+		snprintf(expected, sizeof(expected), "%llu", static_cast<unsigned long long>(value));
+		EXPECT_EQ(std::string(expected), std::string(buf, len));
+		EXPECT_EQ(len, decimalLength(value));
+		len = formatHex(value, buf);
+		snprintf(expected, sizeof(expected), "%llx", static_cast<unsigned long long>(value));
+		EXPECT_EQ(std::string(expected), std::string(buf, len));
+		EXPECT_EQ(len, hexLength(value));
+		// Values near the powers of 10 and 16 as well as the random ones
+		value = (i % 3 == 0) ? value * 10U + 9U : (i % 3 == 1) ? value + 1U : value * 7U + static_cast<uint64_t>(i);
+	}
+	char buf[MaxDecimalLength];
+	EXPECT_EQ("18446744073709551615", std::string(buf, formatDecimal(static_cast<uint64_t>(-1), buf)));
+	EXPECT_EQ("ffffffffffffffff", std::string(buf, formatHex(static_cast<uint64_t>(-1), buf)));
+	EXPECT_EQ("10000000000000000000", std::string(buf, formatDecimal(10000000000000000000ULL, buf)));
+}
+
+TEST(CharUtils, CharClasses)
+{
+	static const char * Separators = "()<>@,;:\\\"/[]?={} \t";
+	for (int ch = 0; ch < 256; ++ch) {
+		unsigned char c = static_cast<unsigned char>(ch);
+		bool isSeparatorChar = (c != '\0') && strchr(Separators, c) != 0;
+		EXPECT_EQ(isSeparatorChar, isSeparator(c)) << ch;
+		EXPECT_EQ(isChar(c) && !isControl(c) && !isSeparatorChar, isToken(c)) << ch;
+		EXPECT_EQ(isChar(c) && !isControl(c), isPrintableChar(c)) << ch;
+		EXPECT_EQ(c >= '0' && c <= '9', isDigit(c)) << ch;
+		EXPECT_EQ(isxdigit(ch) != 0, isHexDigit(c)) << ch;
+	}
+}
+
+TEST(CharUtils, IgnoreCase)
+{
+	static const char * Strings[] = {
+		"", "a", "A", "b", "@", "[", "`", "{", "Content-Length", "content-length", "CONTENT-LENGTH",
+		"Content-Lengti", "X-Forwarded-Proto", "x-forwarded-proto", "X-Forwarded-Proto-Too-Long-Name",
+		"x-forwarded-proto-too-long-name", "x-forwarded-proto-too-long-namE", "x-forwarded-proto-too-long-nam[",
+		"\xC1\xE1", "\xE1\xE1"
+	};
+	const size_t StringsAmount = sizeof(Strings) / sizeof(Strings[0]);
+	for (size_t i = 0U; i < StringsAmount; ++i) {
+		for (size_t j = 0U; j < StringsAmount; ++j) {
+			size_t lhsLen = strlen(Strings[i]);
+			size_t rhsLen = strlen(Strings[j]);
+			int expected = 0;
+			for (size_t k = 0U; expected == 0 && k < std::min(lhsLen, rhsLen); ++k) {
+				int l = static_cast<unsigned char>(Strings[i][k]);
+				int r = static_cast<unsigned char>(Strings[j][k]);
+				l = (l >= 'A' && l <= 'Z') ? l + 0x20 : l;
+				r = (r >= 'A' && r <= 'Z') ? r + 0x20 : r;
+				expected = l - r;
+			}
+			if (expected == 0) {
+				expected = static_cast<int>(lhsLen) - static_cast<int>(rhsLen);
+			}
+			int result = compareIgnoreCase(Strings[i], lhsLen, Strings[j], rhsLen);
+			EXPECT_EQ(expected < 0, result < 0) << Strings[i] << " vs " << Strings[j];
+			EXPECT_EQ(expected == 0, result == 0) << Strings[i] << " vs " << Strings[j];
+			if (lhsLen == rhsLen) {
+				EXPECT_EQ(expected == 0, equalsIgnoreCase(Strings[i], Strings[j], lhsLen)) <<
+					Strings[i] << " vs " << Strings[j];
+			}
+			if (expected == 0) {
+				EXPECT_EQ(hashIgnoreCase(Strings[i], lhsLen), hashIgnoreCase(Strings[j], rhsLen)) <<
+					Strings[i] << " vs " << Strings[j];
+			}
+		}
+	}
+	EXPECT_NE(hashIgnoreCase("Host", 4U), hashIgnoreCase("Date", 4U));
+	EXPECT_NE(hashIgnoreCase("", 0U), hashIgnoreCase("\0", 1U));
+	// Characters after NUL count unlike strcasecmp()
+	EXPECT_GT(0, compareIgnoreCase("a\0a", 3U, "A\0b", 3U));
+}
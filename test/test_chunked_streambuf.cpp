@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <httpxx/chunked_streambuf.h>
+#include <httpxx/message_parser.h>
+
+using namespace httpxx;
+
+namespace {
+
+// Parses chunked-encoded message and returns it's payload
+std::string parsePayload(const std::string& message, Headers& headers)
+{
+	MessageParser parser(16U, 16U, 16U);
+	std::ostringstream payload;
+	std::pair<bool, size_t> res = parser.parse(message.data(), message.size(), payload);
+	EXPECT_TRUE(res.first);
+	EXPECT_EQ(message.size(), res.second);
+	headers = parser.headers();
+	return payload.str();
+}
+
+} // anonymous namespace
+
+TEST(ChunkedStreambuf, Coalescing)
+{
+	MessageComposer composer("HTTP/1.1", "200", "OK");
+	Headers headers;
+	headers.add("Content-Type", "text/plain");
+	std::ostringstream target;
+	ChunkedOStream out(composer, headers, target, 16U);
+	std::string expected;
+	for (int i = 0; i < 10; ++i) {
+		out << "line " << i << '\n';
+		expected += "line " + std::string(1U, static_cast<char>('0' + i)) + "\n";
+	}
+	// Small writes are coalesced into full chunks
+	EXPECT_EQ(4U, out.rdbuf()->chunksAmount());
+	std::string large(100U, 'L');
+	out << large;
+	expected += large;
+	// Buffered data is completed to a full chunk, the rest is sent without copying
+	EXPECT_EQ(6U, out.rdbuf()->chunksAmount());
+	out << "tail" << std::flush;
+	expected += "tail";
+	EXPECT_EQ(7U, out.rdbuf()->chunksAmount());
+	Headers trailers;
+	trailers.add("X-Checksum", "42");
+	out.close(trailers);
+	EXPECT_TRUE(out.good());
+	EXPECT_TRUE(out.rdbuf()->isClosed());
+	out << "ignored";
+	EXPECT_FALSE(out.good());
+
+	const std::string& message = target.str();
+	EXPECT_EQ(0U, message.find("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nTransfer-Encoding: chunked\r\n\r\n10\r\n"));
+	EXPECT_NE(std::string::npos, message.find("\r\n5a\r\n" + large.substr(10U) + "\r\n4\r\ntail\r\n0\r\nX-Checksum: 42\r\n\r\n"));
+	Headers parsedHeaders;
+	EXPECT_EQ(expected, parsePayload(message, parsedHeaders));
+	EXPECT_TRUE(parsedHeaders.have("X-Checksum", "42"));
+}
+
+TEST(ChunkedStreambuf, EmptyPayload)
+{
+	MessageComposer composer("HTTP/1.1", "200", "OK");
+	Headers headers;
+	headers.add("Content-Type", "text/plain");
+	std::ostringstream target;
+	ChunkedStreambuf buf(composer, headers, target);
+	EXPECT_TRUE(buf.close());
+	EXPECT_EQ(0U, buf.chunksAmount());
+	EXPECT_EQ("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nTransfer-Encoding: chunked\r\n\r\n0\r\n\r\n",
+			target.str());
+	Headers parsedHeaders;
+	EXPECT_EQ("", parsePayload(target.str(), parsedHeaders));
+
+	// Long headers and trailers
+	std::string longValue(600U, 'v');
+	headers.add("X-Long", longValue);
+	Headers trailers;
+	trailers.add("X-Trailer", "done");
+	std::ostringstream longTarget;
+	ChunkedStreambuf longBuf(composer, headers, longTarget);
+	EXPECT_TRUE(longBuf.close(trailers));
+	const std::string& message = longTarget.str();
+	EXPECT_EQ(std::string::npos, message.find("\r\n1\r\n"));
+	EXPECT_EQ("\r\n\r\n0\r\nX-Trailer: done\r\n\r\n", message.substr(message.size() - 26U));
+	EXPECT_EQ("", parsePayload(message, parsedHeaders));
+	EXPECT_EQ(longValue, parsedHeaders.value("X-Long"));
+}
+
+TEST(ChunkedStreambuf, DiscardedUnlessClosed)
+{
+	MessageComposer composer("HTTP/1.1", "200", "OK");
+	Headers headers;
+	std::ostringstream target;
+	{
+		ChunkedOStream out(composer, headers, target);
+		out << "buffered";
+	}
+	EXPECT_EQ("", target.str());
+}
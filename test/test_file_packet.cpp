@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <httpxx/file_packet.h>
+#include <httpxx/message_composer.h>
+#include <httpxx/message_parser.h>
+
+using namespace httpxx;
+
+namespace {
+
+const char FileContent[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+class TempFile
+{
+public:
+	TempFile() :
+		_file(tmpfile())
+	{}
+	~TempFile()
+	{
+		fclose(_file);
+	}
+
+	int fd() const
+	{
+		return fileno(_file);
+	}
+	void write(const std::string& data)
+	{
+		fwrite(data.data(), 1U, data.size(), _file);
+		fflush(_file);
+	}
+	std::string read() const
+	{
+		std::string result;
+		char buf[256];
+		ssize_t len;
+		off_t offset = 0;
+		while ((len = pread(fd(), buf, sizeof(buf), offset)) > 0) {
+			result.append(buf, static_cast<size_t>(len));
+			offset += len;
+		}
+		return result;
+	}
+private:
+	FILE * _file;
+};
+
+} // anonymous namespace
+
+TEST(FilePacket, AppendAndSend)
+{
+	TempFile source;
+	source.write(FileContent);
+	FilePacket packet;
+	EXPECT_TRUE(packet.empty());
+	packet.append("<", 1U);
+	memcpy(packet.reserve(2U), "[[", 2U);
+	packet.appendFile(source.fd(), 10, 5U);
+	packet.appendFile(source.fd(), 0, 0U);
+	packet.append("]", 1U);
+	packet.appendFile(source.fd(), 0, 3U);
+	EXPECT_EQ(12U, packet.size());
+
+	TempFile target;
+	EXPECT_EQ(12, packet.send(target.fd()));
+	EXPECT_TRUE(packet.empty());
+	EXPECT_EQ("<[[abcde]012", target.read());
+
+	// Range beyond the end of the file fails after the available data is sent
+	packet.appendFile(source.fd(), 30, 10U);
+	EXPECT_EQ(6, packet.send(target.fd()));
+	EXPECT_EQ(4U, packet.size());
+	EXPECT_EQ(-1, packet.send(target.fd()));
+	packet.clear();
+	EXPECT_TRUE(packet.empty());
+}
+
+TEST(FilePacket, ComposeFileMessage)
+{
+	TempFile source;
+	source.write(FileContent);
+	MessageComposer composer("HTTP/1.1", "200", "OK");
+	Headers headers;
+	headers.add("Content-Type", "text/plain");
+
+	FilePacket packet;
+	composer.composeFileMessage(packet, headers, source.fd(), 0, 10U);
+	std::ostringstream expected;
+	composer.composeEnvelope(expected, headers, 10U);
+	expected << std::string(FileContent, 10U);
+
+	// Chunked message is sent through the socket to check MSG_MORE hinting
+	composer.composeFirstFileChunk(packet, headers, source.fd(), 10, 16U);
+	composer.composeNextFileChunk(packet, source.fd(), 26, 10U);
+	Headers trailers;
+	trailers.add("X-Trailer", "done");
+	composer.composeLastChunk(packet, trailers);
+	composer.composeFirstChunkEnvelope(expected, headers, 16U);
+	expected << std::string(FileContent + 10, 16U);
+	composer.composeNextChunkEnvelope(expected, 10U);
+	expected << std::string(FileContent + 26, 10U);
+	composer.composeLastChunk(expected, trailers);
+	EXPECT_EQ(expected.str().size(), packet.size());
+
+	int sockets[2];
+	ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+	EXPECT_EQ(static_cast<ssize_t>(expected.str().size()), packet.send(sockets[0]));
+	close(sockets[0]);
+	std::string received;
+	char buf[256];
+	ssize_t len;
+	while ((len = read(sockets[1], buf, sizeof(buf))) > 0) {
+		received.append(buf, static_cast<size_t>(len));
+	}
+	close(sockets[1]);
+	EXPECT_EQ(expected.str(), received);
+
+	MessageParser parser(16U, 16U, 16U);
+	std::ostringstream payload;
+	std::pair<bool, size_t> res = parser.parse(received.data(), received.size(), payload);
+	EXPECT_TRUE(res.first);
+	EXPECT_EQ(std::string(FileContent, 10U), payload.str());
+	payload.str(std::string());
+	res = parser.parse(received.data() + res.second, received.size() - res.second, payload);
+	EXPECT_TRUE(res.first);
+	EXPECT_EQ(std::string(FileContent + 10, 26U), payload.str());
+	EXPECT_EQ("done", parser.headers().value("X-Trailer"));
+}
+
+TEST(FilePacket, ComposeEmptyFileChunk)
+{
+	MessageComposer composer("HTTP/1.1", "200", "OK");
+	FilePacket packet;
+	EXPECT_THROW(composer.composeFirstFileChunk(packet, Headers(), 0, 0, 0U), std::runtime_error);
+	EXPECT_THROW(composer.composeNextFileChunk(packet, 0, 0, 0U), std::runtime_error);
+	EXPECT_TRUE(packet.empty());
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <cstring>
+#include <sstream>
+#include <httpxx/headers.h>
+
+using namespace httpxx;
+
+TEST(HeaderIds, Lookup)
+{
+	for (int i = UnknownHeaderId + 1; i < HeaderIdsAmount; ++i) {
+		HeaderId id = static_cast<HeaderId>(i);
+		std::string name = headerName(id);
+		ASSERT_FALSE(name.empty());
+		EXPECT_EQ(id, headerId(name)) << name;
+		std::string lowerName(name);
+		std::string upperName(name);
+		for (size_t j = 0U; j < name.size(); ++j) {
+			lowerName[j] = tolower(name[j]);
+			upperName[j] = toupper(name[j]);
+		}
+		EXPECT_EQ(id, headerId(lowerName)) << lowerName;
+		EXPECT_EQ(id, headerId(upperName)) << upperName;
+		EXPECT_EQ(UnknownHeaderId, headerId(name.data(), name.size() - 1U)) << name;
+		EXPECT_EQ(UnknownHeaderId, headerId(name + "s")) << name;
+		// Non-letters are not case-folded
+		std::string mangledName(name);
+		mangledName[name.size() / 2U] ^= 0x20;
+		if (!isalpha(name[name.size() / 2U])) {
+			EXPECT_EQ(UnknownHeaderId, headerId(mangledName)) << mangledName;
+		}
+	}
+	EXPECT_EQ(ContentLengthHeaderId, headerId("content-length"));
+	EXPECT_EQ(TransferEncodingHeaderId, headerId("Transfer-Encoding"));
+	EXPECT_EQ(UnknownHeaderId, headerId(""));
+	EXPECT_EQ(UnknownHeaderId, headerId("X-Foo"));
+	EXPECT_EQ(UnknownHeaderId, headerId("Content-Lengti"));
+	EXPECT_EQ(UnknownHeaderId, headerId("Access-Control-Allow-Origin-Too-Long"));
+	EXPECT_STREQ("", headerName(UnknownHeaderId));
+}
+
+TEST(Headers, IndexedLookup)
+{
+	Headers headers;
+	EXPECT_FALSE(headers.have(HostHeaderId));
+	EXPECT_TRUE(headers.find(HostHeaderId) == headers.end());
+	headers.add("Host", "localhost");
+	headers.add("content-length", "10");
+	headers.add("Content-Length", "20");
+	headers.add("X-Foo", "bar");
+	EXPECT_TRUE(headers.have(HostHeaderId));
+	EXPECT_TRUE(headers.have(HostHeaderId, "localhost"));
+	EXPECT_FALSE(headers.have(HostHeaderId, "Localhost"));
+	EXPECT_EQ("10", headers.value(ContentLengthHeaderId));
+	EXPECT_TRUE(headers.have(ContentLengthHeaderId, "20"));
+	EXPECT_EQ("", headers.value(ConnectionHeaderId));
+
+	// Hinted insertion could insert header before the equal ones
+	headers.insert(headers.find("Content-Length"), Headers::value_type("CONTENT-LENGTH", "5"));
+	EXPECT_EQ(headers.value("Content-Length"), headers.value(ContentLengthHeaderId));
+
+	Headers copy(headers);
+	Headers assigned;
+	assigned = headers;
+	EXPECT_EQ(3U, headers.erase(ContentLengthHeaderId));
+	EXPECT_FALSE(headers.have(ContentLengthHeaderId));
+	EXPECT_FALSE(headers.have("Content-Length"));
+	EXPECT_TRUE(copy.have(ContentLengthHeaderId));
+	EXPECT_EQ(copy.value("Content-Length"), copy.value(ContentLengthHeaderId));
+	EXPECT_TRUE(assigned.have(HostHeaderId, "localhost"));
+
+	assigned.erase(assigned.find("Host"));
+	EXPECT_FALSE(assigned.have(HostHeaderId));
+	assigned.add("HOST", "example.com");
+	assigned.erase(std::string("x-foo"));
+	EXPECT_EQ("example.com", assigned.value(HostHeaderId));
+	copy.erase(copy.find("content-length"));
+	EXPECT_TRUE(copy.have(ContentLengthHeaderId));
+	EXPECT_EQ(copy.value("Content-Length"), copy.value(ContentLengthHeaderId));
+	EXPECT_EQ(1U, copy.erase(std::string("host")));
+	EXPECT_FALSE(copy.have(HostHeaderId));
+
+	headers.swap(copy);
+	EXPECT_TRUE(headers.have(ContentLengthHeaderId));
+	EXPECT_FALSE(copy.have(ContentLengthHeaderId));
+	EXPECT_TRUE(copy.have(HostHeaderId));
+	headers.clear();
+	EXPECT_FALSE(headers.have(ContentLengthHeaderId));
+}
+
+TEST(Headers, InsertionOrder)
+{
+	Headers headers;
+	headers.add("X-B", "2");
+	headers.add("Host", "localhost");
+	headers.add("X-A", "1");
+	headers.insert(headers.find("Host"), Headers::value_type("Accept", "*/*"));
+	std::ostringstream oss;
+	headers.compose(oss);
+	EXPECT_EQ("X-B: 2\r\nAccept: */*\r\nHost: localhost\r\nX-A: 1\r\n", oss.str());
+	EXPECT_EQ(oss.str().size(), headers.composedSize());
+	EXPECT_EQ("1", headers.value("x-a"));
+	EXPECT_TRUE(headers.have("x-b", "2"));
+	EXPECT_FALSE(headers.have("x-b", "1"));
+}
+
+TEST(Headers, Growth)
+{
+	// Exceeds inline headers amount and inline arena size
+	const size_t HeadersAmount = Headers::InlineHeadersAmount * 4U;
+	const std::string value(Headers::InlineArenaSize / Headers::InlineHeadersAmount, 'v');
+	Headers headers;
+	for (size_t i = 0U; i < HeadersAmount; ++i) {
+		std::ostringstream name;
+		name << "X-Header-" << i;
+		headers.add(name.str(), value);
+		if (i == HeadersAmount / 2U) {
+			headers.add("Host", "localhost");
+		}
+	}
+	// Header, which refers to the own storage, survives it's reallocation
+	headers.insert(*headers.begin());
+	ASSERT_EQ(HeadersAmount + 2U, headers.size());
+	EXPECT_EQ("X-Header-0", (headers.end() - 1)->first.str());
+	EXPECT_EQ(value, headers.value("x-header-0"));
+	EXPECT_EQ(value, headers.value("X-Header-63"));
+	EXPECT_EQ("localhost", headers.value(HostHeaderId));
+
+	Headers copy(headers);
+	Headers other;
+	other.add("Host", "example.com");
+	other.swap(headers);
+	EXPECT_EQ(copy.size(), other.size());
+	EXPECT_EQ(1U, headers.size());
+	EXPECT_EQ("example.com", headers.value(HostHeaderId));
+	EXPECT_EQ("localhost", other.value(HostHeaderId));
+	EXPECT_EQ(2U, other.erase("X-Header-0"));
+	EXPECT_EQ(value, other.value("X-Header-1"));
+
+	copy.clear();
+	EXPECT_TRUE(copy.empty());
+	copy.add("Host", "localhost");
+	EXPECT_EQ("localhost", copy.value(HostHeaderId));
+}
+
+TEST(Headers, Take)
+{
+	// Inline storage is copied
+	Headers small;
+	small.add("Host", "localhost");
+	small.add("X-A", "1");
+	Headers target;
+	target.add("X-Old", "old");
+	target.take(small);
+	EXPECT_TRUE(small.empty());
+	ASSERT_EQ(2U, target.size());
+	EXPECT_EQ("localhost", target.value(HostHeaderId));
+	EXPECT_EQ("1", target.value("x-a"));
+	EXPECT_FALSE(target.have("x-old"));
+	small.add("X-B", "2");
+	EXPECT_EQ("1", target.value("x-a"));
+
+	// Heap storage is taken over
+	const std::string value(Headers::InlineArenaSize / Headers::InlineHeadersAmount, 'v');
+	Headers large;
+	for (size_t i = 0U; i < Headers::InlineHeadersAmount * 2U; ++i) {
+		std::ostringstream name;
+		name << "X-Header-" << i;
+		large.add(name.str(), value);
+	}
+	large.add("Host", "example.com");
+	Headers::const_iterator storage = large.begin();
+	const char * valueStorage = large.find("x-header-0")->second.data();
+	target.take(large);
+	EXPECT_TRUE(large.empty());
+	EXPECT_EQ(storage, target.begin());
+	EXPECT_EQ(valueStorage, target.find("x-header-0")->second.data());
+	EXPECT_EQ(Headers::InlineHeadersAmount * 2U + 1U, target.size());
+	EXPECT_EQ("example.com", target.value(HostHeaderId));
+
+	// Former heap storage of the target is given to the other headers
+	Headers another;
+	another.take(target);
+	target.take(another);
+	EXPECT_EQ(storage, target.begin());
+	EXPECT_EQ("example.com", target.value(HostHeaderId));
+	another.add("Host", "localhost");
+	EXPECT_EQ("localhost", another.value(HostHeaderId));
+	EXPECT_EQ(value, target.value("X-Header-31"));
+}
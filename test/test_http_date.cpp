@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <cstring>
+#include <ctime>
+#include <cstdlib>
+#include <httpxx/http_date.h>
+
+using namespace httpxx;
+
+namespace {
+
+std::string strftimeDate(time_t time, const char * format)
+{
+	struct tm tm;
+	gmtime_r(&time, &tm);
+	char buf[64];
+	return std::string(buf, strftime(buf, sizeof(buf), format, &tm));
+}
+
+} // anonymous namespace
+
+TEST(HttpDate, Format)
+{
+	char buf[HttpDateLength];
+	EXPECT_EQ("Sun, 06 Nov 1994 08:49:37 GMT", std::string(buf, formatHttpDate(784111777, buf)));
+	EXPECT_EQ("Thu, 01 Jan 1970 00:00:00 GMT", std::string(buf, formatHttpDate(0, buf)));
+	EXPECT_EQ("Wed, 31 Dec 1969 23:59:59 GMT", std::string(buf, formatHttpDate(-1, buf)));
+	// Days of the leap and non-leap years and the century boundaries
+	for (time_t t = -2208988800LL; t < 4102444800LL; t += 86400 * 7 + 3607) {
+		EXPECT_EQ(strftimeDate(t, "%a, %d %b %Y %H:%M:%S GMT"), std::string(buf, formatHttpDate(t, buf))) << t;
+	}
+}
+
+TEST(HttpDate, Parse)
+{
+	time_t result = 0;
+	static const char * Dates[] = {
+		"Sun, 06 Nov 1994 08:49:37 GMT",
+		"Sunday, 06-Nov-94 08:49:37 GMT",
+		"Sun Nov  6 08:49:37 1994"
+	};
+	for (size_t i = 0U; i < sizeof(Dates) / sizeof(Dates[0]); ++i) {
+		result = 0;
+		EXPECT_TRUE(parseHttpDate(Dates[i], strlen(Dates[i]), result)) << Dates[i];
+		EXPECT_EQ(784111777, result) << Dates[i];
+	}
+	static const char * Valid[] = {
+		"Thu, 29 Feb 2024 23:59:59 GMT",
+		"Friday, 31-Dec-27 00:00:00 GMT",
+		"Mon Jan 10 12:00:00 2000",
+		"Thu, 01 Jan 1970 00:00:00 GMT"
+	};
+	for (size_t i = 0U; i < sizeof(Valid) / sizeof(Valid[0]); ++i) {
+		EXPECT_TRUE(parseHttpDate(Valid[i], strlen(Valid[i]), result)) << Valid[i];
+	}
+	char buf[HttpDateLength];
+	for (time_t t = 0; t < 4102444800LL; t += 86400 * 13 + 7777) {
+		formatHttpDate(t, buf);
+		ASSERT_TRUE(parseHttpDate(buf, HttpDateLength, result)) << t;
+		EXPECT_EQ(t, result);
+		std::string asctimeDate = strftimeDate(t, "%a %b %e %H:%M:%S %Y");
+		ASSERT_TRUE(parseHttpDate(asctimeDate.data(), asctimeDate.size(), result)) << asctimeDate;
+		EXPECT_EQ(t, result);
+	}
+	static const char * Invalid[] = {
+		"",
+		"Sun, 06 Nov 1994 08:49:37",
+		"Sun, 06 Nov 1994 08:49:37 UTC",
+		"Sun, 06 Nov 1994 08:49:37 GMT ",
+		"sun, 06 Nov 1994 08:49:37 GMT",
+		"Sun, 6 Nov 1994 08:49:37 GMT",
+		"Sun, 06 Nov 94 08:49:37 GMT",
+		"Sun, 31 Nov 1994 08:49:37 GMT",
+		"Sun, 29 Feb 2100 08:49:37 GMT",
+		"Sun, 00 Nov 1994 08:49:37 GMT",
+		"Sun, 06 Nox 1994 08:49:37 GMT",
+		"Sun, 06 Nov 1994 24:00:00 GMT",
+		"Sun, 06 Nov 1994 08:60:00 GMT",
+		"Sun, 06 Nov 1994 08:49:3 GMT",
+		"Sunday, 06-Nov-1994 08:49:37 GMT",
+		"Sunday, 06 Nov 94 08:49:37 GMT",
+		"Sun Nov 6 08:49:37 1994",
+		"Sun Nov  6 08:49:37 94",
+		"Sunny, 06 Nov 1994 08:49:37 GMT"
+	};
+	for (size_t i = 0U; i < sizeof(Invalid) / sizeof(Invalid[0]); ++i) {
+		result = 1;
+		EXPECT_FALSE(parseHttpDate(Invalid[i], strlen(Invalid[i]), result)) << Invalid[i];
+		EXPECT_EQ(1, result) << Invalid[i];
+	}
+}
+
+TEST(HttpDate, CurrentDate)
+{
+	const char * date = currentHttpDate();
+	EXPECT_EQ(HttpDateLength, strlen(date));
+	time_t result;
+	ASSERT_TRUE(parseHttpDate(date, HttpDateLength, result));
+	EXPECT_GE(1, abs(static_cast<int>(time(0) - result)));
+	// Cached date is returned within the same second
+	EXPECT_EQ(date, currentHttpDate());
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <httpxx/memory_streambuf.h>
+#include <httpxx/message_composer.h>
+
+using namespace httpxx;
+
+TEST(MemoryStreambuf, FixedBuffer)
+{
+	MessageComposer composer("HTTP/1.1", "200", "OK");
+	Headers headers;
+	headers.add("Content-Type", "text/plain");
+	std::ostringstream expected;
+	composer.composeEnvelope(expected, headers, 123U);
+
+	char buffer[256];
+	MemoryOStream out(buffer, sizeof(buffer));
+	composer.composeEnvelope(out, headers, 123U);
+	EXPECT_TRUE(out.good());
+	EXPECT_FALSE(out.rdbuf()->isOverflowed());
+	EXPECT_EQ(expected.str().size(), out.rdbuf()->size());
+	EXPECT_EQ(static_cast<std::streamoff>(expected.str().size()), static_cast<std::streamoff>(out.tellp()));
+	EXPECT_EQ(expected.str(), std::string(out.rdbuf()->data(), out.rdbuf()->size()));
+	ScatterPacket& packet = out.rdbuf()->packet();
+	EXPECT_EQ(1U, packet.segmentsAmount());
+	EXPECT_EQ(buffer, packet.segments()[0].iov_base);
+	EXPECT_EQ(expected.str(), packet.str());
+}
+
+TEST(MemoryStreambuf, Overflow)
+{
+	char buffer[16];
+	MemoryOStream out(buffer, sizeof(buffer), 32U);
+	std::ostringstream lines;
+	for (int i = 0; i < 20; ++i) {
+		out << "line " << i << '\n';
+		lines << "line " << i << '\n';
+	}
+	std::string expected = lines.str();
+	EXPECT_TRUE(out.good());
+	EXPECT_TRUE(out.rdbuf()->isOverflowed());
+	EXPECT_EQ(expected, out.str());
+	EXPECT_EQ(expected.size(), out.rdbuf()->size());
+
+	// Large write completes the current segment and the rest goes into a single one
+	size_t segmentsAmount = out.rdbuf()->packet().segmentsAmount();
+	std::string large(100U, 'x');
+	out << large;
+	expected += large;
+	ScatterPacket& packet = out.rdbuf()->packet();
+	EXPECT_EQ(expected, packet.str());
+	EXPECT_EQ(buffer, packet.segments()[0].iov_base);
+	EXPECT_GE(segmentsAmount + 2U, packet.segmentsAmount());
+
+	// Writing continues after the packet is taken
+	out << "tail";
+	expected += "tail";
+	EXPECT_EQ(expected, out.rdbuf()->packet().str());
+	char copy[64];
+	EXPECT_EQ(sizeof(copy), out.rdbuf()->copy(copy, sizeof(copy)));
+	EXPECT_EQ(expected.substr(0U, sizeof(copy)), std::string(copy, sizeof(copy)));
+
+	out.rdbuf()->clear();
+	EXPECT_EQ(0U, out.rdbuf()->size());
+	EXPECT_FALSE(out.rdbuf()->isOverflowed());
+	out << "reused";
+	EXPECT_EQ("reused", out.str());
+	EXPECT_EQ("reused", std::string(buffer, 6U));
+}
+
+TEST(MemoryStreambuf, SegmentsOnly)
+{
+	MemoryOStream out(8U);
+	EXPECT_EQ(0U, out.rdbuf()->size());
+	EXPECT_EQ("", out.str());
+	Headers headers;
+	headers.add("Host", "example.com");
+	headers.add("Accept", "*/*");
+	headers.compose(out);
+	std::ostringstream expected;
+	headers.compose(expected);
+	EXPECT_EQ(expected.str(), out.str());
+	EXPECT_EQ(expected.str(), out.rdbuf()->packet().str());
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <httpxx/message_batch_composer.h>
+
+using namespace httpxx;
+
+TEST(MessageBatchComposer, Compose)
+{
+	MessageComposer composer("HTTP/1.1", "200", "OK");
+	Headers headers;
+	headers.add("Content-Type", "text/plain");
+	ResponseTemplate notFound(404, headers);
+	static const char Small[] = "Hello";
+	std::string large(3000U, 'x');
+
+	MessageBatchComposer batch;
+	EXPECT_TRUE(batch.empty());
+	std::string expected;
+	for (int i = 0; i < 100; ++i) {
+		char envelope[1024];
+		batch.add(composer, headers, Small, sizeof(Small) - 1U);
+		expected.append(envelope, composer.composeEnvelope(envelope, sizeof(envelope), headers, sizeof(Small) - 1U));
+		expected.append(Small);
+		batch.add(notFound);
+		expected.append(envelope, notFound.composeEnvelope(envelope, sizeof(envelope)));
+	}
+	EXPECT_EQ(200U, batch.messagesAmount());
+	EXPECT_EQ(expected.size(), batch.size());
+	ASSERT_TRUE(batch.isContiguous());
+	EXPECT_EQ(expected, std::string(batch.data(), batch.size()));
+	ScatterPacket& packet = batch.packet();
+	EXPECT_EQ(1U, packet.segmentsAmount());
+	EXPECT_EQ(expected, packet.str());
+
+	// Large payload is referenced
+	batch.add(composer, headers, large.data(), large.size());
+	batch.append("\r\n", 2U);
+	EXPECT_FALSE(batch.isContiguous());
+	char envelope[1024];
+	expected.append(envelope, composer.composeEnvelope(envelope, sizeof(envelope), headers, large.size()));
+	expected += large + "\r\n";
+	EXPECT_EQ(expected.size(), batch.size());
+	EXPECT_EQ(3U, batch.packet().segmentsAmount());
+	EXPECT_EQ(large.data(), batch.packet().segments()[1].iov_base);
+	EXPECT_EQ(expected, batch.packet().str());
+
+	batch.clear();
+	EXPECT_TRUE(batch.empty());
+	EXPECT_TRUE(batch.isContiguous());
+	EXPECT_EQ(0U, batch.messagesAmount());
+	EXPECT_EQ(0U, batch.packet().segmentsAmount());
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <cstring>
+#include <httpxx/message_batch_parser.h>
+
+using namespace httpxx;
+
+static std::string payloadStr(const MessageBatchParser& parser, const MessageBatchParser::MessageDescriptor& message)
+{
+	std::string result;
+	for (size_t i = message.payloadBegin; i < message.payloadEnd; ++i) {
+		result.append(static_cast<const char *>(parser.payload()[i].first), parser.payload()[i].second);
+	}
+	return result;
+}
+
+static const char * PipelinedMessages =
+	"GET /first HTTP/1.1\r\n"
+	"Host: localhost\r\n"
+	"\r\n"
+	"POST /second HTTP/1.1\r\n"
+	"Content-Length: 5\r\n"
+	"\r\n"
+	"hello"
+	"POST /third HTTP/1.1\r\n"
+	"Transfer-Encoding: chunked\r\n"
+	"\r\n"
+	"3\r\n"
+	"foo\r\n"
+	"3\r\n"
+	"bar\r\n"
+	"0\r\n"
+	"\r\n"
+	"GET /fourth HTTP/1.0\r\n"
+	"\r\n";
+
+TEST(MessageBatchParser, ParseComplete)
+{
+	MessageBatchParser parser(10U, 24U, 24U);
+	MessageBatchParser::BatchResult res = parser.parse(PipelinedMessages, strlen(PipelinedMessages));
+	EXPECT_EQ(strlen(PipelinedMessages), res.bytesConsumed);
+	EXPECT_EQ(MessageBatchParser::ParsingMessage, res.partialState);
+	EXPECT_EQ(0U, res.partialLength);
+	EXPECT_FALSE(res.failed);
+	ASSERT_EQ(4U, parser.messages().size());
+
+	const MessageBatchParser::MessageDescriptor& first = parser.messages()[0];
+	EXPECT_EQ(0U, first.offset);
+	EXPECT_EQ(strlen("GET /first HTTP/1.1\r\nHost: localhost\r\n\r\n"), first.length);
+	EXPECT_EQ("GET", first.firstToken.str());
+	EXPECT_EQ("/first", first.secondToken.str());
+	EXPECT_EQ("HTTP/1.1", first.thirdToken.str());
+	EXPECT_EQ("Host: localhost\r\n\r\n", first.header.str());
+	EXPECT_EQ("", payloadStr(parser, first));
+
+	const MessageBatchParser::MessageDescriptor& second = parser.messages()[1];
+	EXPECT_EQ(first.length, second.offset);
+	EXPECT_EQ("/second", second.secondToken.str());
+	EXPECT_EQ("Content-Length: 5\r\n\r\n", second.header.str());
+	EXPECT_EQ(1U, second.payloadEnd - second.payloadBegin);
+	EXPECT_EQ("hello", payloadStr(parser, second));
+
+	const MessageBatchParser::MessageDescriptor& third = parser.messages()[2];
+	EXPECT_EQ(second.offset + second.length, third.offset);
+	EXPECT_EQ("POST", third.firstToken.str());
+	EXPECT_EQ("Transfer-Encoding: chunked\r\n\r\n", third.header.str());
+	EXPECT_EQ(2U, third.payloadEnd - third.payloadBegin);
+	EXPECT_EQ("foobar", payloadStr(parser, third));
+
+	const MessageBatchParser::MessageDescriptor& fourth = parser.messages()[3];
+	EXPECT_EQ(third.offset + third.length, fourth.offset);
+	EXPECT_EQ(strlen(PipelinedMessages), fourth.offset + fourth.length);
+	EXPECT_EQ("HTTP/1.0", fourth.thirdToken.str());
+	EXPECT_EQ("\r\n", fourth.header.str());
+}
+
+TEST(MessageBatchParser, ParsePartial)
+{
+	MessageBatchParser parser(10U, 24U, 24U);
+	size_t messagesLength = strlen(PipelinedMessages);
+	// Feeding the growing buffer as the caller does, which keeps the unconsumed tail
+	std::string buf;
+	size_t messagesParsed = 0U;
+	for (size_t i = 0U; i < messagesLength; ++i) {
+		buf += PipelinedMessages[i];
+		MessageBatchParser::BatchResult res = parser.parse(buf.data(), buf.size());
+		EXPECT_FALSE(res.failed);
+		EXPECT_EQ(buf.size(), res.bytesConsumed + res.partialLength);
+		EXPECT_EQ(res.partialLength <= 0U, res.partialState == MessageBatchParser::ParsingMessage);
+		for (size_t j = 0U; j < parser.messages().size(); ++j) {
+			EXPECT_EQ(parser.messages()[j].payloadBegin, j > 0U ? parser.messages()[j - 1U].payloadEnd : 0U);
+		}
+		EXPECT_EQ(parser.payload().size(), parser.messages().empty() ? 0U : parser.messages().back().payloadEnd);
+		messagesParsed += parser.messages().size();
+		buf.erase(0U, res.bytesConsumed);
+	}
+	EXPECT_TRUE(buf.empty());
+	EXPECT_EQ(4U, messagesParsed);
+
+	static const char * PartialBody =
+		"GET /first HTTP/1.1\r\n"
+		"Host: localhost\r\n"
+		"\r\n"
+		"POST /second HTTP/1.1\r\n"
+		"Content-Length: 5\r\n"
+		"\r\n"
+		"hel";
+	MessageBatchParser::BatchResult res = parser.parse(PipelinedMessages, strlen(PartialBody));
+	EXPECT_EQ(1U, parser.messages().size());
+	EXPECT_EQ(MessageBatchParser::ParsingIdentityBody, res.partialState);
+	EXPECT_EQ(parser.messages()[0].length, res.bytesConsumed);
+	EXPECT_TRUE(parser.payload().empty());
+}
+
+TEST(MessageBatchParser, ParseMalformed)
+{
+	static const char * Messages =
+		"GET / HTTP/1.1\r\n"
+		"\r\n"
+		"GET / HTTP/1.1\r\n"
+		"Bad Header: value\r\n"
+		"\r\n";
+
+	MessageBatchParser parser(10U, 24U, 24U);
+	MessageBatchParser::BatchResult res = parser.parse(Messages, strlen(Messages));
+	EXPECT_TRUE(res.failed);
+	EXPECT_EQ(1U, parser.messages().size());
+	EXPECT_EQ(strlen("GET / HTTP/1.1\r\n\r\n"), res.bytesConsumed);
+	EXPECT_EQ(MessageBatchParser::Exception::InvalidHeaderName, res.error.code);
+	EXPECT_EQ(strlen("GET / HTTP/1.1\r\nBad"), res.error.pos);
+	EXPECT_EQ(2U, res.error.line);
+
+	// Parser is not kept failed between batches
+	res = parser.parse(Messages, strlen("GET / HTTP/1.1\r\n\r\n"));
+	EXPECT_FALSE(res.failed);
+	EXPECT_EQ(1U, parser.messages().size());
+}
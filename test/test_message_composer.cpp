@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <httpxx/message_composer.h>
+#include <httpxx/http_date.h>
+#include <httpxx/scatter_packet.h>
 
 #define BUFFER_SIZE 4096U
 #define ENVELOPE_SIZE 1024U
@@ -33,17 +35,17 @@ TEST_F(MessageComposerTest, ComposeEnvelopeToStream)
 	composer->composeEnvelope(e, *headers);
 	EXPECT_EQ(
 		"GET /index.html HTTP/1.1\r\n"
-		"Content-Type: text/plain\r\n"
 		"Host: www.example.com\r\n"
+		"Content-Type: text/plain\r\n"
 		"\r\n",
 		e.str());
 
 	e.str("");
 	std::ostringstream re;
 	re <<	"GET /index.html HTTP/1.1\r\n" <<
-		"Content-Length: " << PayloadLen << "\r\n" <<
-		"Content-Type: text/plain\r\n" <<
 		"Host: www.example.com\r\n" <<
+		"Content-Type: text/plain\r\n" <<
+		"Content-Length: " << PayloadLen << "\r\n" <<
 		"\r\n";
 	composer->composeEnvelope(e, *headers, PayloadLen);
 	EXPECT_EQ(re.str(), e.str());
@@ -60,8 +62,8 @@ TEST_F(MessageComposerTest, ComposeEnvelopeToBuffer)
 	size_t envelopeSize = composer->composeEnvelope(buffer, BUFFER_SIZE, *headers);
 	EXPECT_EQ(
 		"GET /index.html HTTP/1.1\r\n"
-		"Content-Type: text/plain\r\n"
 		"Host: www.example.com\r\n"
+		"Content-Type: text/plain\r\n"
 		"\r\n",
 		std::string(buffer, envelopeSize));
 
@@ -69,9 +71,9 @@ TEST_F(MessageComposerTest, ComposeEnvelopeToBuffer)
 
 	std::ostringstream re;
 	re <<	"GET /index.html HTTP/1.1\r\n" <<
-		"Content-Length: " << PayloadLen << "\r\n" <<
-		"Content-Type: text/plain\r\n" <<
 		"Host: www.example.com\r\n" <<
+		"Content-Type: text/plain\r\n" <<
+		"Content-Length: " << PayloadLen << "\r\n" <<
 		"\r\n";
 	envelopeSize = composer->composeEnvelope(buffer, BUFFER_SIZE, *headers, PayloadLen);
 	EXPECT_EQ(re.str(), std::string(buffer, envelopeSize));
@@ -84,16 +86,16 @@ TEST_F(MessageComposerTest, PrependEnvelope)
 	MessageComposer::Packet p = composer->prependEnvelope(buffer, ENVELOPE_SIZE, *headers);
 	EXPECT_EQ(
 		"GET /index.html HTTP/1.1\r\n"
-		"Content-Type: text/plain\r\n"
 		"Host: www.example.com\r\n"
+		"Content-Type: text/plain\r\n"
 		"\r\n",
 		std::string(static_cast<const char *>(p.first), p.second));
 
 	std::ostringstream re;
 	re <<	"GET /index.html HTTP/1.1\r\n" <<
-		"Content-Length: " << PayloadLen << "\r\n" <<
-		"Content-Type: text/plain\r\n" <<
 		"Host: www.example.com\r\n" <<
+		"Content-Type: text/plain\r\n" <<
+		"Content-Length: " << PayloadLen << "\r\n" <<
 		"\r\n" <<
 		Payload;
 	p = composer->prependEnvelope(buffer, ENVELOPE_SIZE, *headers, PayloadLen);
@@ -112,8 +114,8 @@ TEST_F(MessageComposerTest, ComposeFirstChunkEnvelopeToStream)
 {
 	std::ostringstream re;
 	re <<	"GET /index.html HTTP/1.1\r\n" <<
-		"Content-Type: text/plain\r\n" <<
 		"Host: www.example.com\r\n" <<
+		"Content-Type: text/plain\r\n" <<
 		"Transfer-Encoding: chunked\r\n" <<
 		"\r\n" <<
 		std::hex << PayloadLen << "\r\n";
@@ -126,14 +128,40 @@ TEST_F(MessageComposerTest, ComposeFirstChunkEnvelopeToStream)
 	headers->insert(Headers::value_type("transfer-encoding", "chunked"));
 	composer->composeFirstChunkEnvelope(e, *headers, PayloadLen);
 	EXPECT_EQ(re.str(), e.str());
+
+	// Chunk size formatting does not change the stream format flags
+	e.str("");
+	e << 26;
+	EXPECT_EQ("26", e.str());
+}
+
+TEST_F(MessageComposerTest, ComposeChunkedEnvelopeToStream)
+{
+	std::ostringstream first;
+	composer->composeFirstChunkEnvelope(first, *headers, PayloadLen);
+	std::ostringstream e;
+	composer->composeChunkedEnvelope(e, *headers);
+	composer->composeNextChunkEnvelope(e, PayloadLen);
+	EXPECT_EQ(first.str(), e.str());
+
+	e.str("");
+	composer->composeChunkedEnvelope(e, *headers);
+	composer->composeLastChunk(e);
+	EXPECT_EQ("GET /index.html HTTP/1.1\r\n"
+		"Host: www.example.com\r\n"
+		"Content-Type: text/plain\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"\r\n"
+		"0\r\n"
+		"\r\n", e.str());
 }
 	
 TEST_F(MessageComposerTest, ComposeFirstChunkEnvelopeToBuffer)
 {
 	std::ostringstream re;
 	re <<	"GET /index.html HTTP/1.1\r\n" <<
-		"Content-Type: text/plain\r\n" <<
 		"Host: www.example.com\r\n" <<
+		"Content-Type: text/plain\r\n" <<
 		"Transfer-Encoding: chunked\r\n" <<
 		"\r\n" <<
 		std::hex << PayloadLen << "\r\n";
@@ -153,8 +181,8 @@ TEST_F(MessageComposerTest, PrependFirstChunkEnvelope)
 {
 	std::ostringstream re;
 	re <<	"GET /index.html HTTP/1.1\r\n" <<
-		"Content-Type: text/plain\r\n" <<
 		"Host: www.example.com\r\n" <<
+		"Content-Type: text/plain\r\n" <<
 		"Transfer-Encoding: chunked\r\n" <<
 		"\r\n" <<
 		std::hex << PayloadLen << "\r\n" <<
@@ -216,8 +244,8 @@ TEST_F(MessageComposerTest, ComposeLastChunkToStream)
 	std::ostringstream re;
 	re <<	"\r\n" <<
 		"0\r\n" <<
-		"Content-Type: text/plain\r\n" <<
 		"Host: www.example.com\r\n" <<
+		"Content-Type: text/plain\r\n" <<
 		"\r\n";
 	std::ostringstream e;
 	composer->composeLastChunk(e, *headers);
@@ -229,11 +257,93 @@ TEST_F(MessageComposerTest, ComposeLastChunkToBuffer)
 	std::ostringstream re;
 	re <<	"\r\n" <<
 		"0\r\n" <<
-		"Content-Type: text/plain\r\n" <<
 		"Host: www.example.com\r\n" <<
+		"Content-Type: text/plain\r\n" <<
 		"\r\n";
 	size_t lastChunkSize = composer->composeLastChunk(buffer, BUFFER_SIZE, *headers);
 	EXPECT_EQ(re.str(), std::string(buffer, lastChunkSize));
 
 	EXPECT_THROW(composer->composeLastChunk(buffer, 1U, *headers), std::runtime_error);
 }
+
+TEST_F(MessageComposerTest, EnvelopeSizes)
+{
+	static const size_t PayloadLens[] = { 1U, 9U, 10U, 15U, 16U, 255U, 256U, 99999U, 100000U, 1U << 31 };
+	for (int pass = 0; pass < 3; ++pass) {
+		if (pass == 1) {
+			headers->insert(Headers::value_type("content-length", "256"));
+		} else if (pass == 2) {
+			headers->insert(headers->begin(), Headers::value_type("Transfer-Encoding", "gzip, chunked"));
+			headers->insert(Headers::value_type("X-Trailing", "value"));
+		}
+		EXPECT_EQ(composer->composeEnvelope(buffer, BUFFER_SIZE, *headers), composer->envelopeSize(*headers));
+		EXPECT_EQ(composer->composeLastChunk(buffer, BUFFER_SIZE, *headers), composer->lastChunkSize(*headers));
+		for (size_t i = 0U; i < sizeof(PayloadLens) / sizeof(PayloadLens[0]); ++i) {
+			EXPECT_EQ(composer->composeEnvelope(buffer, BUFFER_SIZE, *headers, PayloadLens[i]),
+					composer->envelopeSize(*headers, PayloadLens[i]));
+			EXPECT_EQ(composer->composeFirstChunkEnvelope(buffer, BUFFER_SIZE, *headers, PayloadLens[i]),
+					composer->firstChunkEnvelopeSize(*headers, PayloadLens[i]));
+			EXPECT_EQ(composer->composeNextChunkEnvelope(buffer, BUFFER_SIZE, PayloadLens[i]),
+					composer->nextChunkEnvelopeSize(PayloadLens[i]));
+			EXPECT_LE(composer->firstChunkEnvelopeSize(*headers, PayloadLens[i]),
+					composer->firstChunkEnvelopeSize(*headers));
+			EXPECT_LE(composer->nextChunkEnvelopeSize(PayloadLens[i]), composer->nextChunkEnvelopeSize(0U));
+		}
+	}
+	// Prepended envelope fits the exactly sized envelope part
+	size_t envelopeSize = composer->envelopeSize(*headers, PayloadLen);
+	memcpy(buffer + envelopeSize, Payload, PayloadLen);
+	MessageComposer::Packet p = composer->prependEnvelope(buffer, envelopeSize, *headers, PayloadLen);
+	EXPECT_EQ(static_cast<const void *>(buffer), p.first);
+	EXPECT_EQ(envelopeSize + PayloadLen, p.second);
+	EXPECT_THROW(composer->prependEnvelope(buffer, envelopeSize - 1U, *headers, PayloadLen), std::runtime_error);
+}
+
+TEST_F(MessageComposerTest, ComposeToScatterPacket)
+{
+	ScatterPacket packet;
+	composer->composeEnvelope(packet, *headers, PayloadLen);
+	packet.append(Payload, PayloadLen);
+	bool headerReferenced = false;
+	for (size_t i = 0U; i < packet.segmentsAmount(); ++i) {
+		headerReferenced = headerReferenced || packet.segments()[i].iov_base == headers->begin()->second.data();
+	}
+	EXPECT_TRUE(headerReferenced);
+	size_t envelopeSize = composer->composeEnvelope(buffer, BUFFER_SIZE, *headers, PayloadLen);
+	EXPECT_EQ(std::string(buffer, envelopeSize) + Payload, packet.str());
+
+	std::ostringstream e;
+	composer->composeFirstChunkEnvelope(e, *headers, PayloadLen);
+	composer->composeNextChunkEnvelope(e, 300U);
+	composer->composeLastChunk(e, *headers);
+	packet.clear();
+	composer->composeFirstChunkEnvelope(packet, *headers, PayloadLen);
+	composer->composeNextChunkEnvelope(packet, 300U);
+	composer->composeLastChunk(packet, *headers);
+	EXPECT_EQ(e.str(), packet.str());
+	EXPECT_THROW(composer->composeNextChunkEnvelope(packet, 0U), std::runtime_error);
+}
+
+TEST_F(MessageComposerTest, ComposeDate)
+{
+	EXPECT_FALSE(composer->isDateComposed());
+	composer->setDateComposed(true);
+	EXPECT_TRUE(composer->isDateComposed());
+	headers->insert(Headers::value_type("Date", "Thu, 01 Jan 1970 00:00:00 GMT"));
+	size_t envelopeSize = composer->composeEnvelope(buffer, BUFFER_SIZE, *headers, PayloadLen);
+	EXPECT_EQ(composer->envelopeSize(*headers, PayloadLen), envelopeSize);
+	std::string envelope(buffer, envelopeSize);
+	std::string expected("GET /index.html HTTP/1.1\r\nDate: ");
+	EXPECT_EQ(expected, envelope.substr(0U, expected.size()));
+	time_t date;
+	ASSERT_TRUE(parseHttpDate(envelope.data() + expected.size(), HttpDateLength, date));
+	EXPECT_GE(1, abs(static_cast<int>(time(0) - date)));
+	EXPECT_EQ("\r\nHost: ", envelope.substr(expected.size() + HttpDateLength, 8U));
+	EXPECT_EQ(std::string::npos, envelope.find("1970"));
+	EXPECT_EQ(composer->composeFirstChunkEnvelope(buffer, BUFFER_SIZE, *headers, PayloadLen),
+			composer->firstChunkEnvelopeSize(*headers, PayloadLen));
+
+	ScatterPacket packet;
+	composer->composeEnvelope(packet, *headers, PayloadLen);
+	EXPECT_EQ(envelope, packet.str());
+}
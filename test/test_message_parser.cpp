@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <memory>
+#include <sstream>
+#include <vector>
 #include <httpxx/message_parser.h>
 
 using namespace httpxx;
@@ -239,3 +241,455 @@ TEST_F(MessageParserTest, ParseMultipleToStream)
 	}
 	EXPECT_EQ(3U, messagesParsed);
 }
+
+static std::string payloadToString(const MessageParser::Payload& payload)
+{
+	std::string result;
+	for (MessageParser::Payload::const_iterator i = payload.begin(); i != payload.end(); ++i) {
+		result.append(static_cast<const char *>(i->first), i->second);
+	}
+	return result;
+}
+
+TEST_F(MessageParserTest, ParseMultipleToPayload)
+{
+	size_t messagesParsed = 0U;
+	size_t offset = 0U;
+	MessageParser::Payload payload;
+	while (offset < strlen(MultiMessage)) {
+		std::pair<bool, size_t> r = parser->parse(MultiMessage + offset,
+				strlen(MultiMessage) - offset, &payload);
+		for (MessageParser::Payload::const_iterator i = payload.begin(); i != payload.end(); ++i) {
+			EXPECT_GE(static_cast<const char *>(i->first), MultiMessage + offset);
+			EXPECT_LE(static_cast<const char *>(i->first) + i->second, MultiMessage + offset + r.second);
+		}
+		if (r.first) {
+			++messagesParsed;
+			if (messagesParsed == 1) {
+				EXPECT_EQ("GET", parser->firstToken());
+				EXPECT_TRUE(payload.empty());
+			} else if (messagesParsed == 2) {
+				EXPECT_EQ("200", parser->secondToken());
+				EXPECT_EQ(1U, payload.size());
+				EXPECT_EQ("1234567890", payloadToString(payload));
+			} else if (messagesParsed == 3) {
+				EXPECT_EQ("404", parser->secondToken());
+				EXPECT_EQ(2U, payload.size());
+				EXPECT_EQ("123456789012345678901", payloadToString(payload));
+				EXPECT_TRUE(parser->headers().have("x-trailer", "barfoo"));
+			}
+			payload.clear();
+		}
+		offset += r.second;
+	}
+	EXPECT_EQ(3U, messagesParsed);
+}
+
+TEST_F(MessageParserTest, TakeMessage)
+{
+	size_t offset = 0U;
+	MessageParser::Message message;
+	std::pair<bool, size_t> r = parser->parse(MultiMessage, strlen(MultiMessage));
+	EXPECT_TRUE(r.first);
+	offset += r.second;
+	parser->takeMessage(message);
+	EXPECT_EQ("GET", message.firstToken);
+	EXPECT_EQ("/index.html", message.secondToken);
+	EXPECT_EQ("HTTP/1.1", message.thirdToken);
+	EXPECT_EQ(2U, message.headers.size());
+	EXPECT_TRUE(message.headers.have("host", "localhost"));
+	EXPECT_TRUE(parser->firstToken().empty());
+	EXPECT_TRUE(parser->secondToken().empty());
+	EXPECT_TRUE(parser->thirdToken().empty());
+	EXPECT_EQ(0U, parser->headers().size());
+
+	// Target is reused, it's former contents are discarded
+	r = parser->parse(MultiMessage + offset, strlen(MultiMessage) - offset);
+	EXPECT_TRUE(r.first);
+	offset += r.second;
+	parser->takeMessage(message);
+	EXPECT_EQ("200", message.secondToken);
+	EXPECT_EQ(3U, message.headers.size());
+	EXPECT_FALSE(message.headers.have("host", "localhost"));
+	EXPECT_TRUE(message.headers.have("x-bar", "foo"));
+	EXPECT_EQ(0U, parser->headers().size());
+
+	r = parser->parse(MultiMessage + offset, strlen(MultiMessage) - offset);
+	EXPECT_TRUE(r.first);
+	Headers headers;
+	parser->takeHeaders(headers);
+	EXPECT_EQ(4U, headers.size());
+	EXPECT_TRUE(headers.have("x-trailer", "barfoo"));
+	EXPECT_EQ(0U, parser->headers().size());
+	EXPECT_EQ("404", parser->secondToken());
+
+	// Headers, which do not fit the inline storage, are taken without copying
+	std::string manyHeaders("GET / HTTP/1.1\r\n");
+	for (int i = 0; i < Headers::InlineHeadersAmount * 2; ++i) {
+		manyHeaders += "X-Header-";
+		manyHeaders += static_cast<char>('a' + i % 26);
+		manyHeaders += static_cast<char>('a' + i / 26);
+		manyHeaders += ": value\r\n";
+	}
+	manyHeaders += "\r\n";
+	for (int i = 0; i < 2; ++i) {
+		r = parser->parse(manyHeaders.data(), manyHeaders.size());
+		EXPECT_TRUE(r.first);
+		Headers::const_iterator parsedHeaders = parser->headers().begin();
+		parser->takeHeaders(headers);
+		EXPECT_EQ(parsedHeaders, headers.begin());
+		EXPECT_EQ(static_cast<size_t>(Headers::InlineHeadersAmount * 2), headers.size());
+		EXPECT_TRUE(headers.have("X-Header-ab", "value"));
+		EXPECT_EQ(0U, parser->headers().size());
+	}
+}
+
+TEST_F(MessageParserTest, ParseSplitBufferToPayload)
+{
+	static const char * ChunkedEncodedMessage =
+		"HTTP/1.1 200 OK\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"\r\n"
+		"a\r\n"
+		"12345\n7890\r\n"
+		"b\r\n"
+		"1234567\n901\r\n"
+		"0\r\n"
+		"\r\n";
+
+	size_t messageLen = strlen(ChunkedEncodedMessage);
+	MessageParser referenceParser(10U, 24U, 24U);
+	for (size_t i = 0U; i < messageLen; ++i) {
+		referenceParser.parse(ChunkedEncodedMessage[i]);
+	}
+	for (size_t splitPos = 1U; splitPos < messageLen; ++splitPos) {
+		MessageParser::Payload payload;
+		std::pair<bool, size_t> r = parser->parse(ChunkedEncodedMessage, splitPos, &payload);
+		EXPECT_FALSE(r.first);
+		EXPECT_EQ(splitPos, r.second);
+		r = parser->parse(ChunkedEncodedMessage + splitPos, messageLen - splitPos, &payload);
+		EXPECT_TRUE(r.first);
+		EXPECT_EQ(messageLen - splitPos, r.second);
+		EXPECT_EQ("12345\n7890""1234567\n901", payloadToString(payload));
+		EXPECT_EQ(referenceParser.pos(), parser->pos());
+		EXPECT_EQ(referenceParser.line(), parser->line());
+		EXPECT_EQ(referenceParser.col(), parser->col());
+	}
+}
+
+static const char * InvalidMessages[] = {
+	"GET /index.html HTTP/1.1\r\nX-Long-Value: 01234567890123456789\r\n\r\n",
+	"GET /index.html HTTP/1.1\r\nX-Invalid(Name): foo\r\n\r\n",
+	"GET /index.html HTTP/1.1\r\nX-Invalid-Value: foo\tbar\r\n\r\n",
+	"GET /index.html/is/a/way/too/long/uri HTTP/1.1\r\n\r\n",
+	"GET /index.html HTTP/1.1\x01\r\n\r\n",
+	"GET_TOO_LONG_METHOD /index.html HTTP/1.1\r\n\r\n",
+	"GET /index.html HTTP/1.1\r\nContent-Length: 1x\r\n\r\n",
+	"GET /index.html HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\nD: 4\r\n\r\n",
+	"\r\n",
+};
+
+TEST_F(MessageParserTest, ParseBufferErrors)
+{
+	for (size_t i = 0U; i < sizeof(InvalidMessages) / sizeof(InvalidMessages[0]); ++i) {
+		const char * message = InvalidMessages[i];
+		MessageParser referenceParser(10U, 24U, 24U, 16U, 16U, 3U);
+		MessageParser::Exception::Code expectedCode = MessageParser::Exception::InvalidState;
+		int expectedPos = -1;
+		try {
+			for (size_t j = 0U; j < strlen(message); ++j) {
+				referenceParser.parse(message[j]);
+			}
+		} catch (MessageParser::Exception& e) {
+			expectedCode = e.code();
+			expectedPos = e.pos();
+		}
+		ASSERT_NE(-1, expectedPos) << message;
+
+		MessageParser bufferParser(10U, 24U, 24U, 16U, 16U, 3U);
+		try {
+			bufferParser.parse(message, strlen(message));
+			ADD_FAILURE() << "Exception expected: " << message;
+		} catch (MessageParser::Exception& e) {
+			EXPECT_EQ(expectedCode, e.code()) << message;
+			EXPECT_EQ(expectedPos, e.pos()) << message;
+		}
+	}
+}
+
+TEST_F(MessageParserTest, TryParseErrors)
+{
+	for (size_t i = 0U; i < sizeof(InvalidMessages) / sizeof(InvalidMessages[0]); ++i) {
+		const char * message = InvalidMessages[i];
+		MessageParser referenceParser(10U, 24U, 24U, 16U, 16U, 3U);
+		MessageParser::Exception::Code expectedCode = MessageParser::Exception::InvalidState;
+		int expectedPos = -1;
+		int expectedLine = -1;
+		int expectedCol = -1;
+		try {
+			referenceParser.parse(message, strlen(message));
+		} catch (MessageParser::Exception& e) {
+			expectedCode = e.code();
+			expectedPos = e.pos();
+			expectedLine = e.line();
+			expectedCol = e.col();
+		}
+		ASSERT_NE(-1, expectedPos) << message;
+
+		MessageParser bufferParser(10U, 24U, 24U, 16U, 16U, 3U);
+		MessageParser::ParseResult res = bufferParser.tryParse(message, strlen(message));
+		EXPECT_FALSE(res.completed) << message;
+		EXPECT_TRUE(res.failed) << message;
+		EXPECT_EQ(static_cast<size_t>(expectedPos), res.bytesParsed) << message;
+		EXPECT_EQ(expectedCode, res.error.code) << message;
+		EXPECT_EQ(message[expectedPos], res.error.ch) << message;
+		EXPECT_EQ(static_cast<size_t>(expectedPos), res.error.pos) << message;
+		EXPECT_EQ(static_cast<size_t>(expectedLine), res.error.line) << message;
+		EXPECT_EQ(static_cast<size_t>(expectedCol), res.error.col) << message;
+		EXPECT_STREQ(MessageParser::errorMessage(expectedCode), res.error.msg());
+		EXPECT_TRUE(bufferParser.failed());
+
+		// Parser stays failed until reset
+		res = bufferParser.tryParse(message + res.bytesParsed, strlen(message) - res.bytesParsed);
+		EXPECT_TRUE(res.failed) << message;
+		EXPECT_EQ(0U, res.bytesParsed) << message;
+		EXPECT_THROW(bufferParser.parse(message, strlen(message)), MessageParser::Exception);
+
+		MessageParser charParser(10U, 24U, 24U, 16U, 16U, 3U);
+		size_t j = 0U;
+		for (; j < strlen(message); ++j) {
+			res = charParser.tryParse(message[j]);
+			if (res.failed) {
+				break;
+			}
+			EXPECT_EQ(1U, res.bytesParsed);
+		}
+		EXPECT_EQ(static_cast<size_t>(expectedPos), j) << message;
+		EXPECT_EQ(expectedCode, res.error.code) << message;
+		EXPECT_EQ(0U, res.bytesParsed) << message;
+	}
+
+	static const char * InvalidMessage = "GET / HTTP/1.1\x01\r\n\r\n";
+	static const char * ValidMessage = "GET / HTTP/1.1\r\n\r\n";
+	parser->tryParse(InvalidMessage, strlen(InvalidMessage));
+	EXPECT_TRUE(parser->failed());
+	parser->reset();
+	MessageParser::ParseResult res = parser->tryParse(ValidMessage, strlen(ValidMessage));
+	EXPECT_TRUE(res.completed);
+	EXPECT_FALSE(res.failed);
+	EXPECT_EQ(strlen(ValidMessage), res.bytesParsed);
+	EXPECT_EQ("/", parser->secondToken());
+}
+
+TEST_F(MessageParserTest, LazyPositionErrors)
+{
+	std::vector<std::string> messages(InvalidMessages,
+			InvalidMessages + sizeof(InvalidMessages) / sizeof(InvalidMessages[0]));
+	// Body data w/o line breaks does not affect the error position
+	messages.push_back("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\na;ext=1\r\n1234567890X\r\n");
+	messages.push_back("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabc\r\nx\r\n");
+	for (size_t i = 0U; i < messages.size(); ++i) {
+		const std::string& message = messages[i];
+		MessageParser referenceParser(10U, 24U, 24U, 16U, 16U, 3U);
+		MessageParser::ParseResult expected = referenceParser.tryParse(message.data(), message.size());
+		ASSERT_TRUE(expected.failed) << message;
+
+		LazyMessageParser bufferParser(10U, 24U, 24U, 16U, 16U, 3U);
+		MessageParser::ParseResult res = bufferParser.tryParse(message.data(), message.size());
+		EXPECT_TRUE(res.failed) << message;
+		EXPECT_EQ(expected.error.code, res.error.code) << message;
+		EXPECT_EQ(expected.error.pos, res.error.pos) << message;
+		EXPECT_EQ(expected.error.line, res.error.line) << message;
+		EXPECT_EQ(expected.error.col, res.error.col) << message;
+
+		LazyMessageParser charParser(10U, 24U, 24U, 16U, 16U, 3U);
+		try {
+			for (size_t j = 0U; j < message.size(); ++j) {
+				charParser.parse(message[j]);
+			}
+			ADD_FAILURE() << "Exception expected: " << message;
+		} catch (MessageParser::Exception& e) {
+			EXPECT_EQ(expected.error.pos, static_cast<size_t>(e.pos())) << message;
+			EXPECT_EQ(expected.error.line, static_cast<size_t>(e.line())) << message;
+			EXPECT_EQ(expected.error.col, static_cast<size_t>(e.col())) << message;
+		}
+	}
+}
+
+TEST_F(MessageParserTest, LazyPositionHeaderError)
+{
+	static const char * Message =
+		"GET / HTTP/1.1\r\n"
+		"Host: localhost\r\n"
+		"X-Foo: bar\r\n"
+		"Bad Header\r\n"
+		"\r\n";
+
+	MessageParser eagerParser(10U, 24U, 24U);
+	LazyMessageParser lazyParser(10U, 24U, 24U);
+	for (size_t i = 0U; i < strlen(Message); ++i) {
+		MessageParser::ParseResult eager = eagerParser.tryParse(Message[i]);
+		MessageParser::ParseResult lazy = lazyParser.tryParse(Message[i]);
+		ASSERT_EQ(eager.failed, lazy.failed) << i;
+		EXPECT_EQ(eagerParser.line(), lazyParser.line()) << i;
+		EXPECT_EQ(eagerParser.col(), lazyParser.col()) << i;
+		if (eager.failed) {
+			EXPECT_EQ(4U, lazy.error.line);
+			EXPECT_EQ(4U, lazy.error.col);
+			EXPECT_EQ(eager.error.pos, lazy.error.pos);
+			EXPECT_EQ(eager.error.col, lazy.error.col);
+			return;
+		}
+	}
+	ADD_FAILURE() << "Error expected";
+}
+
+static std::string headerViewValue(const MessageParser::HeaderViews& headerViews, const std::string& name)
+{
+	for (MessageParser::HeaderViews::const_iterator i = headerViews.begin(); i != headerViews.end(); ++i) {
+		if (strcasecmp(i->first.str().c_str(), name.c_str()) == 0) {
+			return i->second.str();
+		}
+	}
+	return "<none>";
+}
+
+static const char * FoldedMessage =
+	"HTTP/1.1 404 Not found\r\n"
+	"Connection: close\r\n"
+	"x-multiline: multiline\r\n"
+	"\tLWS value\r\n"
+	"Transfer-Encoding:\r\n"
+	" chunked\r\n"
+	"\r\n"
+	"a\r\n"
+	"1234567890\r\n"
+	"0\r\n"
+	"X-Trailer: barfoo\r\n"
+	"\r\n";
+
+static void checkFoldedMessageViews(const MessageParser& parser)
+{
+	EXPECT_EQ("HTTP/1.1", parser.firstTokenView().str());
+	EXPECT_EQ("404", parser.secondTokenView().str());
+	EXPECT_EQ("Not found", parser.thirdTokenView().str());
+	EXPECT_EQ(4U, parser.headerViews().size());
+	EXPECT_EQ("close", headerViewValue(parser.headerViews(), "connection"));
+	EXPECT_EQ("multiline LWS value", headerViewValue(parser.headerViews(), "X-Multiline"));
+	EXPECT_EQ("chunked", headerViewValue(parser.headerViews(), "Transfer-Encoding"));
+	EXPECT_EQ("barfoo", headerViewValue(parser.headerViews(), "x-trailer"));
+}
+
+TEST_F(MessageParserTest, ParseMultipleToViews)
+{
+	parser->setViewMode(true);
+	size_t messagesParsed = 0U;
+	size_t offset = 0U;
+	while (offset < strlen(MultiMessage)) {
+		std::pair<bool, size_t> r = parser->parse(MultiMessage + offset, strlen(MultiMessage) - offset);
+		if (r.first) {
+			++messagesParsed;
+			EXPECT_TRUE(parser->firstToken().empty());
+			EXPECT_TRUE(parser->headers().empty());
+			// Views should point to the parsed buffer
+			EXPECT_GE(parser->firstTokenView().data(), MultiMessage + offset);
+			EXPECT_LE(parser->thirdTokenView().data(), MultiMessage + offset + r.second);
+			if (messagesParsed == 1) {
+				EXPECT_EQ("GET", parser->firstTokenView().str());
+				EXPECT_EQ("/index.html", parser->secondTokenView().str());
+				EXPECT_EQ("HTTP/1.1", parser->thirdTokenView().str());
+				EXPECT_EQ(2U, parser->headerViews().size());
+				EXPECT_EQ("localhost", headerViewValue(parser->headerViews(), "host"));
+				EXPECT_EQ("bar", headerViewValue(parser->headerViews(), "x-foo"));
+			} else if (messagesParsed == 2) {
+				EXPECT_EQ("HTTP/1.1", parser->firstTokenView().str());
+				EXPECT_EQ("200", parser->secondTokenView().str());
+				EXPECT_EQ("OK", parser->thirdTokenView().str());
+				EXPECT_EQ(3U, parser->headerViews().size());
+				EXPECT_EQ("10", headerViewValue(parser->headerViews(), "content-length"));
+			} else if (messagesParsed == 3) {
+				EXPECT_EQ("Not found", parser->thirdTokenView().str());
+				EXPECT_EQ(4U, parser->headerViews().size());
+				EXPECT_EQ("barfoo", headerViewValue(parser->headerViews(), "x-trailer"));
+			}
+		}
+		offset += r.second;
+	}
+	EXPECT_EQ(3U, messagesParsed);
+}
+
+TEST_F(MessageParserTest, ParseSplitBufferToViews)
+{
+	parser->setViewMode(true);
+	size_t messageLen = strlen(FoldedMessage);
+	for (size_t splitPos = 1U; splitPos < messageLen; ++splitPos) {
+		// Buffers are not adjacent in memory, first one is kept intact
+		std::string firstBuffer(FoldedMessage, splitPos);
+		std::string secondBuffer(FoldedMessage + splitPos);
+		std::pair<bool, size_t> r = parser->parse(firstBuffer.data(), firstBuffer.size());
+		EXPECT_FALSE(r.first);
+		r = parser->parse(secondBuffer.data(), secondBuffer.size());
+		EXPECT_TRUE(r.first);
+		checkFoldedMessageViews(*parser);
+	}
+}
+
+TEST_F(MessageParserTest, ParseCharsToViews)
+{
+	parser->setViewMode(true);
+	for (size_t i = 0U; i < strlen(FoldedMessage); ++i) {
+		parser->parse(FoldedMessage[i]);
+	}
+	EXPECT_TRUE(parser->isCompleted());
+	checkFoldedMessageViews(*parser);
+}
+
+TEST_F(MessageParserTest, ViewsArenaGrowth)
+{
+	// Arena growth of the transient input is linear in the input size, so small
+	// fields do not take a block of the maximum field size each
+	std::string message("GET / HTTP/1.1\r\n");
+	std::string smallMessage;
+	for (int i = 0; i < 200; ++i) {
+		if (i == 50) {
+			smallMessage = message + "\r\n";
+		}
+		std::ostringstream header;
+		header << "X-" << i << ": v\r\n";
+		message += header.str();
+	}
+	message += "\r\n";
+	parser->setViewMode(true);
+	for (size_t i = 0U; i < smallMessage.size(); ++i) {
+		parser->parse(smallMessage[i]);
+	}
+	EXPECT_TRUE(parser->isCompleted());
+	size_t smallCapacity = parser->arena().capacity();
+	EXPECT_GE(2U * smallMessage.size() + Arena::DefaultBlockSize, smallCapacity);
+
+	MessageParser charParser(10U, 24U, 24U);
+	charParser.setViewMode(true);
+	for (size_t i = 0U; i < message.size(); ++i) {
+		charParser.parse(message[i]);
+	}
+	EXPECT_TRUE(charParser.isCompleted());
+	ASSERT_EQ(200U, charParser.headerViews().size());
+	EXPECT_EQ("X-199", charParser.headerViews().back().first.str());
+	EXPECT_EQ("v", charParser.headerViews().back().second.str());
+	EXPECT_GE(2U * message.size() + Arena::DefaultBlockSize, charParser.arena().capacity());
+
+	// Split buffers, which are not adjacent in memory and are kept intact
+	std::vector<std::string> buffers;
+	for (size_t i = 0U; i < message.size(); i += 7U) {
+		buffers.push_back(message.substr(i, 7U));
+	}
+	MessageParser splitParser(10U, 24U, 24U);
+	splitParser.setViewMode(true);
+	for (size_t i = 0U; i < buffers.size(); ++i) {
+		splitParser.parse(buffers[i].data(), buffers[i].size());
+	}
+	EXPECT_TRUE(splitParser.isCompleted());
+	ASSERT_EQ(200U, splitParser.headerViews().size());
+	EXPECT_EQ("X-199", splitParser.headerViews().back().first.str());
+	EXPECT_GE(2U * message.size() + Arena::DefaultBlockSize, splitParser.arena().capacity());
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <httpxx/params.h>
+#include <sstream>
 
 using namespace httpxx;
 
@@ -51,3 +52,23 @@ TEST(Params, CreateComposeAndParse)
 	EXPECT_EQ("парам", params.value("знач"));
 	EXPECT_EQ("п=а+р&ам", params.value("з=н+а&ч"));
 }
+
+TEST(Params, Arena)
+{
+	Arena arena;
+	ArenaParams params("PI=3%2E1415&come=back&foo=bar&name=value&empty&long=This+value+is+long+enough+to+be+allocated",
+			ArenaAllocator<char>(arena));
+	EXPECT_EQ(6U, params.size());
+	EXPECT_EQ(&arena, params.get_allocator().arena());
+	EXPECT_EQ(&arena, params.value("long").get_allocator().arena());
+	EXPECT_EQ("This value is long enough to be allocated", std::string(params.value("long").c_str()));
+	EXPECT_TRUE(params.have("empty", ""));
+	EXPECT_TRUE(params.have(std::string("PI"), "3.1415"));
+	EXPECT_FALSE(params.have("PI", "3.14"));
+	params.add("парам", "знач");
+	std::ostringstream oss;
+	params.compose(oss);
+	EXPECT_EQ("PI=3%2E1415&come=back&empty=&foo=bar&long=This+value+is+long+enough+to+be+allocated"
+			"&name=value&%D0%BF%D0%B0%D1%80%D0%B0%D0%BC=%D0%B7%D0%BD%D0%B0%D1%87", oss.str());
+	EXPECT_EQ(oss.str().size(), params.composedSize());
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+#include <httpxx/response_template.h>
+
+using namespace httpxx;
+
+static const char Date[] = "Sun, 06 Nov 1994 08:49:37 GMT";
+
+class ResponseTemplateTest : public ::testing::Test
+{
+protected:
+	virtual void SetUp()
+	{
+		headers.add("Server", "httpxx");
+		headers.add("Date", "Thu, 01 Jan 1970 00:00:00 GMT");
+		headers.add("Content-Length", "10");
+		headers.add("Content-Type", "text/plain");
+	}
+
+	Headers headers;
+	char buffer[1024];
+};
+
+TEST_F(ResponseTemplateTest, ComposeEnvelope)
+{
+	ResponseTemplate t(200, headers, ResponseTemplate::ContentLengthSlot | ResponseTemplate::DateSlot);
+	EXPECT_EQ(200, t.statusCode());
+	size_t len = t.composeEnvelope(buffer, sizeof(buffer), 12345U, Date);
+	EXPECT_EQ(
+		"HTTP/1.1 200 OK\r\n"
+		"Server: httpxx\r\n"
+		"Content-Type: text/plain\r\n"
+		"Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+		"Content-Length: 12345\r\n"
+		"\r\n",
+		std::string(buffer, len));
+	EXPECT_EQ(t.envelopeSize(12345U), len);
+	len = t.composeEnvelope(buffer, sizeof(buffer), 0U, Date);
+	EXPECT_EQ(t.envelopeSize(), len);
+	EXPECT_EQ("Content-Length: 0\r\n\r\n", std::string(buffer + len - 21U, 21U));
+	// Current date is composed by default
+	len = t.composeEnvelope(buffer, sizeof(buffer), 1U);
+	time_t date;
+	ASSERT_TRUE(parseHttpDate(buffer + len - 52U, ResponseTemplate::DateLength, date));
+	EXPECT_GE(1, abs(static_cast<int>(time(0) - date)));
+	EXPECT_THROW(t.composeEnvelope(buffer, t.envelopeSize(100U) - 1U, 100U, Date), std::runtime_error);
+
+	// Headers are rendered as is without slots
+	ResponseTemplate notFound("HTTP/1.0", 404, "Nothing Here", headers, 0);
+	len = notFound.composeEnvelope(buffer, sizeof(buffer), 100U);
+	EXPECT_EQ(
+		"HTTP/1.0 404 Nothing Here\r\n"
+		"Server: httpxx\r\n"
+		"Date: Thu, 01 Jan 1970 00:00:00 GMT\r\n"
+		"Content-Length: 10\r\n"
+		"Content-Type: text/plain\r\n"
+		"\r\n",
+		std::string(buffer, len));
+	EXPECT_EQ(notFound.envelopeSize(100U), len);
+
+	EXPECT_THROW(ResponseTemplate(1000, headers), std::runtime_error);
+}
+
+TEST_F(ResponseTemplateTest, PrependEnvelope)
+{
+	ResponseTemplate t(503, headers, ResponseTemplate::ContentLengthSlot, Http10ProtocolVersion);
+	static const char Payload[] = "Try later";
+	memcpy(buffer + 512U, Payload, sizeof(Payload) - 1U);
+	MessageComposer::Packet p = t.prependEnvelope(buffer, 512U, sizeof(Payload) - 1U);
+	EXPECT_EQ(
+		"HTTP/1.0 503 Service Unavailable\r\n"
+		"Server: httpxx\r\n"
+		"Date: Thu, 01 Jan 1970 00:00:00 GMT\r\n"
+		"Content-Type: text/plain\r\n"
+		"Content-Length: 9\r\n"
+		"\r\n"
+		"Try later",
+		std::string(static_cast<const char *>(p.first), p.second));
+	EXPECT_THROW(t.prependEnvelope(buffer, 10U, sizeof(Payload) - 1U), std::runtime_error);
+}
+
+TEST_F(ResponseTemplateTest, ComposeToScatterPacket)
+{
+	ResponseTemplate t(200, headers, ResponseTemplate::ContentLengthSlot | ResponseTemplate::DateSlot);
+	ScatterPacket packet;
+	t.composeEnvelope(packet, 777U, Date);
+	size_t len = t.composeEnvelope(buffer, sizeof(buffer), 777U, Date);
+	EXPECT_EQ(std::string(buffer, len), packet.str());
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <httpxx/scatter_packet.h>
+
+using namespace httpxx;
+
+TEST(ScatterPacket, AppendAndConsume)
+{
+	static const char Data[] = "0123456789";
+	ScatterPacket packet;
+	EXPECT_TRUE(packet.empty());
+	packet.append(Data, 3U);
+	// Adjacent segment is merged, empty one is skipped
+	packet.append(Data + 3U, 2U);
+	packet.append(Data, 0U);
+	EXPECT_EQ(1U, packet.segmentsAmount());
+	char * generated = packet.allocate(2U);
+	generated[0] = 'a';
+	generated[1] = 'b';
+	packet.append(generated, 2U);
+	EXPECT_EQ(2U, packet.segmentsAmount());
+	EXPECT_EQ(7U, packet.size());
+	EXPECT_EQ("01234ab", packet.str());
+	EXPECT_EQ(Data, packet.segments()[0].iov_base);
+	char copy[6];
+	EXPECT_EQ(sizeof(copy), packet.copy(copy, sizeof(copy)));
+	EXPECT_EQ("01234a", std::string(copy, sizeof(copy)));
+
+	packet.consume(4U);
+	EXPECT_EQ("4ab", packet.str());
+	packet.consume(1U);
+	EXPECT_EQ(1U, packet.segmentsAmount());
+	EXPECT_EQ("ab", packet.str());
+	packet.consume(5U);
+	EXPECT_TRUE(packet.empty());
+	EXPECT_EQ(0U, packet.segmentsAmount());
+
+	// Segments grow beyond the inline storage
+	std::string expected;
+	for (size_t i = 0U; i < ScatterPacket::InlineSegmentsAmount * 3U; ++i) {
+		packet.append(Data + i % 2U * 5U, 1U);
+		expected += Data[i % 2U * 5U];
+	}
+	EXPECT_EQ(ScatterPacket::InlineSegmentsAmount * 3U, packet.segmentsAmount());
+	EXPECT_EQ(expected, packet.str());
+	packet.consume(ScatterPacket::InlineSegmentsAmount);
+	packet.append(Data + 9U, 1U);
+	EXPECT_EQ(expected.substr(ScatterPacket::InlineSegmentsAmount) + "9", packet.str());
+
+	packet.clear();
+	EXPECT_TRUE(packet.empty());
+	EXPECT_EQ(0U, packet.segmentsAmount());
+}
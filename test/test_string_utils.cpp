@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <stdexcept>
 #include <string_utils.h>
 
 using namespace httpxx;
@@ -12,3 +13,15 @@ TEST(StringUtils, encodeDecodePercent)
 	EXPECT_EQ(EncodedString, encodePercent(SourceString));
 	EXPECT_EQ(SourceString, decodePercent(encodePercent(SourceString)));
 }
+
+TEST(StringUtils, toUnsignedInt)
+{
+	EXPECT_EQ(0U, toUnsignedInt(""));
+	EXPECT_EQ(0U, toUnsignedInt(" \t"));
+	EXPECT_EQ(10U, toUnsignedInt(" +10\r\n"));
+	EXPECT_EQ(UINT64_C(5000000000), toUnsignedInt("5000000000"));
+	EXPECT_EQ(UINT64_C(0x1FFFFFFFF), toUnsignedInt("1ffffffff", true));
+	EXPECT_THROW(toUnsignedInt("1 2"), std::runtime_error);
+	EXPECT_THROW(toUnsignedInt("18446744073709551616"), std::runtime_error);
+	EXPECT_THROW(toUnsignedInt("+a", true), std::runtime_error);
+}
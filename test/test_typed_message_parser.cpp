@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <cstring>
+#include <httpxx/request_parser.h>
+#include <httpxx/response_parser.h>
+
+using namespace httpxx;
+
+TEST(ProtocolIds, Lookup)
+{
+	for (int i = UnknownMethod + 1; i < MethodsAmount; ++i) {
+		Method method = static_cast<Method>(i);
+		std::string name = methodName(method);
+		EXPECT_EQ(method, methodId(name.data(), name.size())) << name;
+		EXPECT_EQ(UnknownMethod, methodId(name.data(), name.size() - 1U)) << name;
+		std::string lowerName(name);
+		lowerName[0] = tolower(lowerName[0]);
+		EXPECT_EQ(UnknownMethod, methodId(lowerName.data(), lowerName.size())) << name;
+	}
+	EXPECT_EQ(UnknownMethod, methodId("PROPFIND", 8U));
+	EXPECT_EQ(UnknownMethod, methodId("", 0U));
+	EXPECT_STREQ("", methodName(UnknownMethod));
+
+	EXPECT_EQ(Http11ProtocolVersion, protocolVersion("HTTP/1.1", 8U));
+	EXPECT_EQ(Http10ProtocolVersion, protocolVersion("HTTP/1.0", 8U));
+	EXPECT_EQ(UnknownProtocolVersion, protocolVersion("HTTP/2.0", 8U));
+	EXPECT_EQ(UnknownProtocolVersion, protocolVersion("HTTP/1.", 7U));
+	EXPECT_STREQ("HTTP/1.1", protocolVersionToken(Http11ProtocolVersion));
+
+	EXPECT_STREQ("Continue", reasonPhrase(100));
+	EXPECT_STREQ("OK", reasonPhrase(200));
+	EXPECT_STREQ("IM Used", reasonPhrase(226));
+	EXPECT_STREQ("Permanent Redirect", reasonPhrase(308));
+	EXPECT_STREQ("Not Found", reasonPhrase(404));
+	EXPECT_STREQ("Too Many Requests", reasonPhrase(429));
+	EXPECT_STREQ("Request Header Fields Too Large", reasonPhrase(431));
+	EXPECT_STREQ("Unavailable For Legal Reasons", reasonPhrase(451));
+	EXPECT_STREQ("Network Authentication Required", reasonPhrase(511));
+	EXPECT_STREQ("", reasonPhrase(306));
+	EXPECT_STREQ("", reasonPhrase(452));
+	EXPECT_STREQ("", reasonPhrase(99));
+	EXPECT_STREQ("", reasonPhrase(600));
+}
+
+TEST(RequestParser, Parse)
+{
+	static const char * Requests =
+		"POST /form?x=1 HTTP/1.1\r\n"
+		"Host: localhost \r\n"
+		"Content-Length: 5\r\n"
+		"\r\n"
+		"hello"
+		"PROPFIND /dav HTTP/1.0\r\n"
+		"\r\n";
+
+	RequestParser<8U, 64U> parser;
+	MessageParserBase::Payload payload;
+	std::pair<bool, size_t> res = parser.parse(Requests, strlen(Requests), &payload);
+	EXPECT_TRUE(res.first);
+	EXPECT_EQ(PostMethod, parser.method());
+	EXPECT_EQ("POST", parser.methodName().str());
+	EXPECT_EQ("/form?x=1", parser.uri().str());
+	EXPECT_EQ(Http11ProtocolVersion, parser.version());
+	EXPECT_EQ("localhost", parser.headers().value(HostHeaderId));
+	ASSERT_EQ(1U, payload.size());
+	EXPECT_EQ("hello", std::string(static_cast<const char *>(payload[0].first), payload[0].second));
+
+	// Character by character
+	size_t offset = res.second;
+	bool completed = false;
+	for (size_t i = offset; i < strlen(Requests); ++i) {
+		completed = parser.parse(Requests[i]);
+	}
+	EXPECT_TRUE(completed);
+	EXPECT_EQ(UnknownMethod, parser.method());
+	EXPECT_EQ("PROPFIND", parser.methodName().str());
+	EXPECT_EQ("/dav", parser.uri().str());
+	EXPECT_EQ(Http10ProtocolVersion, parser.version());
+	EXPECT_TRUE(parser.headers().empty());
+
+	// Limits are template parameters
+	static const char * LongUriRequest = "GET /0123456789 HTTP/1.1\r\n\r\n";
+	RequestParser<8U, 8U> shortUriParser;
+	MessageParserBase::ParseResult tryRes = shortUriParser.tryParse(LongUriRequest, strlen(LongUriRequest));
+	EXPECT_TRUE(tryRes.failed);
+	EXPECT_EQ(MessageParserBase::Exception::SecondTokenIsTooLong, tryRes.error.code);
+	static const char * LongVersionRequest = "GET / HTTP/1.1.1\r\n\r\n";
+	EXPECT_THROW(parser.parse(LongVersionRequest, strlen(LongVersionRequest)), MessageParserBase::Exception);
+}
+
+TEST(ResponseParser, Parse)
+{
+	static const char * Responses =
+		"HTTP/1.1 404 Not Found\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"\r\n"
+		"3\r\n"
+		"abc\r\n"
+		"0\r\n"
+		"\r\n"
+		"HTTP/1.0 2x0 Strange\r\n"
+		"\r\n";
+
+	ResponseParser<> parser;
+	MessageParserBase::Payload payload;
+	std::pair<bool, size_t> res = parser.parse(Responses, strlen(Responses), &payload);
+	EXPECT_TRUE(res.first);
+	EXPECT_EQ(Http11ProtocolVersion, parser.version());
+	EXPECT_EQ(404, parser.statusCode());
+	EXPECT_EQ("Not Found", parser.reasonPhrase().str());
+	EXPECT_TRUE(parser.headers().have(TransferEncodingHeaderId, "chunked"));
+	ASSERT_EQ(1U, payload.size());
+
+	MessageParserBase::ParseResult tryRes = parser.tryParse(Responses + res.second, strlen(Responses) - res.second);
+	EXPECT_TRUE(tryRes.completed);
+	EXPECT_EQ(Http10ProtocolVersion, parser.version());
+	EXPECT_EQ("HTTP/1.0", parser.versionToken().str());
+	EXPECT_EQ(0, parser.statusCode());
+	EXPECT_EQ("Strange", parser.reasonPhrase().str());
+	EXPECT_FALSE(parser.headers().have(TransferEncodingHeaderId));
+
+	static const char * LongStatusResponse = "HTTP/1.1 2000 OK\r\n\r\n";
+	EXPECT_THROW(parser.parse(LongStatusResponse, strlen(LongStatusResponse)), MessageParserBase::Exception);
+}